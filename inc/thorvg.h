@@ -2,6 +2,7 @@
 #define _THORVG_H_
 
 #include <cstdint>
+#include <cstddef>
 #include <functional>
 #include <list>
 #include <cstdarg>
@@ -135,7 +136,44 @@ enum struct EngineOption : uint8_t
     None = 0,                    /**< No engine options are enabled. This may be used to explicitly disable all optional behaviors. */
     Default = 1 << 0,            /**< Uses the default rendering mode. */
     SmartRender = 1 << 1,        /**< Enables automatic partial (smart) rendering optimizations. */
-    Aliased = 1 << 2             /**< Disables anti-aliased rendering. @note Experimental API */
+    Aliased = 1 << 2,            /**< Disables anti-aliased rendering. @note Experimental API */
+    Tiled = 1 << 3,              /**< Bins the draw commands into screen tiles and rasterizes the tiles in parallel on the worker threads. It keeps the default options enabled unless the others are given together. @note Experimental API */
+    Accumulated = 1 << 4         /**< Rasterizes the paths into the dense accumulation buffers instead of the sparse cell lists. This is faster for the dense paths such as glyph runs and hatchings. It keeps the default options enabled unless the others are given together. @note Experimental API */
+};
+
+
+/**
+ * @brief Enumeration specifying the vector instruction set used by the software raster engine.
+ *
+ * The x86 levels are ordered, each one includes the previous ones.
+ *
+ * @see Initializer::simd()
+ *
+ * @note Experimental API
+ */
+enum struct SimdLevel : uint8_t
+{
+    None = 0,   /**< Runs the portable scalar kernels only. */
+    SSE2,       /**< Uses the 128-bit x86 SSE2 kernels. */
+    AVX2,       /**< Uses the 256-bit x86 AVX2 kernels. */
+    AVX512,     /**< Uses the 512-bit x86 AVX-512 (F and BW) kernels. */
+    NEON        /**< Uses the 128-bit ARM NEON kernels. This level is fixed at build time. */
+};
+
+
+/**
+ * @brief Enumeration specifying the subsystem on whose behalf the memory is requested.
+ *
+ * @see Allocator
+ *
+ * @note Experimental API
+ */
+enum struct AllocTag : uint8_t
+{
+    Default = 0,  /**< General purpose memory such as the scene data and the internal containers. */
+    Loader,       /**< Memory for the loaded resources such as the file data and the decoded images. */
+    Renderer,     /**< Memory for the rendering working sets such as the compositing buffers and the rasterizer pools. */
+    Cache         /**< Memory for the data retained for reuse such as the precomputed tables. */
 };
 
 
@@ -1910,6 +1948,37 @@ struct TVG_API Scene : Paint
      */
     Result remove(Paint* paint = nullptr) noexcept;
 
+    /**
+     * @brief Retrieves the paints intersecting the given region.
+     *
+     * Collects the descendant paints of the scene whose filled area intersects the rectangular region
+     * defined by (`x`, `y`, `w`, `h`), in the rendering order, so the topmost paint comes last.
+     * The nested scenes are traversed instead of being collected.
+     *
+     * Large scenes maintain a bounding volume hierarchy of their children, so the query is not
+     * proportional to the number of the paints.
+     *
+     * The scene must be updated in a Canvas beforehand—typically after the Canvas has been
+     * drawn and synchronized. Paints outside of the canvas viewport are never reported.
+     *
+     * @param[in] x The x-coordinate of the top-left corner of the test region.
+     * @param[in] y The y-coordinate of the top-left corner of the test region.
+     * @param[in] w The width of the region to test. Must be greater than 0.
+     * @param[in] h The height of the region to test. Must be greater than 0.
+     * @param[out] paints The list the intersecting paints are appended to.
+     * @param[in] visibleOnly If @c true, hidden paints are excluded from the intersection test.
+     *
+     * @retval Result::InvalidArguments In case the region is empty.
+     *
+     * @note To test a single point, set the region size to w = 1, h = 1.
+     * @note This test does not take into account the results of blending or masking.
+     *
+     * @see Paint::intersects()
+     *
+     * @note Experimental API
+     */
+    Result query(int32_t x, int32_t y, int32_t w, int32_t h, std::list<Paint*>& paints, bool visibleOnly = false) noexcept;
+
     /**
      * @brief Add a post-processing effect to the scene.
      *
@@ -2410,6 +2479,23 @@ struct TVG_API GlCanvas final : Canvas
     */
     Result target(void* display, void* surface, void* context, int32_t id, uint32_t w, uint32_t h, ColorSpace cs) noexcept;
 
+    /**
+     * @brief Retrieves the reuse statistics of the path tessellations in the last synced frame.
+     *
+     * The shapes with the same path and the same transform class share their tessellation.
+     * A hit is a shape which reused a cached tessellation, a miss is a shape which tessellated its path.
+     *
+     * @param[out] hits The number of the reused tessellations. Can be @c nullptr.
+     * @param[out] misses The number of the newly generated tessellations. Can be @c nullptr.
+     *
+     * @retval Result::NonSupport In case the gl engine is not supported.
+     *
+     * @see Canvas::sync()
+     *
+     * @note Experimental API
+     */
+    Result tessellation(uint32_t* hits, uint32_t* misses) const noexcept;
+
     /**
      * @brief Creates a new OpenGL/ES Canvas object with optional rendering engine settings.
      *
@@ -2525,6 +2611,28 @@ struct TVG_API WgCanvas final : Canvas
 };
 
 
+/**
+ * @brief A set of memory callbacks replacing the system heap for the ThorVG allocations.
+ *
+ * The allocation callbacks receive the tag of the requesting subsystem, so the user can route, cap or measure
+ * the memory usage per subsystem. The requests must not fail: ThorVG does not recover from a @c nullptr, so a capping
+ * allocator has to handle the shortage itself, e.g. by reporting and aborting. A pointer is always released by
+ * the @c free callback, regardless of the tag it was allocated with, and @c realloc may receive the @c nullptr.
+ *
+ * @see Initializer::init(uint32_t threads, const Allocator& allocator)
+ *
+ * @note Experimental API
+ */
+struct Allocator
+{
+    void* (*malloc)(size_t size, AllocTag tag, void* data);                 ///< Allocates @p size bytes of uninitialized memory.
+    void* (*calloc)(size_t nmem, size_t size, AllocTag tag, void* data);    ///< Allocates @p nmem elements of @p size bytes each, initialized with zero.
+    void* (*realloc)(void* ptr, size_t size, AllocTag tag, void* data);     ///< Resizes the memory block @p ptr to @p size bytes.
+    void (*free)(void* ptr, void* data);                                    ///< Releases the memory block @p ptr.
+    void* data;                                                             ///< The user data passed to the callbacks.
+};
+
+
 /**
  * @class Initializer
  *
@@ -2552,6 +2660,25 @@ struct TVG_API Initializer final
      */
     static Result init(uint32_t threads = 0) noexcept;
 
+    /**
+     * @brief Initializes the ThorVG engine runtime with the user memory callbacks.
+     *
+     * Works as init(uint32_t threads), additionally it routes all ThorVG memory requests to the given @p allocator.
+     *
+     * @param[in] threads The number of worker threads to launch.
+     * @param[in] allocator The memory callbacks. All the callbacks must be valid.
+     *
+     * @retval Result::InvalidArguments Returned if any of the callbacks is @c nullptr.
+     * @retval Result::InsufficientCondition Returned if the engine is already initialized.
+     *
+     * @note The allocator must be installed before any ThorVG object is created, and all the ThorVG objects must be
+     *       released before the last term(), which restores the system heap.
+     * @see Initializer::term()
+     *
+     * @note Experimental API
+     */
+    static Result init(uint32_t threads, const Allocator& allocator) noexcept;
+
     /**
      * @brief Terminates the ThorVG engine.
      *
@@ -2578,6 +2705,55 @@ struct TVG_API Initializer final
      */
     static const char* version(uint32_t* major, uint32_t* minor, uint32_t* micro) noexcept;
 
+    /**
+     * @brief Overrides the vector instruction set used by the software raster engine.
+     *
+     * init() selects the best instruction set supported by both the build and the running CPU.
+     * This function lets you step down to a lower level, e.g. for benchmarking or to work around
+     * a platform issue. The rendering result is identical on all levels. The override is kept
+     * over the following term() and init() calls until the best level is set again.
+     *
+     * @param[in] level The instruction set level to use.
+     *
+     * @retval Result::InsufficientCondition Returned if the engine is not initialized.
+     * @retval Result::NonSupport Returned if the CPU or the build does not support the requested @p level.
+     *
+     * @note Call this function only while no canvas is drawing.
+     * @see Initializer::simd()
+     *
+     * @note Experimental API
+     */
+    static Result simd(SimdLevel level) noexcept;
+
+    /**
+     * @brief Retrieves the vector instruction set currently used by the software raster engine.
+     *
+     * @return The current instruction set level, or @c SimdLevel::None if the software engine is not available.
+     *
+     * @see Initializer::simd(SimdLevel level)
+     *
+     * @note Experimental API
+     */
+    static SimdLevel simd() noexcept;
+
+    /**
+     * @brief Sets the memory cap of the glyph cache used by the software raster engine.
+     *
+     * The software engine keeps the anti-aliased coverages of the recently drawn glyphs and composes the small,
+     * axis-aligned texts of them instead of rasterizing their outlines every frame. The larger, rotated, skewed
+     * or outlined texts are always drawn with their outlines. The least recently used glyphs are dropped once the cache
+     * exceeds the cap. The default cap is 1 MB.
+     *
+     * @param[in] bytes The maximum memory of the cached glyphs in bytes. @c 0 disables the cache.
+     *
+     * @retval Result::InsufficientCondition Returned if the engine is not initialized.
+     * @retval Result::NonSupport Returned if the software engine is not available.
+     *
+     * @note The glyphs are placed at the quarter pixel positions, the result may slightly differ from the outline rendering.
+     * @note Experimental API
+     */
+    static Result glyphCache(size_t bytes) noexcept;
+
     _TVG_DISABLE_CTOR(Initializer);
 };
 
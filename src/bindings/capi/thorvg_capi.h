@@ -1,6 +1,7 @@
 #ifndef __THORVG_CAPI_H__
 #define __THORVG_CAPI_H__
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -173,9 +174,64 @@ typedef enum
     TVG_ENGINE_OPTION_NONE = 0,                      /**< No engine options are enabled. This may be used to explicitly disable all optional behaviors. */
     TVG_ENGINE_OPTION_DEFAULT = 1 << 0,              /**< Uses the default rendering mode. */
     TVG_ENGINE_OPTION_SMART_RENDER = 1 << 1,         /**< Enables automatic partial (smart) rendering optimizations. */
-    TVG_ENGINE_OPTION_ALIASED = 1 << 2               /**< Disables anti-aliased rendering from the default rendering mode. @note Experimental API */
+    TVG_ENGINE_OPTION_ALIASED = 1 << 2,              /**< Disables anti-aliased rendering from the default rendering mode. @note Experimental API */
+    TVG_ENGINE_OPTION_TILED = 1 << 3,                /**< Bins the draw commands into screen tiles and rasterizes the tiles in parallel on the worker threads. It keeps the default options enabled unless the others are given together. @note Experimental API */
+    TVG_ENGINE_OPTION_ACCUMULATED = 1 << 4           /**< Rasterizes the paths into the dense accumulation buffers instead of the sparse cell lists. This is faster for the dense paths such as glyph runs and hatchings. It keeps the default options enabled unless the others are given together. @note Experimental API */
 } Tvg_Engine_Option;
 
+
+/**
+ * @brief Enumeration specifying the vector instruction set used by the software raster engine.
+ *
+ * @ingroup ThorVGCapi_Initializer
+ *
+ * @note Experimental API
+ */
+typedef enum
+{
+    TVG_SIMD_LEVEL_NONE = 0,    /**< Runs the portable scalar kernels only. */
+    TVG_SIMD_LEVEL_SSE2,        /**< Uses the 128-bit x86 SSE2 kernels. */
+    TVG_SIMD_LEVEL_AVX2,        /**< Uses the 256-bit x86 AVX2 kernels. */
+    TVG_SIMD_LEVEL_AVX512,      /**< Uses the 512-bit x86 AVX-512 (F and BW) kernels. */
+    TVG_SIMD_LEVEL_NEON         /**< Uses the 128-bit ARM NEON kernels. This level is fixed at build time. */
+} Tvg_Simd_Level;
+
+
+/**
+ * @brief Enumeration specifying the subsystem on whose behalf the memory is requested.
+ *
+ * @ingroup ThorVGCapi_Initializer
+ *
+ * @note Experimental API
+ */
+typedef enum
+{
+    TVG_ALLOC_TAG_DEFAULT = 0,  /**< General purpose memory such as the scene data and the internal containers. */
+    TVG_ALLOC_TAG_LOADER,       /**< Memory for the loaded resources such as the file data and the decoded images. */
+    TVG_ALLOC_TAG_RENDERER,     /**< Memory for the rendering working sets such as the compositing buffers and the rasterizer pools. */
+    TVG_ALLOC_TAG_CACHE         /**< Memory for the data retained for reuse such as the precomputed tables. */
+} Tvg_Alloc_Tag;
+
+
+/**
+ * @brief A set of memory callbacks replacing the system heap for the ThorVG allocations.
+ *
+ * The requests must not fail: ThorVG does not recover from a @c NULL, so a capping allocator has to handle the shortage itself,
+ * e.g. by reporting and aborting. A pointer is always released by the @c free callback, regardless of the tag it was allocated with.
+ *
+ * @ingroup ThorVGCapi_Initializer
+ *
+ * @note Experimental API
+ */
+typedef struct
+{
+    void* (*malloc)(size_t size, Tvg_Alloc_Tag tag, void* data);               /**< Allocates @p size bytes of uninitialized memory. */
+    void* (*calloc)(size_t nmem, size_t size, Tvg_Alloc_Tag tag, void* data);  /**< Allocates @p nmem elements of @p size bytes each, initialized with zero. */
+    void* (*realloc)(void* ptr, size_t size, Tvg_Alloc_Tag tag, void* data);   /**< Resizes the memory block @p ptr to @p size bytes. */
+    void (*free)(void* ptr, void* data);                                       /**< Releases the memory block @p ptr. */
+    void* data;                                                                /**< The user data passed to the callbacks. */
+} Tvg_Allocator;
+
 /**
  * @brief Enumeration indicating the method used in the masking of two objects - the target and the source.
  *
@@ -450,6 +506,26 @@ typedef bool (*Tvg_Picture_Asset_Resolver)(Tvg_Paint paint, const char* src, voi
  */
 TVG_API Tvg_Result tvg_engine_init(unsigned threads);
 
+
+/**
+ * @brief Initializes the ThorVG engine with the user memory callbacks.
+ *
+ * Works as tvg_engine_init(), additionally it routes all ThorVG memory requests to the given @p allocator.
+ *
+ * @param[in] threads The number of worker threads to create. A value of zero indicates that only the main thread will be used.
+ * @param[in] allocator The memory callbacks. All the callbacks must be valid.
+ *
+ * @retval TVG_RESULT_INVALID_ARGUMENT Returned if the @p allocator or any of its callbacks is @c NULL.
+ * @retval TVG_RESULT_INSUFFICIENT_CONDITION Returned if the engine is already initialized.
+ *
+ * @note The allocator must be installed before any ThorVG object is created, and all the ThorVG objects must be
+ *       released before the last tvg_engine_term(), which restores the system heap.
+ * @see tvg_engine_term()
+ *
+ * @note Experimental API
+ */
+TVG_API Tvg_Result tvg_engine_init_with_allocator(unsigned threads, const Tvg_Allocator* allocator);
+
 /**
  * @brief Terminates the ThorVG engine.
  *
@@ -476,6 +552,52 @@ TVG_API Tvg_Result tvg_engine_term(void);
  */
 TVG_API Tvg_Result tvg_engine_version(uint32_t* major, uint32_t* minor, uint32_t* micro, const char** version);
 
+
+/**
+ * @brief Overrides the vector instruction set used by the software raster engine.
+ *
+ * tvg_engine_init() selects the best instruction set supported by both the build and the running CPU.
+ * This function lets you step down to a lower level. The rendering result is identical on all levels.
+ *
+ * @param[in] level The instruction set level to use.
+ *
+ * @retval TVG_RESULT_INSUFFICIENT_CONDITION Returned if the engine is not initialized.
+ * @retval TVG_RESULT_NOT_SUPPORTED Returned if the CPU or the build does not support the requested @p level.
+ *
+ * @note Call this function only while no canvas is drawing.
+ * @see tvg_engine_get_simd()
+ *
+ * @note Experimental API
+ */
+TVG_API Tvg_Result tvg_engine_set_simd(Tvg_Simd_Level level);
+
+/**
+ * @brief Retrieves the vector instruction set currently used by the software raster engine.
+ *
+ * @param[out] level The current instruction set level.
+ *
+ * @retval TVG_RESULT_INVALID_ARGUMENT An invalid pointer passed as an argument.
+ *
+ * @see tvg_engine_set_simd()
+ *
+ * @note Experimental API
+ */
+TVG_API Tvg_Result tvg_engine_get_simd(Tvg_Simd_Level* level);
+
+/**
+ * @brief Sets the memory cap of the glyph cache used by the software raster engine.
+ *
+ * The small, axis-aligned texts are composed of the cached glyph coverages instead of their outlines.
+ *
+ * @param[in] bytes The maximum memory of the cached glyphs in bytes. @c 0 disables the cache.
+ *
+ * @retval TVG_RESULT_INSUFFICIENT_CONDITION Returned if the engine is not initialized.
+ * @retval TVG_RESULT_NOT_SUPPORTED Returned if the software engine is not available.
+ *
+ * @note Experimental API
+ */
+TVG_API Tvg_Result tvg_engine_set_glyph_cache(size_t bytes);
+
 /** \} */   // end defgroup ThorVGCapi_Initializer
 
 /**
@@ -600,6 +722,24 @@ TVG_API Tvg_Canvas tvg_glcanvas_create(Tvg_Engine_Option op);
  */
 TVG_API Tvg_Result tvg_glcanvas_set_target(Tvg_Canvas canvas, void* display, void* surface, void* context, int32_t id, uint32_t w, uint32_t h, Tvg_Colorspace cs);
 
+/**
+ * @brief Retrieves the reuse statistics of the path tessellations in the last synced frame.
+ *
+ * The shapes with the same path and the same transform class share their tessellation.
+ *
+ * @param[in] canvas The GlCanvas object of which the statistics are retrieved.
+ * @param[out] hits The number of the reused tessellations. Can be @c NULL.
+ * @param[out] misses The number of the newly generated tessellations. Can be @c NULL.
+ *
+ * @retval TVG_RESULT_INVALID_ARGUMENT An invalid canvas pointer passed.
+ * @retval TVG_RESULT_NOT_SUPPORTED In case the gl engine is not supported.
+ *
+ * @see tvg_canvas_sync()
+ *
+ * @note Experimental API
+ */
+TVG_API Tvg_Result tvg_glcanvas_get_tessellation(Tvg_Canvas canvas, uint32_t* hits, uint32_t* misses);
+
 /** \} */   // end defgroup ThorVGCapi_GlCanvas
 
 /**
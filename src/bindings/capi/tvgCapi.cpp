@@ -34,6 +34,37 @@
 using namespace std;
 using namespace tvg;
 
+//the user callbacks, adapted to the c++ tags
+static Tvg_Allocator _allocator;
+
+static void* _malloc(size_t size, AllocTag tag, void* data)
+{
+    auto allocator = static_cast<Tvg_Allocator*>(data);
+    return allocator->malloc(size, static_cast<Tvg_Alloc_Tag>(tag), allocator->data);
+}
+
+
+static void* _calloc(size_t nmem, size_t size, AllocTag tag, void* data)
+{
+    auto allocator = static_cast<Tvg_Allocator*>(data);
+    return allocator->calloc(nmem, size, static_cast<Tvg_Alloc_Tag>(tag), allocator->data);
+}
+
+
+static void* _realloc(void* ptr, size_t size, AllocTag tag, void* data)
+{
+    auto allocator = static_cast<Tvg_Allocator*>(data);
+    return allocator->realloc(ptr, size, static_cast<Tvg_Alloc_Tag>(tag), allocator->data);
+}
+
+
+static void _free(void* ptr, void* data)
+{
+    auto allocator = static_cast<Tvg_Allocator*>(data);
+    allocator->free(ptr, allocator->data);
+}
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -49,6 +80,19 @@ TVG_API Tvg_Result tvg_engine_init(unsigned threads)
 }
 
 
+TVG_API Tvg_Result tvg_engine_init_with_allocator(unsigned threads, const Tvg_Allocator* allocator)
+{
+    if (!allocator || !allocator->malloc || !allocator->calloc || !allocator->realloc || !allocator->free) return TVG_RESULT_INVALID_ARGUMENT;
+
+    //keep the installed callbacks if the running engine rejects the new ones
+    auto prev = _allocator;
+    _allocator = *allocator;
+    auto ret = Initializer::init(threads, {_malloc, _calloc, _realloc, _free, &_allocator});
+    if (ret == Result::InsufficientCondition) _allocator = prev;
+    return (Tvg_Result) ret;
+}
+
+
 TVG_API Tvg_Result tvg_engine_term()
 {
     return (Tvg_Result) Initializer::term();
@@ -61,6 +105,26 @@ TVG_API Tvg_Result tvg_engine_version(uint32_t* major, uint32_t* minor, uint32_t
     return TVG_RESULT_SUCCESS;
 }
 
+
+TVG_API Tvg_Result tvg_engine_set_simd(Tvg_Simd_Level level)
+{
+    return (Tvg_Result) Initializer::simd((SimdLevel) level);
+}
+
+
+TVG_API Tvg_Result tvg_engine_get_simd(Tvg_Simd_Level* level)
+{
+    if (!level) return TVG_RESULT_INVALID_ARGUMENT;
+    *level = (Tvg_Simd_Level) Initializer::simd();
+    return TVG_RESULT_SUCCESS;
+}
+
+
+TVG_API Tvg_Result tvg_engine_set_glyph_cache(size_t bytes)
+{
+    return (Tvg_Result) Initializer::glyphCache(bytes);
+}
+
 /************************************************************************/
 /* Canvas API                                                           */
 /************************************************************************/
@@ -107,6 +171,13 @@ TVG_API Tvg_Result tvg_glcanvas_set_target(Tvg_Canvas canvas, void* display, voi
 }
 
 
+TVG_API Tvg_Result tvg_glcanvas_get_tessellation(Tvg_Canvas canvas, uint32_t* hits, uint32_t* misses)
+{
+    if (canvas) return (Tvg_Result) reinterpret_cast<GlCanvas*>(canvas)->tessellation(hits, misses);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 TVG_API Tvg_Result tvg_wgcanvas_set_target(Tvg_Canvas canvas, void* device, void* instance, void* target, uint32_t w, uint32_t h, Tvg_Colorspace cs, int type)
 {
     if (canvas) return (Tvg_Result) reinterpret_cast<WgCanvas*>(canvas)->target(device, instance, target, w, h, static_cast<ColorSpace>(cs), type);
@@ -25,33 +25,51 @@
 
 #include <cstdlib>
 #include <cstddef>
+#include "thorvg.h"
 
 //separate memory alloators for clean customization
 namespace tvg
 {
+    //user memory callbacks, the system heap if not installed
+    extern Allocator allocator;
+
     template<typename T = void>
-    static inline T* malloc(size_t size)
+    static inline T* malloc(size_t size, AllocTag tag = AllocTag::Default)
     {
+        if (allocator.malloc) return static_cast<T*>(allocator.malloc(size, tag, allocator.data));
         return static_cast<T*>(std::malloc(size));
     }
 
     template<typename T = void>
-    static inline T* calloc(size_t nmem, size_t size)
+    static inline T* calloc(size_t nmem, size_t size, AllocTag tag = AllocTag::Default)
     {
+        if (allocator.calloc) return static_cast<T*>(allocator.calloc(nmem, size, tag, allocator.data));
         return static_cast<T*>(std::calloc(nmem, size));
     }
 
     template<typename T = void>
-    static inline T* realloc(T* ptr, size_t size)
+    static inline T* realloc(T* ptr, size_t size, AllocTag tag = AllocTag::Default)
     {
+        if (allocator.realloc) return static_cast<T*>(allocator.realloc((void*)ptr, size, tag, allocator.data));
         return static_cast<T*>(std::realloc(ptr, size));
     }
 
     template<typename T = void>
     static inline void free(T* ptr)
     {
-        std::free(ptr);
+        if (allocator.free) allocator.free((void*)ptr, allocator.data);
+        else std::free(ptr);
     }
+
+    //the engine types derive this, so their objects created with new go to the allocator as well
+    struct Allocated
+    {
+        static void* operator new(size_t size) { return tvg::malloc(size); }
+        static void* operator new[](size_t size) { return tvg::malloc(size); }
+        static void* operator new(TVG_UNUSED size_t size, void* ptr) { return ptr; }
+        static void operator delete(void* ptr) { tvg::free(ptr); }
+        static void operator delete[](void* ptr) { tvg::free(ptr); }
+    };
 }
 
-#endif //_TVG_ALLOCATOR_H_
\ No newline at end of file
+#endif //_TVG_ALLOCATOR_H_
@@ -95,4 +95,17 @@ unsigned long djb2Encode(const char* str)
     return hash;
 }
 
+
+unsigned long djb2Encode(const char* str, size_t len)
+{
+    if (!str) return 0;
+
+    unsigned long hash = 5381;
+
+    for (size_t i = 0; i < len; ++i) {
+        hash = ((hash << 5) + hash) + str[i]; // hash * 33 + c
+    }
+    return hash;
+}
+
 }
\ No newline at end of file
@@ -29,6 +29,7 @@ namespace tvg
 {
     size_t b64Decode(const char* encoded, const size_t len, char** decoded);
     unsigned long djb2Encode(const char* str);
+    unsigned long djb2Encode(const char* str, size_t len);
 }
 
 #endif  //_TVG_COMPRESSOR_H_
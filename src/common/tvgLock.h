@@ -57,6 +57,7 @@ namespace tvg
             if (TaskScheduler::threads() > 0) {
                 k.mtx.lock();
                 key = &k;
+                ++TaskScheduler::locks();
             }
         }
 
@@ -64,11 +65,15 @@ namespace tvg
         {
             k.mtx.lock();
             key = &k;
+            ++TaskScheduler::locks();
         }
 
         ~ScopedLock()
         {
-            if (key) key->mtx.unlock();
+            if (key) {
+                key->mtx.unlock();
+                --TaskScheduler::locks();
+            }
         }
     };
 #else //THORVG_THREAD_SUPPORT
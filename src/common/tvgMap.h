@@ -23,99 +23,213 @@
 #ifndef _TVG_MAP_H_
 #define _TVG_MAP_H_
 
+#include <new>
 #include "tvgCommon.h"
-#include "tvgInlist.h"
+#include "tvgArray.h"
 
 namespace tvg
 {
 
+//open addressing hash map with robin hood probing. The keys are stored inline in the probing table, while the values
+//live in the fixed chunks, so their addresses are stable over the rehashes. The keys must be integers or pointers.
 template<typename K, typename V>
 struct Map
 {
+    static constexpr uint32_t CHUNK_SHIFT = 5;
+    static constexpr uint32_t CHUNK_SIZE = 1 << CHUNK_SHIFT;
+
     struct Item
     {
-        INLIST_ITEM(Item);
         K key;
         V val;
 
         Item(const K& key) : key(key), val{} {}
     };
 
-    Item* find(const K& key)
+    struct Slot
+    {
+        K key;
+        uint32_t item;   //the index of the item in the chunks
+        uint32_t dist;   //the probing distance + 1, 0 if the slot is empty
+    };
+
+    Slot* slots = nullptr;
+    uint32_t capacity = 0;  //the number of slots, a power of two
+    uint32_t count = 0;
+
+    //the slots are allocated on the first insertion
+    Map(uint32_t size = 0)
+    {
+        reserve(size);
+    }
+
+    ~Map()
+    {
+        clear();
+        ARRAY_FOREACH(p, chunks) tvg::free(*p);
+        tvg::free(slots);
+    }
+
+    Map(const Map&) = delete;
+    Map& operator=(const Map&) = delete;
+
+    //Q is any key type comparable and hashed equally with K
+    template<typename Q>
+    V* find(const Q& key) const
     {
-        auto& bucket = buckets[hash(key)];
-        INLIST_FOREACH(bucket, item) {
-            if (item->key == key) return item;
+        if (count == 0) return nullptr;
+        auto mask = capacity - 1;
+        auto idx = hash(key) & mask;
+        for (uint32_t dist = 1; ; ++dist) {
+            auto& slot = slots[idx];
+            //the robin hood invariant: the key would have displaced this slot
+            if (slot.dist < dist) return nullptr;
+            if (slot.key == key) return &at(slot.item)->val;
+            idx = (idx + 1) & mask;
         }
-        return nullptr;
     }
 
-    void remove(const K& key)
+    V& operator[](const K& key)
     {
-        auto& bucket = buckets[hash(key)];
-        INLIST_FOREACH(bucket, item) {
-            if (item->key == key) {
-                bucket.remove(item);
-                delete (item);
-                return;
+        if (auto val = find(key)) return *val;
+        if ((count + 1) * 4 > capacity * 3) rehash(capacity ? capacity * 2 : 16);
+
+        auto item = alloc();
+        new (at(item)) Item(key);
+
+        Slot cur = {key, item, 1};
+        auto mask = capacity - 1;
+        auto idx = hash(key) & mask;
+        while (true) {
+            auto& slot = slots[idx];
+            if (slot.dist == 0) {
+                slot = cur;
+                break;
             }
+            //take the slot from the richer one, which is closer to its home
+            if (slot.dist < cur.dist) std::swap(slot, cur);
+            ++cur.dist;
+            idx = (idx + 1) & mask;
         }
+        ++count;
+        return at(item)->val;
     }
 
-    void clear()
+    template<typename Q>
+    bool remove(const Q& key)
     {
-        for (size_t i = 0; i < size; ++i) {
-            buckets[i].free();
+        if (count == 0) return false;
+        auto mask = capacity - 1;
+        auto idx = hash(key) & mask;
+        for (uint32_t dist = 1; ; ++dist) {
+            auto& slot = slots[idx];
+            if (slot.dist < dist) return false;
+            if (slot.key == key) break;
+            idx = (idx + 1) & mask;
         }
+
+        at(slots[idx].item)->~Item();
+        vacant.push(slots[idx].item);
+
+        //shift back the following displaced slots
+        auto next = (idx + 1) & mask;
+        while (slots[next].dist > 1) {
+            slots[idx] = slots[next];
+            --slots[idx].dist;
+            idx = next;
+            next = (next + 1) & mask;
+        }
+        slots[idx].dist = 0;
+        --count;
+        return true;
     }
 
-    V& operator[](const K& key)
+    //F: void(const K& key, V& val)
+    template<typename F>
+    void foreach(F func)
     {
-        if (auto item = find(key)) return item->val;
+        for (uint32_t i = 0; i < capacity; ++i) {
+            if (slots[i].dist > 0) func(slots[i].key, at(slots[i].item)->val);
+        }
+    }
 
-        auto& bucket = buckets[hash(key)];
-        auto item = new Item(key);
-        bucket.back(item);
-        return item->val;
+    //keeps the memory for the reuse
+    void clear()
+    {
+        for (uint32_t i = 0; i < capacity; ++i) {
+            if (slots[i].dist > 0) at(slots[i].item)->~Item();
+            slots[i].dist = 0;
+        }
+        vacant.clear();
+        used = count = 0;
     }
 
-    Map(size_t size = 32)
+    void reserve(uint32_t size)
     {
-        if (size < 1) size = 1;
-        buckets = new Inlist<Item>[size];
-        this->size = size;
+        if (size == 0) return;
+        auto cap = capacity ? capacity : 16;
+        while (size * 4 > cap * 3) cap *= 2;
+        if (cap > capacity) rehash(cap);
     }
 
-    ~Map()
+private:
+    Array<Item*> chunks;
+    Array<uint32_t> vacant;   //the released items for the reuse
+    uint32_t used = 0;        //the number of items ever allocated in the chunks
+
+    Item* at(uint32_t item) const
     {
-        delete[] buckets;
+        return chunks[item >> CHUNK_SHIFT] + (item & (CHUNK_SIZE - 1));
     }
 
-    Map(const Map&) = delete;
-    Map& operator=(const Map&) = delete;
+    uint32_t alloc()
+    {
+        if (vacant.count > 0) return vacant[--vacant.count];
+        if (used == chunks.count * CHUNK_SIZE) chunks.push(tvg::malloc<Item>(sizeof(Item) * CHUNK_SIZE));
+        return used++;
+    }
 
-    Inlist<Item>* buckets = nullptr;
-    size_t size = 0;
+    void rehash(uint32_t size)
+    {
+        auto old = slots;
+        auto oldCapacity = capacity;
+
+        slots = tvg::calloc<Slot>(size, sizeof(Slot));
+        capacity = size;
+
+        auto mask = capacity - 1;
+        for (uint32_t i = 0; i < oldCapacity; ++i) {
+            if (old[i].dist == 0) continue;
+            Slot cur = {old[i].key, old[i].item, 1};
+            auto idx = hash(cur.key) & mask;
+            while (slots[idx].dist > 0) {
+                if (slots[idx].dist < cur.dist) std::swap(slots[idx], cur);
+                ++cur.dist;
+                idx = (idx + 1) & mask;
+            }
+            slots[idx] = cur;
+        }
+        tvg::free(old);
+    }
 
-private:
-    uintptr_t shuffle(uintptr_t x) const
+    static uint32_t shuffle(uint64_t x)
     {
-        x ^= x >> (sizeof(uintptr_t) * 4);
-        x *= 0x9e3779b1u;
-        x ^= x >> (sizeof(uintptr_t) * 4);
-        return x;
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return static_cast<uint32_t>(x);
     }
 
     template<typename T>
-    uintptr_t hash(T v) const
+    static uint32_t hash(T v)
     {
-        return shuffle(static_cast<uintptr_t>(v)) % size;
+        return shuffle(static_cast<uint64_t>(v));
     }
 
     template<typename T>
-    uintptr_t hash(T* p) const
+    static uint32_t hash(T* p)
     {
-        return shuffle(reinterpret_cast<uintptr_t>(p)) % size;
+        return shuffle(reinterpret_cast<uintptr_t>(p));
     }
 };
 
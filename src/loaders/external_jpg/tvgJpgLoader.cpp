@@ -30,7 +30,7 @@
 
 void JpgLoader::clear()
 {
-    if (owner != Ownership::Borrow) tvg::free(data);
+    if (owner != Ownership::Borrow) unmap((char*)data, size);
     data = nullptr;
     size = 0;
     owner = Ownership::Borrow;
@@ -56,7 +56,7 @@ JpgLoader::~JpgLoader()
 bool JpgLoader::open(const char* path, const LoaderOps& ops)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
-    if (!(data = (unsigned char*)Loader::open(path, size))) return false;
+    if (!(data = (unsigned char*)map(path, size))) return false;
     owner = Ownership::Transfer;
 
     int width, height, subSample, colorSpace;
@@ -75,7 +75,7 @@ bool JpgLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
     if (tjDecompressHeader3(jpegDecompressor, (unsigned char *) data, size, &width, &height, &subSample, &colorSpace) < 0) return false;
 
     if (ops.owner == Ownership::Copy) {
-        this->data = tvg::malloc<unsigned char>(size);
+        this->data = tvg::malloc<unsigned char>(size, AllocTag::Loader);
         if (!this->data) return false;
         memcpy((unsigned char *)this->data, data, size);
     } else {
@@ -96,7 +96,7 @@ bool PngLoader::read()
         cs = ColorSpace::ABGR8888S;
     }
 
-    auto buffer = tvg::malloc<png_byte>(PNG_IMAGE_SIZE((*image)));
+    auto buffer = tvg::malloc<png_byte>(PNG_IMAGE_SIZE((*image)), AllocTag::Loader);
     if (!png_image_finish_read(image, NULL, buffer, 0, NULL)) {
         tvg::free(buffer);
         return false;
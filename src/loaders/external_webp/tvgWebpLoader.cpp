@@ -59,7 +59,7 @@ WebpLoader::~WebpLoader()
 {
     done();
 
-    if (owner != Ownership::Borrow) tvg::free(data);
+    if (owner != Ownership::Borrow) unmap((char*)data, size);
     data = nullptr;
     size = 0;
     owner = Ownership::Borrow;
@@ -69,7 +69,7 @@ WebpLoader::~WebpLoader()
 bool WebpLoader::open(const char* path, const LoaderOps& ops)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
-    if (!(data = (unsigned char*)Loader::open(path, size))) return false;
+    if (!(data = (unsigned char*)map(path, size))) return false;
     owner = Ownership::Transfer;
 
     WebPBitstreamFeatures features;
@@ -86,7 +86,7 @@ bool WebpLoader::open(const char* path, const LoaderOps& ops)
 bool WebpLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
 {
     if (ops.owner == Ownership::Copy) {
-        this->data = tvg::malloc<unsigned char>(size);
+        this->data = tvg::malloc<unsigned char>(size, AllocTag::Loader);
         memcpy((unsigned char *)this->data, data, size);
     } else {
         this->data = (unsigned char *) data;
@@ -29,9 +29,10 @@
 void JpgLoader::clear()
 {
     jpgdDelete(decoder);
-    if (owner != Ownership::Borrow) tvg::free(data);
+    if (owner != Ownership::Borrow) unmap(data, size);
     decoder = nullptr;
     data = nullptr;
+    size = 0;
     owner = Ownership::Borrow;
 }
 
@@ -57,12 +58,14 @@ JpgLoader::~JpgLoader()
 bool JpgLoader::open(const char* path, const LoaderOps& ops)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
+    if (!(data = map(path, size))) return false;
+    owner = Ownership::Transfer;
+
     int width, height;
-    if (!(decoder = jpgdHeader(path, &width, &height))) return false;
+    if (!(decoder = jpgdHeader(data, size, &width, &height))) return false;
 
     w = static_cast<float>(width);
     h = static_cast<float>(height);
-    owner = Ownership::Transfer;
 
     return true;
 #else
@@ -73,13 +76,14 @@ bool JpgLoader::open(const char* path, const LoaderOps& ops)
 bool JpgLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
 {
     if (ops.owner == Ownership::Copy) {
-        this->data = tvg::malloc<char>(size);
+        this->data = tvg::malloc<char>(size, AllocTag::Loader);
         if (!this->data) return false;
         memcpy((char *)this->data, data, size);
     } else {
         this->data = (char *) data;
     }
     owner = ops.owner;
+    this->size = size;
 
     int width, height;
     decoder = jpgdHeader(this->data, size, &width, &height);
@@ -42,6 +42,7 @@ struct JpgLoader : BitmapLoader, Task
 private:
     jpeg_decoder* decoder = nullptr;
     char* data = nullptr;
+    uint32_t size = 0;
 
     void clear();
     void run(unsigned tid) override;
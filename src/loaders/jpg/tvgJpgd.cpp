@@ -84,25 +84,6 @@ struct jpeg_decoder_stream
 };
 
 
-// stdio FILE stream class.
-class jpeg_decoder_file_stream : public jpeg_decoder_stream
-{
-    jpeg_decoder_file_stream(const jpeg_decoder_file_stream &);
-    jpeg_decoder_file_stream &operator =(const jpeg_decoder_file_stream &);
-
-    FILE *m_pFile = nullptr;
-    bool m_eof_flag = false;
-    bool m_error_flag = false;
-
-public:
-    jpeg_decoder_file_stream() {}
-    virtual ~jpeg_decoder_file_stream();
-    bool open(const char *Pfilename);
-    void close();
-    virtual int read(uint8_t *pBuf, int max_bytes_to_read, bool *pEOF_flag);
-  };
-
-
 // Memory stream class.
 class jpeg_decoder_mem_stream : public jpeg_decoder_stream
 {
@@ -2351,64 +2332,6 @@ jpeg_decoder::~jpeg_decoder()
 }
 
 
-void jpeg_decoder_file_stream::close()
-{
-    if (m_pFile) {
-        fclose(m_pFile);
-        m_pFile = nullptr;
-    }
-    m_eof_flag = false;
-    m_error_flag = false;
-}
-
-
-jpeg_decoder_file_stream::~jpeg_decoder_file_stream()
-{
-    close();
-}
-
-
-bool jpeg_decoder_file_stream::open(const char *Pfilename)
-{
-    close();
-
-    m_eof_flag = false;
-    m_error_flag = false;
-
-#if defined(_MSC_VER)
-    m_pFile = nullptr;
-    fopen_s(&m_pFile, Pfilename, "rb");
-#else
-    m_pFile = fopen(Pfilename, "rb");
-#endif
-    return m_pFile != nullptr;
-}
-
-
-int jpeg_decoder_file_stream::read(uint8_t *pBuf, int max_bytes_to_read, bool *pEOF_flag)
-{
-    if (!m_pFile) return -1;
-
-    if (m_eof_flag) {
-        *pEOF_flag = true;
-        return 0;
-    }
-
-    if (m_error_flag) return -1;
-
-    int bytes_read = static_cast<int>(fread(pBuf, 1, max_bytes_to_read, m_pFile));
-    if (bytes_read < max_bytes_to_read) {
-        if (ferror(m_pFile)) {
-            m_error_flag = true;
-            return -1;
-        }
-        m_eof_flag = true;
-        *pEOF_flag = true;
-    }
-    return bytes_read;
-}
-
-
 bool jpeg_decoder_mem_stream::open(const uint8_t *pSrc_data, uint32_t size)
 {
     close();
@@ -2456,27 +2379,6 @@ jpeg_decoder* jpgdHeader(const char* data, int size, int* width, int* height)
 }
 
 
-jpeg_decoder* jpgdHeader(const char* filename, int* width, int* height)
-{
-    auto fileStream = new jpeg_decoder_file_stream();
-    if (!fileStream->open(filename)) {
-        delete(fileStream);
-        return nullptr;
-    }
-
-    auto decoder = new jpeg_decoder(fileStream);
-    if (decoder->get_error_code() != JPGD_SUCCESS) {
-        delete(decoder);
-        return nullptr;
-    }
-
-    if (width) *width = decoder->get_width();
-    if (height) *height = decoder->get_height();
-
-    return decoder;
-}
-
-
 void jpgdDelete(jpeg_decoder* decoder)
 {
     delete(decoder);
@@ -2491,7 +2393,7 @@ unsigned char* jpgdDecompress(jpeg_decoder* decoder)
     auto height = decoder->get_height();
     //auto actual_comps = decoder->get_num_components();
     const auto stride = width * channel;
-    auto ret = tvg::malloc<uint8_t>(stride * height);
+    auto ret = tvg::malloc<uint8_t>(stride * height, AllocTag::Loader);
     auto dst = ret;
 
     for (int y = 0; y < height; y++) {
@@ -26,7 +26,6 @@
 class jpeg_decoder;
 
 jpeg_decoder* jpgdHeader(const char* data, int size, int* width, int* height);
-jpeg_decoder* jpgdHeader(const char* filename, int* width, int* height);
 unsigned char* jpgdDecompress(jpeg_decoder* decoder);
 void jpgdDelete(jpeg_decoder* decoder);
 
@@ -24,6 +24,8 @@
 #include "ecma-objects-general.h"
 #include "ecma-objects.h"
 #include "jcontext.h"
+#include "js-parser.h"
+#include "vm.h"
 
 /** \addtogroup jerry Jerry engine interface
  * @{
@@ -168,6 +170,73 @@ jerry_eval (const jerry_char_t *source_p, /**< source code */
   return jerry_return (ecma_op_eval_chars_buffer ((void *) &source_char, flags));
 } /* jerry_eval */
 
+/**
+ * Parse the source code once for the repeated evaluations by jerry_run
+ *
+ * Note:
+ *      returned value must be freed with jerry_value_free, when it is no longer needed.
+ *
+ * @return script object, which holds the byte code, or an error value
+ */
+jerry_value_t
+jerry_parse (const jerry_char_t *source_p, /**< source code */
+             size_t source_size, /**< length of source code */
+             uint32_t flags) /**< jerry_parse_opts_t flags */
+{
+#if JERRY_PARSER
+  JERRY_DEFINE_CURRENT_CONTEXT ();
+  parser_source_char_t source_char;
+  source_char.source_p = source_p;
+  source_char.source_size = source_size;
+
+  ECMA_CLEAR_LOCAL_PARSE_OPTS ();
+
+  ecma_compiled_code_t *bytecode_p;
+  bytecode_p = parser_parse_script ((void *) &source_char, (flags & (uint32_t) ~ECMA_PARSE_STRICT_MODE) | ECMA_PARSE_EVAL, NULL);
+
+  if (JERRY_UNLIKELY (bytecode_p == NULL))
+  {
+    return ecma_create_exception_from_context ();
+  }
+
+  ecma_object_t *object_p = ecma_create_object (NULL, sizeof (ecma_extended_object_t), ECMA_OBJECT_TYPE_CLASS);
+  ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) object_p;
+  ext_object_p->u.cls.type = ECMA_OBJECT_CLASS_SCRIPT;
+  ECMA_SET_INTERNAL_VALUE_POINTER (ext_object_p->u.cls.u3.value, bytecode_p);
+
+  return ecma_make_object_value (object_p);
+#else /* !JERRY_PARSER */
+  JERRY_UNUSED (source_p);
+  JERRY_UNUSED (source_size);
+  JERRY_UNUSED (flags);
+  return jerry_undefined ();
+#endif /* JERRY_PARSER */
+} /* jerry_parse */
+
+/**
+ * Run the script parsed by jerry_parse with the same semantics as jerry_eval
+ *
+ * Note:
+ *      returned value must be freed with jerry_value_free, when it is no longer needed.
+ *
+ * @return result of the script, may be error value.
+ */
+jerry_value_t
+jerry_run (const jerry_value_t script) /**< script object */
+{
+  JERRY_DEFINE_CURRENT_CONTEXT ();
+  ecma_extended_object_t *ext_object_p = (ecma_extended_object_t *) ecma_get_object_from_value (script);
+  JERRY_ASSERT (ext_object_p->u.cls.type == ECMA_OBJECT_CLASS_SCRIPT);
+
+  ecma_compiled_code_t *bytecode_p;
+  bytecode_p = ECMA_GET_INTERNAL_VALUE_POINTER (ecma_compiled_code_t, ext_object_p->u.cls.u3.value);
+
+  /* the eval run releases the byte code at the end */
+  ecma_bytecode_ref (bytecode_p);
+
+  return jerry_return (vm_run_eval (bytecode_p, 0));
+} /* jerry_run */
+
 /**
  * Get global object
  *
@@ -323,6 +392,20 @@ jerry_value_free (jerry_value_t value) /**< value */
   ecma_free_value (value);
 } /* jerry_value_free */
 
+/**
+ * Copy the value, the copy shares the referenced object
+ *
+ * Note:
+ *      returned value must be freed with jerry_value_free, when it is no longer needed.
+ *
+ * @return copied value
+ */
+jerry_value_t
+jerry_value_copy (const jerry_value_t value) /**< value */
+{
+  return ecma_copy_value (value);
+} /* jerry_value_copy */
+
 /**
  * Create a jerry_value_t representing a boolean value from the given boolean parameter.
  *
@@ -213,6 +213,8 @@ struct TVG_API LottieAnimation final : Animation
      *
      * This function controls the rendering quality of effects like blur, shadows, etc.
      * Lower values prioritize performance while higher values prioritize quality.
+     * Below the initial value, keyframe easings are also approximated with precomputed tables
+     * instead of solving the bezier curves on every frame.
      *
      * @param[in] value The quality level (0-100). 0 represents lowest quality/best performance,
      *                  100 represents highest quality/lowest performance, the initial value is 50.
@@ -36,7 +36,24 @@
 /************************************************************************/
 
 static bool _buildComposition(LottieComposition* comp, LottieRootLayer* parent);
-static bool _draw(LottieGroup* parent, LottieShape* shape, RenderContext* ctx);
+static bool _draw(Scene* scene, LottieRenderPooler<Shape>* pooler, RenderContext* ctx);
+
+//bind the keyframe states of the instance to the current thread, the tasks could run nested on the caller
+struct ScopedFrameState
+{
+    LottieFrameState* prev;
+
+    ScopedFrameState(LottieFrameState* state) : prev(LottieFrameState::current())
+    {
+        LottieFrameState::current() = state;
+    }
+
+    ~ScopedFrameState()
+    {
+        LottieFrameState::current() = prev;
+    }
+};
+
 
 static void _dimension3d(LottieTransform* transform, float frameNo, Matrix& m, float angle, LottieTween& tween, LottieExpressions* exps)
 {
@@ -180,11 +197,13 @@ void LottieBuilder::updateTransform(LottieLayer* layer, float frameNo)
 {
     if (!layer) return;
 
+    auto& cached = cache(layer);
+
     if (tween.active) {
-        layer->cache.frameNo = -1.0f;  // tweening doesn't cache the result; invalidate it
+        cached.frameNo = -1.0f;  // tweening doesn't cache the result; invalidate it
     } else {
-        if (tvg::equal(layer->cache.frameNo, frameNo)) return;
-        layer->cache.frameNo = frameNo;
+        if (tvg::equal(cached.frameNo, frameNo)) return;
+        cached.frameNo = frameNo;
     }
 
     auto transform = layer->transform;
@@ -192,11 +211,11 @@ void LottieBuilder::updateTransform(LottieLayer* layer, float frameNo)
 
     if (parent) updateTransform(parent, frameNo);
 
-    auto& matrix = layer->cache.matrix;
+    auto& matrix = cached.matrix;
 
-    _update(transform, frameNo, matrix, layer->cache.opacity, layer->autoOrient, tween, exps);
+    _update(transform, frameNo, matrix, cached.opacity, layer->autoOrient, tween, exps);
 
-    if (parent) layer->cache.matrix = parent->cache.matrix * matrix;
+    if (parent) cached.matrix = cache(parent).matrix * matrix;
 }
 
 
@@ -254,24 +273,23 @@ void LottieBuilder::updateGroup(LottieGroup* parent, LottieObject** child, float
 
     // special tune: sharing the context if the blending is compatible
     // propagate the blending to its parent(layer) if possible. this potentially helps performance if the layer has mattes/maskings.
+    auto& scene = state(group).scene;
     if (group->blendMethod == BlendMethod::Normal || group->blendMethod == parent->blendMethod) {
-        group->scene = parent->scene;
+        scene = state(parent).scene;
     } else if (parent->blendMethod == BlendMethod::Normal && parent->children.count == 1) {
-        group->scene = parent->scene;
-        group->scene->blend(group->blendMethod);
+        scene = state(parent).scene;
+        scene->blend(group->blendMethod);
     } else {
-        group->scene = tvg::Scene::gen();
-        parent->scene->add(group->scene);
-        group->scene->blend(group->blendMethod);
+        scene = tvg::Scene::gen();
+        state(parent).scene->add(scene);
+        scene->blend(group->blendMethod);
     }
 
-    group->reqFragment |= ctx->reqFragment;
-
     //generate a merging shape to consolidate partial shapes into a single entity
-    if (group->mergeable()) _draw(group, nullptr, ctx);
+    if (group->mergeable()) _draw(scene, nullptr, ctx);
 
     Inlist<RenderContext> contexts;
-    auto propagator = group->mergeable() ? ctx->propagator : static_cast<Shape*>(PAINT(ctx->propagator)->duplicate(group->pooling()));
+    auto propagator = group->mergeable() ? ctx->propagator : static_cast<Shape*>(PAINT(ctx->propagator)->duplicate(state(group).pooler.pooling()));
     contexts.back(new RenderContext(*ctx, propagator, group->mergeable()));
 
     updateChildren(group, frameNo, contexts);
@@ -300,7 +318,7 @@ bool LottieBuilder::fragmented(LottieGroup* parent, LottieObject** child, Inlist
     if (ctx->fragment) return true;
     if (!ctx->reqFragment) return false;
 
-    contexts.back(new RenderContext(*ctx, (Shape*)(PAINT(ctx->propagator)->duplicate(parent->pooling()))));
+    contexts.back(new RenderContext(*ctx, (Shape*)(PAINT(ctx->propagator)->duplicate(state(parent).pooler.pooling()))));
 
     contexts.tail->begin = child - 1;
     ctx->fragment = fragment;
@@ -385,24 +403,24 @@ bool LottieBuilder::updateGradientFill(LottieGroup* parent, LottieObject** child
 }
 
 
-static bool _draw(LottieGroup* parent, LottieShape* shape, RenderContext* ctx)
+static bool _draw(Scene* scene, LottieRenderPooler<Shape>* pooler, RenderContext* ctx)
 {
     if (ctx->merging) return false;
 
-    if (shape) {
-        ctx->merging = shape->pooling();
+    if (pooler) {
+        ctx->merging = pooler->pooling();
         PAINT(ctx->propagator)->duplicate(ctx->merging);
     } else {
         ctx->merging = static_cast<Shape*>(ctx->propagator->duplicate());
     }
 
-    parent->scene->add(ctx->merging);
+    scene->add(ctx->merging);
 
     return true;
 }
 
 
-static void _repeat(LottieGroup* parent, Shape* path, LottieRenderPooler<Shape>* pooler, RenderContext* ctx)
+static void _repeat(Scene* scene, Shape* path, LottieRenderPooler<Shape>* pooler, RenderContext* ctx)
 {
     path->ref();  //prevent pooler returns the same path.
 
@@ -442,13 +460,13 @@ static void _repeat(LottieGroup* parent, Shape* path, LottieRenderPooler<Shape>*
         //push repeat shapes in order.
         if (repeater->inorder) {
             ARRAY_FOREACH(p, shapes) {
-                parent->scene->add(*p);
+                scene->add(*p);
                 (*p)->unref();
                 propagators.push(*p);
             }
         } else if (!shapes.empty()) {
             ARRAY_REVERSE_FOREACH(p, shapes) {
-                parent->scene->add(*p);
+                scene->add(*p);
                 (*p)->unref();
                 propagators.push(*p);
             }
@@ -464,7 +482,7 @@ void LottieBuilder::appendRect(LottieRect* rect, Shape* shape, Point& pos, Point
     auto cnt = path.pts.count;
 
     if (ctx->modifiers) {
-        auto temp = rect->pooling();
+        auto temp = state(rect).pooler.pooling();
         temp->reset();
         temp->appendRect(pos.x, pos.y, size.x, size.y, r, r, clockwise);
         ctx->modifiers->rect(to<ShapeImpl>(temp)->rs.path, to<ShapeImpl>(shape)->rs.path, pos, size, r, clockwise);
@@ -486,13 +504,13 @@ void LottieBuilder::updateRect(LottieGroup* parent, LottieObject** child, float
     auto r = std::min({rect->radius(frameNo, tween, exps), size.x * 0.5f, size.y * 0.5f});
 
     if (ctx->repeaters.empty()) {
-        _draw(parent, rect, ctx);
+        _draw(state(parent).scene, &state(rect).pooler, ctx);
         appendRect(rect, ctx->merging, pos, size, r, rect->clockwise, ctx);
     } else {
-        auto shape = rect->pooling();
+        auto shape = state(rect).pooler.pooling();
         shape->reset();
         appendRect(rect, shape, pos, size, r, rect->clockwise, ctx);
-        _repeat(parent, shape, rect, ctx);
+        _repeat(state(parent).scene, shape, &state(rect).pooler, ctx);
     }
 }
 
@@ -502,7 +520,7 @@ void LottieBuilder::appendCircle(LottieEllipse* ellipse, Shape* shape, Point& ce
     auto cnt = path.pts.count;
 
     if (ctx->modifiers) {
-        auto temp = ellipse->pooling();
+        auto temp = state(ellipse).pooler.pooling();
         temp->reset();
         temp->appendCircle(center.x, center.y, radius.x, radius.y, clockwise);
         ctx->modifiers->ellipse(to<ShapeImpl>(temp)->rs.path, to<ShapeImpl>(shape)->rs.path, center, radius, clockwise);
@@ -523,13 +541,13 @@ void LottieBuilder::updateEllipse(LottieGroup* parent, LottieObject** child, flo
     auto size = ellipse->size(frameNo, tween, exps) * 0.5f;
 
     if (ctx->repeaters.empty()) {
-        _draw(parent, ellipse, ctx);
+        _draw(state(parent).scene, &state(ellipse).pooler, ctx);
         appendCircle(ellipse, ctx->merging, pos, size, ellipse->clockwise, ctx);
     } else {
-        auto shape = ellipse->pooling();
+        auto shape = state(ellipse).pooler.pooling();
         shape->reset();
         appendCircle(ellipse, shape, pos, size, ellipse->clockwise, ctx);
-        _repeat(parent, shape, ellipse, ctx);
+        _repeat(state(parent).scene, shape, &state(ellipse).pooler, ctx);
     }
 }
 
@@ -539,14 +557,14 @@ void LottieBuilder::updatePath(LottieGroup* parent, LottieObject** child, float
     auto path = static_cast<LottiePath*>(*child);
 
     if (ctx->repeaters.empty()) {
-        _draw(parent, path, ctx);
+        _draw(state(parent).scene, &state(path).pooler, ctx);
         path->pathset(frameNo, to<ShapeImpl>(ctx->merging)->rs.path, ctx->transform, tween, exps, ctx->modifiers);
         PAINT(ctx->merging)->mark(RenderUpdateFlag::Path);
     } else {
-        auto shape = path->pooling();
+        auto shape = state(path).pooler.pooling();
         shape->reset();
         path->pathset(frameNo, to<ShapeImpl>(shape)->rs.path, ctx->transform, tween, exps, ctx->modifiers);
-        _repeat(parent, shape, path, ctx);
+        _repeat(state(parent).scene, shape, &state(path).pooler, ctx);
     }
 }
 
@@ -579,7 +597,7 @@ void LottieBuilder::updateStar(LottiePolyStar* star, float frameNo, Matrix* tran
 
     Shape* shape;
     if (ctx->modifiers) {
-        shape = star->pooling();
+        shape = state(star).pooler.pooling();
         shape->reset();
     } else {
         shape = merging;
@@ -689,7 +707,7 @@ void LottieBuilder::updatePolygon(LottieGroup* parent, LottiePolyStar* star, flo
 
     Shape* shape;
     if (ctx->modifiers) {
-        shape = star->pooling();
+        shape = state(star).pooler.pooling();
         shape->reset();
     } else {
         shape = merging;
@@ -753,16 +771,16 @@ void LottieBuilder::updatePolystar(LottieGroup* parent, LottieObject** child, fl
     auto identity = tvg::identity((const Matrix*)&matrix);
 
     if (ctx->repeaters.empty()) {
-        _draw(parent, star, ctx);
+        _draw(state(parent).scene, &state(star).pooler, ctx);
         if (star->type == LottiePolyStar::Star) updateStar(star, frameNo, (identity ? nullptr : &matrix), ctx->merging, ctx, tween, exps);
         else updatePolygon(parent, star, frameNo, (identity  ? nullptr : &matrix), ctx->merging, ctx, tween, exps);
         PAINT(ctx->merging)->mark(RenderUpdateFlag::Path);
     } else {
-        auto shape = star->pooling();
+        auto shape = state(star).pooler.pooling();
         shape->reset();
         if (star->type == LottiePolyStar::Star) updateStar(star, frameNo, (identity ? nullptr : &matrix), shape, ctx, tween, exps);
         else updatePolygon(parent, star, frameNo, (identity  ? nullptr : &matrix), shape, ctx, tween, exps);
-        _repeat(parent, shape, star, ctx);
+        _repeat(state(parent).scene, shape, &state(star).pooler, ctx);
     }
 }
 
@@ -932,13 +950,13 @@ void LottieBuilder::updatePrecomp(LottieComposition* comp, LottieLayer* precomp,
 
     ARRAY_REVERSE_FOREACH(c, precomp->children) {
         auto child = static_cast<LottieLayer*>(*c);
-        if (!child->matteSrc) updateLayer(comp, precomp->scene, child, frameNo);
+        if (!child->matteSrc) updateLayer(comp, state(precomp).scene, child, frameNo);
     }
 
     //clip the layer viewport
-    auto clipper = precomp->statical.pooling(true);
-    clipper->transform(precomp->cache.matrix);
-    precomp->scene->clip(clipper);
+    auto clipper = cache(precomp).statical.pooling(precomp->statical);
+    clipper->transform(cache(precomp).matrix);
+    state(precomp).scene->clip(clipper);
 }
 
 void LottieBuilder::updatePrecomp(LottieComposition* comp, LottieLayer* precomp, float frameNo, LottieTween& tween)
@@ -955,9 +973,9 @@ void LottieBuilder::updatePrecomp(LottieComposition* comp, LottieLayer* precomp,
 
 void LottieBuilder::updateSolid(LottieLayer* layer)
 {
-    auto solidFill = layer->statical.pooling(true);
-    solidFill->opacity(layer->cache.opacity);
-    layer->scene->add(solidFill);
+    auto solidFill = cache(layer).statical.pooling(layer->statical);
+    solidFill->opacity(cache(layer).opacity);
+    state(layer).scene->add(solidFill);
 }
 
 void LottieBuilder::updateImage(LottieLayer* layer, float frameNo)
@@ -980,7 +998,8 @@ void LottieBuilder::updateImage(LottieLayer* layer, float frameNo)
         image->valid = true;
     }
 
-    layer->scene->add(picture->refCnt() == 1 ? picture : picture->duplicate());
+    //the shared picture can't be bound to the renderers of the other instances
+    state(layer).scene->add((picture->refCnt() == 1 && !shared) ? picture : picture->duplicate());
     image->play((frameNo - layer->inFrame) / (layer->outFrame - layer->inFrame));
 }
 
@@ -1045,7 +1064,7 @@ void LottieBuilder::updateURLFont(LottieLayer* layer, float frameNo, LottieText*
     auto vspacing = (doc.height > 0.0f && paint->lines() > 1) ? (doc.height / metrics.advance) : 1.0f;
     paint->spacing(hspacing, vspacing);
 
-    layer->scene->add(paint);
+    state(layer).scene->add(paint);
 
     //outline
     auto strkColor = doc.stroke.color;
@@ -1081,7 +1100,7 @@ void LottieBuilder::updateURLFont(LottieLayer* layer, float frameNo, LottieText*
 Shape* LottieBuilder::textShape(LottieText* text, float frameNo, const TextDocument& doc, LottieGlyph* glyph, const RenderText& ctx)
 {
     auto& transform = ctx.lineScene->transform();
-    auto shape = text->pooling();
+    auto shape = state(text).pooler.pooling();
     shape->reset();
 
     ARRAY_FOREACH(p, glyph->children) {
@@ -1251,8 +1270,9 @@ static float _nextWordWidth(const LottieText* text, const TextDocument& doc, con
 void LottieBuilder::updateLocalFont(LottieLayer* layer, float frameNo, LottieText* text, const TextDocument& doc)
 {
     RenderText ctx(text, doc);
-    ctx.follow = (text->follow && ((uint32_t)text->follow->maskIdx < layer->masks.count)) ? text->follow : nullptr;
-    ctx.firstMargin = ctx.follow ? ctx.follow->prepare(layer->masks[ctx.follow->maskIdx], frameNo, ctx.scale, tween, exps) : 0.0f;
+    LottieTextFollower follower;
+    ctx.follow = (text->follow && ((uint32_t)text->follow->maskIdx < layer->masks.count)) ? &follower : nullptr;
+    ctx.firstMargin = ctx.follow ? follower.prepare(text->follow, layer->masks[text->follow->maskIdx], frameNo, ctx.scale, tween, exps) : 0.0f;
     auto lineWrapped = false;
 
     //text string
@@ -1271,7 +1291,7 @@ void LottieBuilder::updateLocalFont(LottieLayer* layer, float frameNo, LottieTex
             ctx.textScene->add(ctx.lineScene);
             ctx.textScene->translate(layout.x, layout.y);
             ctx.textScene->scale(ctx.scale);
-            layer->scene->add(ctx.textScene);
+            state(layer).scene->add(ctx.textScene);
 
             ctx.lineScene = Scene::gen();
             ctx.lineScene->translate(ctx.cursor.x, ctx.cursor.y);
@@ -1340,14 +1360,24 @@ void LottieBuilder::updateText(LottieLayer* layer, float frameNo)
     if (layer->children.empty()) return;
 
     auto text = static_cast<LottieText*>(layer->children.first());
-    auto& doc = text->doc(frameNo, exps);
-    if (!doc.text) return;
+    auto doc = text->doc(frameNo);
 
-    if (text->font && text->font->origin == LottieFont::Origin::Local && !text->font->chars.empty()) {
-        updateLocalFont(layer, frameNo, text, doc);
-    } else {
-        updateURLFont(layer, frameNo, text, doc);
+    //overriding with expressions, the result is local since the model could be shared
+    auto evaluated = exps && text->doc.exp;
+    if (evaluated) {
+        doc.text = tvg::duplicate(doc.text);
+        exps->result(frameNo, doc, text->doc.exp);
     }
+
+    if (doc.text) {
+        if (text->font && text->font->origin == LottieFont::Origin::Local && !text->font->chars.empty()) {
+            updateLocalFont(layer, frameNo, text, doc);
+        } else {
+            updateURLFont(layer, frameNo, text, doc);
+        }
+    }
+
+    if (evaluated) tvg::free(doc.text);
 }
 
 
@@ -1358,8 +1388,8 @@ void LottieBuilder::updateMasks(LottieLayer* layer, float frameNo)
     //Introduce an intermediate scene for embracing matte + masking or precomp clipping + masking replaced by clipping
     if (layer->matteTarget || layer->type == LottieLayer::Precomp) {
         auto scene = Scene::gen();
-        scene->add(layer->scene);
-        layer->scene = scene;
+        scene->add(state(layer).scene);
+        state(layer).scene = scene;
     }
 
     Shape* pShape = nullptr;
@@ -1376,26 +1406,26 @@ void LottieBuilder::updateMasks(LottieLayer* layer, float frameNo)
 
         //the first mask
         if (!pShape) {
-            pShape = layer->pooling();
+            pShape = state(layer).pooler.pooling();
             to<ShapeImpl>(pShape)->reset();
             auto compMethod = (method == MaskMethod::Subtract || method == MaskMethod::InvAlpha) ? MaskMethod::InvAlpha : MaskMethod::Alpha;
             //Cheaper. Replace the masking with a clipper
             if (!layer->effect && layer->masks.count == 1 && compMethod == MaskMethod::Alpha) {
-                layer->scene->opacity(MULTIPLY(layer->scene->opacity(), opacity));
-                layer->scene->clip(pShape);
+                state(layer).scene->opacity(MULTIPLY(state(layer).scene->opacity(), opacity));
+                state(layer).scene->clip(pShape);
             } else {
-                layer->scene->mask(pShape, compMethod);
+                state(layer).scene->mask(pShape, compMethod);
             }
         //Chain mask composition
         } else if (pMethod != method || pOpacity != opacity || (method != MaskMethod::Subtract && method != MaskMethod::Difference)) {
-            auto shape = layer->pooling();
+            auto shape = state(layer).pooler.pooling();
             to<ShapeImpl>(shape)->reset();
             pShape->mask(shape, method);
             pShape = shape;
         }
 
         pShape->fill(255, 255, 255, opacity);
-        pShape->transform(layer->cache.matrix);
+        pShape->transform(cache(layer).matrix);
 
         //Default Masking
         if (expand == 0.0f) {
@@ -1419,12 +1449,12 @@ bool LottieBuilder::updateMatte(LottieComposition* comp, float frameNo, Scene* s
 
     updateLayer(comp, scene, target, frameNo);
 
-    if (target->scene) {
-        layer->scene->mask(target->scene, layer->matteType);
+    if (state(target).scene) {
+        state(layer).scene->mask(state(target).scene, layer->matteType);
     } else if (layer->matteType == MaskMethod::Alpha || layer->matteType == MaskMethod::Luma) {
         //matte target is not exist. alpha blending definitely bring an invisible result
-        Paint::rel(layer->scene);
-        layer->scene = nullptr;
+        Paint::rel(state(layer).scene);
+        state(layer).scene = nullptr;
         return false;
     }
     return true;
@@ -1435,7 +1465,7 @@ void LottieBuilder::updateStrokeEffect(LottieLayer* layer, LottieFxStroke* effec
 {
     if (layer->masks.count == 0) return;
 
-    auto shape = layer->pooling();
+    auto shape = state(layer).pooler.pooling();
     shape->reset();
 
     //FIXME: all mask
@@ -1450,7 +1480,7 @@ void LottieBuilder::updateStrokeEffect(LottieLayer* layer, LottieFxStroke* effec
         layer->masks[idx]->pathset(frameNo, to<ShapeImpl>(shape)->rs.path, nullptr, tween, exps);
     }
 
-    shape->transform(layer->cache.matrix);
+    shape->transform(cache(layer).matrix);
     shape->trimpath(effect->begin(frameNo) * 0.01f, effect->end(frameNo) * 0.01f);
     shape->strokeFill(255, 255, 255, (int)(effect->opacity(frameNo) * 255.0f));
     shape->strokeJoin(StrokeJoin::Round);
@@ -1476,11 +1506,11 @@ void LottieBuilder::updateStrokeEffect(LottieLayer* layer, LottieFxStroke* effec
             }
             return true;
         };
-        accessor->set(layer->scene, f, nullptr);
+        accessor->set(state(layer).scene, f, nullptr);
         delete(accessor);
     }
 
-    layer->scene->mask(shape, MaskMethod::Alpha);
+    state(layer).scene->mask(shape, MaskMethod::Alpha);
 }
 
 
@@ -1497,13 +1527,13 @@ void LottieBuilder::updateEffect(LottieLayer* layer, float frameNo, uint8_t qual
                 auto effect = static_cast<LottieFxTint*>(*p);
                 auto black = effect->black(frameNo);
                 auto white = effect->white(frameNo);
-                layer->scene->add(SceneEffect::Tint, black.r, black.g, black.b, white.r, white.g, white.b, (double)effect->intensity(frameNo));
+                state(layer).scene->add(SceneEffect::Tint, black.r, black.g, black.b, white.r, white.g, white.b, (double)effect->intensity(frameNo));
                 break;
             }
             case LottieEffect::Fill: {
                 auto effect = static_cast<LottieFxFill*>(*p);
                 auto color = effect->color(frameNo);
-                layer->scene->add(SceneEffect::Fill, color.r, color.g, color.b, (int)(255.0f * effect->opacity(frameNo)));
+                state(layer).scene->add(SceneEffect::Fill, color.r, color.g, color.b, (int)(255.0f * effect->opacity(frameNo)));
                 break;
             }
             case LottieEffect::Stroke: {
@@ -1516,19 +1546,19 @@ void LottieBuilder::updateEffect(LottieLayer* layer, float frameNo, uint8_t qual
                 auto dark = effect->dark(frameNo);
                 auto midtone = effect->midtone(frameNo);
                 auto bright = effect->bright(frameNo);
-                layer->scene->add(SceneEffect::Tritone, dark.r, dark.g, dark.b, midtone.r, midtone.g, midtone.b, bright.r, bright.g, bright.b, (int)effect->blend(frameNo));
+                state(layer).scene->add(SceneEffect::Tritone, dark.r, dark.g, dark.b, midtone.r, midtone.g, midtone.b, bright.r, bright.g, bright.b, (int)effect->blend(frameNo));
                 break;
             }
             case LottieEffect::DropShadow: {
                 auto effect = static_cast<LottieFxDropShadow*>(*p);
                 auto color = effect->color(frameNo);
                 //seems the opacity range in dropshadow is 0 ~ 256
-                layer->scene->add(SceneEffect::DropShadow, color.r, color.g, color.b, std::min(255, (int)effect->opacity(frameNo)), (double)effect->angle(frameNo), double(effect->distance(frameNo)), (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), quality);
+                state(layer).scene->add(SceneEffect::DropShadow, color.r, color.g, color.b, std::min(255, (int)effect->opacity(frameNo)), (double)effect->angle(frameNo), double(effect->distance(frameNo)), (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), quality);
                 break;
             }
             case LottieEffect::GaussianBlur: {
                 auto effect = static_cast<LottieFxGaussianBlur*>(*p);
-                layer->scene->add(SceneEffect::GaussianBlur, (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), effect->direction(frameNo) - 1, effect->wrap(frameNo), quality);
+                state(layer).scene->add(SceneEffect::GaussianBlur, (double)(effect->blurness(frameNo) * BLUR_TO_SIGMA), effect->direction(frameNo) - 1, effect->wrap(frameNo), quality);
                 break;
             }
             default: break;
@@ -1537,14 +1567,14 @@ void LottieBuilder::updateEffect(LottieLayer* layer, float frameNo, uint8_t qual
 }
 
 
-void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLayer* layer, float frameNo)
+void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLayer* layer, float frameNo, Paint* at, Scene* reuse)
 {
     if (layer->type == LottieLayer::Audio) {
         if (audioResolver.func) updateAudio(comp, layer, frameNo);
         return;
     }
 
-    layer->scene = nullptr;
+    state(layer).scene = nullptr;
 
     //visibility
     if (frameNo < layer->inFrame || frameNo >= layer->outFrame) {
@@ -1555,20 +1585,20 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
     updateTransform(layer, frameNo);
 
     //full transparent scene. no need to perform
-    if (layer->type != LottieLayer::Null && layer->cache.opacity == 0) return;
+    if (layer->type != LottieLayer::Null && cache(layer).opacity == 0) return;
 
-    //Prepare render data
-    layer->scene = Scene::gen();
-    layer->scene->id = layer->id;
+    //Prepare render data, the kept scene has been emptied by clear()
+    state(layer).scene = reuse ? reuse : Scene::gen();
+    state(layer).scene->id = layer->id;
 
     //ignore opacity when Null layer?
-    if (layer->type != LottieLayer::Null) layer->scene->opacity(layer->cache.opacity);
+    if (layer->type != LottieLayer::Null) state(layer).scene->opacity(cache(layer).opacity);
 
-    layer->scene->transform(layer->cache.matrix);
+    state(layer).scene->transform(cache(layer).matrix);
 
     if (!layer->matteSrc && !updateMatte(comp, frameNo, scene, layer)) return;
 
-    layer->scene->blend(layer->blendMethod);
+    state(layer).scene->blend(layer->blendMethod);
 
     switch (layer->type) {
         case LottieLayer::Precomp: {
@@ -1591,7 +1621,7 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
         default: {
             if (!layer->children.empty()) {
                 Inlist<RenderContext> contexts;
-                contexts.back(new RenderContext(layer->pooling()));
+                contexts.back(new RenderContext(state(layer).pooler.pooling()));
                 updateChildren(layer, frameNo, contexts);
                 contexts.free();
             }
@@ -1601,9 +1631,9 @@ void LottieBuilder::updateLayer(LottieComposition* comp, Scene* scene, LottieLay
 
     updateMasks(layer, frameNo);
 
-    updateEffect(layer, frameNo, comp->quality);
+    updateEffect(layer, frameNo, quality);
 
-    if (!layer->matteSrc) scene->add(layer->scene);
+    if (!layer->matteSrc && scene && !state(layer).scene->parent()) scene->add(state(layer).scene, at);
 }
 
 
@@ -1619,6 +1649,8 @@ static void _buildReference(LottieComposition* comp, LottieLayer* layer)
                 layer->effect |= asset->effect;
             }
         } else if (layer->type == LottieLayer::Image || layer->type == LottieLayer::Audio) {
+            //load the image in advance, the model isn't written over the updates
+            if (layer->type == LottieLayer::Image) static_cast<LottieImage*>(*p)->get();
             layer->children.push(*p);
         }
         break;
@@ -1713,6 +1745,177 @@ static bool _buildComposition(LottieComposition* comp, LottieRootLayer* parent)
 }
 
 
+//number the objects which have the frame states in the instances, the layers come first. see LottieObject::seq
+static void _buildSequence(LottieObject* obj, uint32_t& seq, bool layers)
+{
+    switch (obj->type) {
+        case LottieObject::Layer: {
+            if (layers) obj->seq = seq++;
+            //the children of the asset are numbered over the assets
+            if (static_cast<LottieLayer*>(obj)->rid) return;
+            break;
+        }
+        case LottieObject::Group: {
+            if (!layers) obj->seq = seq++;
+            break;
+        }
+        case LottieObject::Composition: break;
+        case LottieObject::Rect:
+        case LottieObject::Ellipse:
+        case LottieObject::Path:
+        case LottieObject::Polystar:
+        case LottieObject::Text: {
+            if (!layers) obj->seq = seq++;
+            return;
+        }
+        default: return;
+    }
+    ARRAY_FOREACH(p, static_cast<LottieGroup*>(obj)->children) _buildSequence(*p, seq, layers);
+}
+
+
+static void _buildSequence(LottieComposition* comp)
+{
+    uint32_t seq = 0;
+    _buildSequence(comp->root, seq, true);
+    ARRAY_FOREACH(p, comp->assets) _buildSequence(*p, seq, true);
+    comp->layerCnt = seq;
+    _buildSequence(comp->root, seq, false);
+    ARRAY_FOREACH(p, comp->assets) _buildSequence(*p, seq, false);
+    comp->seqCnt = seq;
+}
+
+
+//the groups inherit the fragment requirement from their parents, the layers are the roots of the propagation.
+static void _buildFragment(LottieGroup* parent)
+{
+    ARRAY_FOREACH(p, parent->children) {
+        auto obj = *p;
+        if (obj->type == LottieObject::Group) {
+            auto group = static_cast<LottieGroup*>(obj);
+            group->reqFragment |= parent->reqFragment;
+            _buildFragment(group);
+        } else if (obj->type == LottieObject::Layer && !static_cast<LottieLayer*>(obj)->rid) {
+            _buildFragment(static_cast<LottieGroup*>(obj));
+        }
+    }
+}
+
+
+//Check whether the layer gives the same scene over the frames [begin, end)
+static bool _static(LottieComposition* comp, LottieLayer* layer, float begin, float end)
+{
+    //never visible
+    if (layer->outFrame <= begin || (begin < end ? layer->inFrame >= end : layer->inFrame > begin)) return true;
+
+    //visible partially
+    if (layer->inFrame > begin || layer->outFrame < end) return false;
+
+    //images could be played, audios are not the scene
+    if (layer->dynamic || layer->type == LottieLayer::Image || layer->type == LottieLayer::Audio) return false;
+
+    for (auto parent = layer->parent; parent; parent = parent->parent) {
+        if (parent->dynamic) return false;
+    }
+
+    if (layer->matteTarget && !_static(comp, layer->matteTarget, begin, end)) return false;
+
+    if (layer->type == LottieLayer::Precomp) {
+        begin = layer->remap(comp, begin, nullptr);
+        end = layer->remap(comp, end, nullptr);
+        if (begin > end) return false;
+        ARRAY_FOREACH(p, layer->children) {
+            if (!_static(comp, static_cast<LottieLayer*>(*p), begin, end)) return false;
+        }
+    }
+    return true;
+}
+
+
+//Check whether the layer scene could be updated in place, the mattes, masks and effects wrap or decorate the scene.
+static bool _reusable(LottieLayer* layer)
+{
+    if (layer->matteSrc || layer->matteTarget || layer->masks.count > 0 || layer->effects.count > 0) return false;
+    return layer->type == LottieLayer::Precomp || layer->type == LottieLayer::Shape || layer->type == LottieLayer::Solid || layer->type == LottieLayer::Text;
+}
+
+
+static void _buildRetention(LottieComposition* comp)
+{
+    ARRAY_FOREACH(p, comp->root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        layer->retainable = _static(comp, layer, layer->inFrame, layer->outFrame);
+        layer->reusable = !layer->retainable && _reusable(layer);
+    }
+}
+
+
+template<typename T>
+static bool _contains(Array<T>& items, T item)
+{
+    ARRAY_FOREACH(p, items) {
+        if (*p == item) return true;
+    }
+    return false;
+}
+
+
+//collect the precomps referred more than once, their layers are shared among the referrers.
+static void _buildReferences(LottieLayer* layer, Array<unsigned long>& rids, Array<unsigned long>& shareds)
+{
+    if (layer->type != LottieLayer::Precomp) return;
+
+    if (_contains(rids, layer->rid)) {
+        if (!_contains(shareds, layer->rid)) shareds.push(layer->rid);
+        return;
+    }
+    rids.push(layer->rid);
+
+    ARRAY_FOREACH(p, layer->children) {
+        _buildReferences(static_cast<LottieLayer*>(*p), rids, shareds);
+    }
+}
+
+
+static bool _isolated(LottieLayer* layer, Array<unsigned long>& shareds)
+{
+    //images, texts and audios could touch the resources shared over the layers
+    if (layer->type == LottieLayer::Image || layer->type == LottieLayer::Text || layer->type == LottieLayer::Audio) return false;
+
+    if (layer->matteTarget && !_isolated(layer->matteTarget, shareds)) return false;
+
+    if (layer->type == LottieLayer::Precomp) {
+        if (_contains(shareds, layer->rid)) return false;
+        ARRAY_FOREACH(p, layer->children) {
+            if (!_isolated(static_cast<LottieLayer*>(*p), shareds)) return false;
+        }
+    }
+    return true;
+}
+
+
+static void _buildIsolation(LottieComposition* comp)
+{
+    Array<unsigned long> rids, shareds;
+    Array<LottieLayer*> mattes, sharedMattes;
+
+    ARRAY_FOREACH(p, comp->root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        _buildReferences(layer, rids, shareds);
+
+        //a matte could be used by the multiple layers
+        if (!layer->matteTarget) continue;
+        if (_contains(mattes, layer->matteTarget)) sharedMattes.push(layer->matteTarget);
+        else mattes.push(layer->matteTarget);
+    }
+
+    ARRAY_FOREACH(p, comp->root->children) {
+        auto layer = static_cast<LottieLayer*>(*p);
+        layer->isolated = _isolated(layer, shareds) && !(layer->matteTarget && _contains(sharedMattes, layer->matteTarget));
+    }
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -1746,31 +1949,263 @@ bool LottieBuilder::update(LottieComposition* comp, float frameNo)
 
     if (tween.active) comp->clamp(tween.to);
 
-    if (exps && comp->expressions) exps->update(comp->timeAtFrame(frameNo));
+    //trade the easing precision for the speed below the default quality
+    keyframes.dense = quality < 50;
+    if (keyframes.dense) comp->ease();
+
+    ScopedFrameState bind(&keyframes);
+
+    if (exps && comp->expressions) exps->update(comp->timeAtFrame(frameNo), caches);
+
+    if (retains.count != comp->root->children.count) {
+        retains.reserve(comp->root->children.count);
+        reuses.reserve(comp->root->children.count);
+        while (retains.count < comp->root->children.count) retains.push(nullptr);
+        while (reuses.count < comp->root->children.count) reuses.push(nullptr);
+    }
+
+    auto parallel = dispatch(comp, frameNo);
+
+    //the root scene has the kept scenes only in the layer order, the others are inserted among them.
+    auto& paints = scene->paints();
+    auto next = paints.begin();
 
     //update children layers
     ARRAY_REVERSE_FOREACH(child, comp->root->children) {
         auto layer = static_cast<LottieLayer*>(*child);
-        if (!layer->matteSrc) updateLayer(comp, comp->root->scene, layer, frameNo);
+        if (layer->matteSrc) continue;
+
+        auto at = (next == paints.end()) ? nullptr : *next;
+        auto& retain = retains[child - comp->root->children.begin()];
+
+        //static layer, nothing to update
+        if (retain) {
+            auto visible = frameNo >= layer->inFrame && frameNo < layer->outFrame;
+            if (retain->parent() == scene) {
+                if (!visible) stales.push(retain);
+                ++next;
+            } else if (visible) {
+                scene->add(retain, at);
+            }
+            continue;
+        }
+
+        auto& reuse = reuses[child - comp->root->children.begin()];
+        auto task = parallel ? tasks[child - comp->root->children.begin()] : nullptr;
+        if (task && task->layer) {
+            join(task);
+            if (state(layer).scene && !state(layer).scene->parent()) scene->add(state(layer).scene, at);
+        } else updateLayer(comp, scene, layer, frameNo, at, reuse);
+
+        //dynamic layer, its scene stays in place with the refilled contents
+        if (reuse) {
+            if (reuse->parent() == scene) {
+                if (state(layer).scene != reuse) stales.push(reuse);
+                ++next;
+            }
+            continue;
+        }
+
+        if ((layer->retainable || layer->reusable) && state(layer).scene) {
+            state(layer).scene->ref();
+            if (layer->retainable) retain = state(layer).scene;
+            else reuse = state(layer).scene;
+        }
+    }
+
+    return true;
+}
+
+
+//request the updates of the isolated root layers to the worker threads, they are joined in the layer order.
+bool LottieBuilder::dispatch(LottieComposition* comp, float frameNo)
+{
+    //the tweening and expressions have the states over the layers.
+    if (TaskScheduler::threads() == 0 || tween.active || (exps && comp->expressions)) return false;
+
+    auto& children = comp->root->children;
+    auto cnt = 0;
+
+    ARRAY_FOREACH(child, children) {
+        auto layer = static_cast<LottieLayer*>(*child);
+        if (!layer->isolated || layer->matteSrc || retains[child - children.begin()]) continue;
+        if (frameNo < layer->inFrame || frameNo >= layer->outFrame) continue;
+        ++cnt;
+    }
+
+    if (cnt < 2) return false;
+
+    if (tasks.count != children.count) {
+        tasks.reserve(children.count);
+        while (tasks.count < children.count) tasks.push(nullptr);
+    }
+
+    //free the retired tasks which are passed through the scheduler
+    uint32_t keep = 0;
+    ARRAY_FOREACH(p, retired) {
+        if ((*p)->state == LottieLayerTask::Done) {
+            (*p)->done();
+            delete(*p);
+        } else retired[keep++] = *p;
+    }
+    retired.count = keep;
+
+    //resolve the parent transforms ahead, the parallel layers could refer to the same parents.
+    ARRAY_FOREACH(child, children) {
+        updateTransform(static_cast<LottieLayer*>(*child)->parent, frameNo);
+    }
+
+    ARRAY_REVERSE_FOREACH(child, children) {
+        auto layer = static_cast<LottieLayer*>(*child);
+        if (!layer->isolated || layer->matteSrc || retains[child - children.begin()]) continue;
+        if (frameNo < layer->inFrame || frameNo >= layer->outFrame) continue;
+
+        auto& task = tasks[child - children.begin()];
+        //still queued in the scheduler, can't be requested again
+        if (task && task->state == LottieLayerTask::Claimed) {
+            retired.push(task);
+            task = nullptr;
+        }
+        if (task) task->done();
+        else task = new LottieLayerTask;
+        task->builder = this;
+        task->comp = comp;
+        task->layer = layer;
+        task->reuse = reuses[child - children.begin()];
+        task->frameNo = frameNo;
+        task->state = LottieLayerTask::Requested;
+        TaskScheduler::request(task);
     }
 
     return true;
 }
 
 
+//the waiting thread might not help the workers with a lock, take the update over if it's not started yet.
+void LottieBuilder::join(LottieLayerTask* task)
+{
+    if (task->claim()) updateLayer(task->comp, nullptr, task->layer, task->frameNo, nullptr, task->reuse);
+    else task->done();
+    task->layer = nullptr;
+}
+
+
+void LottieLayerTask::run(unsigned tid)
+{
+    if (claim()) {
+        ScopedFrameState bind(&builder->keyframes);
+        builder->updateLayer(comp, nullptr, layer, frameNo, nullptr, reuse);
+    }
+    state = Done;
+}
+
+
+bool LottieBuilder::retained(Paint* paint)
+{
+    ARRAY_FOREACH(p, retains) {
+        if (*p == paint) return true;
+    }
+    ARRAY_FOREACH(p, reuses) {
+        if (*p == paint) return true;
+    }
+    return false;
+}
+
+
+void LottieBuilder::clear(bool all)
+{
+    if (!scene) return;
+
+    sweep();
+
+    if (all) {
+        ARRAY_FOREACH(p, retains) {
+            if (*p) (*p)->unref();
+            *p = nullptr;
+        }
+        ARRAY_FOREACH(p, reuses) {
+            if (*p) (*p)->unref();
+            *p = nullptr;
+        }
+        scene->remove();
+        return;
+    }
+
+    //keep the static layers in place, they don't need to be updated again
+    auto& paints = scene->paints();
+    for (auto p = paints.begin(); p != paints.end();) {
+        auto paint = *p++;
+        if (!retained(paint)) scene->remove(paint);
+    }
+
+    //empty the dynamic layers in place, their pooled contents are updated and refilled
+    ARRAY_FOREACH(p, reuses) {
+        if (*p) (*p)->remove();
+    }
+}
+
+
+//detach the hidden static layers. the damages of the removal must be reported on the main thread
+void LottieBuilder::sweep()
+{
+    ARRAY_FOREACH(p, stales) scene->remove(*p);
+    stales.clear();
+}
+
+
 void LottieBuilder::build(LottieComposition* comp)
 {
     if (!comp) return;
 
-    comp->root->scene = Scene::gen();
+    //the model could be built by the other instance already.
+    if (!comp->root->buildDone && _buildComposition(comp, comp->root)) {
+        _buildRetention(comp);
+        _buildIsolation(comp);
+        _buildFragment(comp->root);
+        ARRAY_FOREACH(p, comp->assets) {
+            if ((*p)->type == LottieObject::Composition) _buildFragment(static_cast<LottieGroup*>(*p));
+        }
+        _buildSequence(comp);
+    }
+
+    //the frame states of this instance, the model is never written over the updates
+    if (!states) {
+        states = new LottieObjectState[comp->seqCnt];
+        caches = new LottieLayerCache[comp->layerCnt];
+        keyframes.cursors = new uint32_t[comp->cursorCnt]();
+        keyframes.cursorCnt = comp->cursorCnt;
+    }
+
+    //the script contexts are ready before the first frame
+    if (exps && comp->expressions) exps->prepare();
 
-    _buildComposition(comp, comp->root);
+    //keep the root scene that might be delivered to the picture already.
+    if (scene) return;
+
+    scene = Scene::gen();
 
     //viewport clip
     auto clip = Shape::gen();
     clip->appendRect(0, 0, comp->w, comp->h);
-    comp->root->scene->clip(clip);
+    scene->clip(clip);
 
     //turn off partial rendering for children
-    to<SceneImpl>(comp->root->scene)->size({comp->w, comp->h});
+    to<SceneImpl>(scene)->size({comp->w, comp->h});
+}
+
+
+void LottieBuilder::release(LottieComposition* comp)
+{
+    if (!comp) return;
+
+    clear(true);
+
+    //the pooled paints of this instance
+    delete[] states;
+    delete[] caches;
+    delete[] keyframes.cursors;
+    states = nullptr;
+    caches = nullptr;
+    keyframes.cursors = nullptr;
+    keyframes.cursorCnt = 0;
 }
@@ -23,15 +23,19 @@
 #ifndef _TVG_LOTTIE_BUILDER_H_
 #define _TVG_LOTTIE_BUILDER_H_
 
+#include <atomic>
 #include "tvgCommon.h"
 #include "tvgInlist.h"
 #include "tvgShape.h"
+#include "tvgTaskScheduler.h"
 #include "tvgLottieExpressions.h"
 #include "tvgLottieModifier.h"
+#include "tvgLottieRenderPooler.h"
 #include "tvgLottieTween.h"
 #include "thorvg_lottie.h"
 
 struct LottieComposition;
+struct LottieBuilder;
 
 struct RenderRepeater
 {
@@ -58,7 +62,7 @@ struct RenderText
     Scene* textScene;
     Scene* lineScene;
     float capScale, firstMargin;
-    LottieTextFollowPath* follow;
+    LottieTextFollower* follow;
 
     RenderText(LottieText* text, const TextDocument& doc) : p(doc.text), nChars(strlen(p)), scale(doc.size), textScene(Scene::gen()), lineScene(Scene::gen())
     {
@@ -148,6 +152,22 @@ struct RenderContext
     }
 };
 
+//the frame state of a model object in an instance, the model could be shared with the other instances. see LottieObject::seq
+struct LottieObjectState
+{
+    LottieRenderPooler<Shape> pooler;  //the paints bound to the renderer of the instance
+    Scene* scene = nullptr;            //the scene of the group at the current frame
+};
+
+//the frame state of a layer in an instance
+struct LottieLayerCache
+{
+    LottieRenderPooler<Shape> statical;  //the copies of the solid fill or the clipper
+    float frameNo = -1.0f;
+    Matrix matrix;
+    uint8_t opacity;
+};
+
 struct AudioResolver
 {
     std::function<void(const tvg::LottieAudioResolver& info, void* data)> func;
@@ -155,6 +175,29 @@ struct AudioResolver
 };
 
 
+//updates a root layer on a worker thread, the result scene is attached by the builder in the layer order.
+struct LottieLayerTask : Task
+{
+    enum State : uint8_t {Idle = 0, Requested, Claimed, Done};
+
+    LottieBuilder* builder;
+    LottieComposition* comp;
+    LottieLayer* layer = nullptr;  //the requested layer, nullptr if not requested
+    Scene* reuse = nullptr;        //the kept scene of the layer to be updated in place
+    float frameNo;
+    std::atomic<uint8_t> state{Idle};
+
+    //either a worker or the builder takes the update, the other one skips it.
+    bool claim()
+    {
+        uint8_t expected = Requested;
+        return state.compare_exchange_strong(expected, Claimed);
+    }
+
+    void run(unsigned tid) override;
+};
+
+
 struct LottieBuilder
 {
     LottieBuilder()
@@ -164,6 +207,25 @@ struct LottieBuilder
 
     ~LottieBuilder()
     {
+        ARRAY_FOREACH(p, retains) {
+            if (*p) (*p)->unref();
+        }
+        ARRAY_FOREACH(p, reuses) {
+            if (*p) (*p)->unref();
+        }
+        ARRAY_FOREACH(p, tasks) {
+            if (!*p) continue;
+            (*p)->done();
+            delete(*p);
+        }
+        ARRAY_FOREACH(p, retired) {
+            (*p)->done();
+            delete(*p);
+        }
+        if (!initiated) Paint::rel(scene);
+        delete[] states;
+        delete[] caches;
+        delete[] keyframes.cursors;
         LottieExpressions::retrieve(exps);
     }
 
@@ -172,14 +234,37 @@ struct LottieBuilder
         return exps ? true : false;
     }
 
+    void clear(bool all = false);
+    void sweep();
+
     bool update(LottieComposition* comp, float progress);
     void build(LottieComposition* comp);
+    void release(LottieComposition* comp);
 
     const AssetResolver* resolver = nullptr;  //do not free this
     AudioResolver audioResolver;
     LottieTween tween;
+    Scene* scene = nullptr;  //root scene of this instance
+    uint8_t quality = 50;
+    bool initiated = false;  //the root scene is delivered to the picture
+    bool shared = false;     //the composition model is acquired from the other instance
 
 private:
+    Array<Paint*> retains;   //the kept scenes of the static root layers, in the layer order
+    Array<Scene*> reuses;    //the kept scenes of the reusable root layers, in the layer order
+    Array<Paint*> stales;    //the kept scenes to be detached from the root scene on the main thread
+    Array<LottieLayerTask*> tasks;    //the parallel updates of the root layers, in the layer order
+    Array<LottieLayerTask*> retired;  //the tasks taken by the builder, but still queued in the scheduler
+    LottieObjectState* states = nullptr;  //the frame states of the model objects, in the sequence
+    LottieLayerCache* caches = nullptr;   //the frame states of the layers, in the sequence
+    LottieFrameState keyframes;           //the keyframe cursors and the easing option of this instance
+
+    LottieObjectState& state(LottieObject* obj) { return states[obj->seq]; }
+    LottieLayerCache& cache(LottieLayer* layer) { return caches[layer->seq]; }
+
+    bool retained(Paint* paint);
+    bool dispatch(LottieComposition* comp, float frameNo);
+    void join(LottieLayerTask* task);
     void updateAudio(LottieComposition* comp, LottieLayer* layer, float frameNo);
     void appendRect(LottieRect* rect, Shape* shape, Point& pos, Point& size, float r, bool clockwise, RenderContext* ctx);
     void appendCircle(LottieEllipse* ellipse, Shape* shape, Point& center, Point& radius, bool clockwise, RenderContext* ctx);
@@ -188,7 +273,7 @@ private:
 
     void updateStrokeEffect(LottieLayer* layer, LottieFxStroke* effect, float frameNo);
     void updateEffect(LottieLayer* layer, float frameNo, uint8_t quality);
-    void updateLayer(LottieComposition* comp, Scene* scene, LottieLayer* layer, float frameNo);
+    void updateLayer(LottieComposition* comp, Scene* scene, LottieLayer* layer, float frameNo, Paint* at = nullptr, Scene* reuse = nullptr);
     bool updateMatte(LottieComposition* comp, float frameNo, Scene* scene, LottieLayer* layer);
     void updatePrecomp(LottieComposition* comp, LottieLayer* precomp, float frameNo);
     void updatePrecomp(LottieComposition* comp, LottieLayer* precomp, float frameNo, LottieTween& tween);
@@ -221,6 +306,8 @@ private:
     void updateZigZag(LottieGroup* parent, LottieObject** child, float frameNo, Inlist<RenderContext>& contexts, RenderContext* ctx);
 
     LottieExpressions* exps;
+
+    friend struct LottieLayerTask;
 };
 
 #endif //_TVG_LOTTIE_BUILDER_H
\ No newline at end of file
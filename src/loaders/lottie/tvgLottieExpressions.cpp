@@ -25,12 +25,14 @@
 #include "tvgCompressor.h"
 #include "tvgLottieModel.h"
 #include "tvgLottieExpressions.h"
+#include "tvgLottieBuilder.h"
 #include "tvgLock.h"
 
 #ifdef THORVG_LOTTIE_EXPRESSIONS_SUPPORT
 
 #ifdef THORVG_THREAD_SUPPORT
     #include "jerryscript-port.h"
+    #include "tvgTaskScheduler.h"
 #endif
 
 /************************************************************************/
@@ -70,7 +72,11 @@ static const char* EXP_POSITION = "position";
 
 static LottieExpressions* _exps = nullptr;
 static uint32_t _refCnt = 0;
+static uint32_t _gen = 0;
 static Key _lockKey;
+static thread_local const LottieLayerCache* _caches = nullptr;  //the layer states of the instance in update
+
+#define EXP_SCRIPT_CACHE_MAX 4096   //compiled scripts per context, the cache is flushed beyond this
 
 /**
  * external magic strings for the per-frame hot path (buildProperty, buildLayer, buildTransform, bm_rt).
@@ -109,6 +115,10 @@ static const jerry_char_t* _magicStrings[MAGIC_STRING_COUNT];
 #undef TVG_LOTTIE_MAGIC_STRING_LIST
 
 
+//updates the ExpContent of the function in-place, false if the function is not built yet
+static bool _updateContent(jerry_value_t context, const char* key, LottieExpression* exp, float frameNo, void* target);
+
+
 static ExpContent* _expcontent(LottieExpression* exp, float frameNo, void* data, size_t refCnt = 1)
 {
     auto ret = tvg::malloc<ExpContent>(sizeof(ExpContent));
@@ -246,6 +256,20 @@ static void contentFree(void *native_p, struct jerry_object_native_info_t *info_
 static jerry_object_native_info_t freeCb {contentFree, 0, 0};
 
 
+static bool _updateContent(jerry_value_t context, const char* key, LottieExpression* exp, float frameNo, void* target)
+{
+    auto obj = jerry_object_get_sz(context, key);
+    auto data = static_cast<ExpContent*>(jerry_object_get_native_ptr(obj, &freeCb));
+    if (data) {
+        data->exp = exp;
+        data->frameNo = frameNo;
+        data->data = target;
+    }
+    jerry_value_free(obj);
+    return data;
+}
+
+
 static char* _name(jerry_value_t args)
 {
     auto arg0 = jerry_value_to_string(args);
@@ -270,7 +294,7 @@ static unsigned long _idByName(jerry_value_t args)
 static jerry_value_t _toComp(const jerry_call_info_t* info, const jerry_value_t args[], const jerry_length_t argsCnt)
 {
     auto layer = static_cast<LottieLayer*>(jerry_object_get_native_ptr(info->function, nullptr));
-    return _point2d(_point2d(args[0]) * layer->cache.matrix);
+    return _point2d(_point2d(args[0]) * (_caches ? _caches[layer->seq].matrix : tvg::identity()));
 }
 
 
@@ -565,6 +589,16 @@ static void _buildLayer(jerry_value_t context, float frameNo, LottieLayer* layer
 }
 
 
+//the frame dependent part of _buildLayer() on the layer built already
+static void _updateLayer(jerry_value_t context, float frameNo, LottieLayer* layer, LottieExpression* exp)
+{
+    _buildTransform(context, frameNo, layer->transform);
+
+    //content() and effect() share the same ExpContent
+    _updateContent(context, EXP_CONTENT, exp, frameNo, layer);
+}
+
+
 static jerry_value_t _addsub(const jerry_value_t args[], float addsub)
 {
     //string + string
@@ -1231,16 +1265,9 @@ static void _buildProperty(float frameNo, jerry_value_t context, LottieExpressio
 
     //update shared ExpContent in-place
     auto updateContent = [&context, exp, frameNo](const char* key, void* target) {
-        auto obj = jerry_object_get_sz(context, key);
-        auto data = static_cast<ExpContent*>(jerry_object_get_native_ptr(obj, &freeCb));
-        if (data) {
-            data->exp = exp;
-            data->frameNo = frameNo;
-            data->data = target;
-        } else {
+        if (!_updateContent(context, key, exp, frameNo, target)) {
             TVGERR("LOTTIE", "ExpContent lost due to function overwrite");
         }
-        jerry_value_free(obj);
     };
 
     setFunction(_valueAtTime,    "valueAtTime");
@@ -1307,6 +1334,79 @@ static jerry_value_t _comp(const jerry_call_info_t* info, const jerry_value_t ar
 }
 
 
+static bool _identifier(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$';
+}
+
+
+//pure names, which never refer the time, the random or the other properties
+static bool _pure(const char* name, size_t len)
+{
+    static const char* names[] = {
+        "var", "let", "const", "if", "else", "for", "while", "do", "return", "break", "continue", "true", "false", "null", "undefined", "new", "typeof",
+        "Math", "PI", "E", "SQRT2", "abs", "acos", "asin", "atan", "atan2", "ceil", "cos", "exp", "floor", "log", "max", "min", "pow", "round", "sin", "sqrt", "tan",
+        "Array", "Number", "length", "$bm_rt", "$bm_mul", "$bm_sum", "$bm_add", "$bm_sub", "$bm_div", "$bm_mod", "mul", "sum", "add", "sub", "div", "mod",
+        "clamp", "dot", "cross", "normalize", "degreesToRadians", "radiansToDegrees", "linear", "ease", "easeIn", "easeOut"
+    };
+    for (auto n : names) {
+        if (strlen(n) == len && !strncmp(n, name, len)) return true;
+    }
+    return false;
+}
+
+
+//conservatively checks the code result is invariant over the frames: it must consist of the pure names and its own variables.
+static bool _constant(const char* code)
+{
+    Array<const char*> vars;   //the declared variables, terminated by the non-identifier characters
+    auto declared = [&vars](const char* name, size_t len) {
+        ARRAY_FOREACH(p, vars) {
+            if (!strncmp(*p, name, len) && !_identifier((*p)[len])) return true;
+        }
+        return false;
+    };
+
+    //1. collect the variables in the declarations: var a = 1, b = (2, 3);
+    auto decl = false;
+    auto depth = 0;
+    auto prev = ',';
+    for (auto p = code; *p;) {
+        if (_identifier(*p)) {
+            auto begin = p;
+            while (_identifier(*p)) ++p;
+            auto len = size_t(p - begin);
+            if (decl && depth == 0 && prev == ',' && !(*begin >= '0' && *begin <= '9')) vars.push(begin);
+            if ((len == 3 && (!strncmp(begin, "var", 3) || !strncmp(begin, "let", 3))) || (len == 5 && !strncmp(begin, "const", 5))) {
+                decl = true;
+                depth = 0;
+                prev = ',';
+            } else prev = 'a';
+            continue;
+        }
+        if (*p == '(' || *p == '[' || *p == '{') ++depth;
+        else if (*p == ')' || *p == ']' || *p == '}') --depth;
+        else if (*p == ';' || *p == '\n') decl = false;
+        if (*p != ' ' && *p != '\t') prev = *p;
+        ++p;
+    }
+
+    //2. every name must be pure or declared. member names are checked as well, it's conservative.
+    for (auto p = code; *p;) {
+        if (!_identifier(*p)) {
+            ++p;
+            continue;
+        }
+        auto begin = p;
+        while (_identifier(*p)) ++p;
+        //numbers, including 1e5 and 0x1f
+        if (*begin >= '0' && *begin <= '9') continue;
+        if (!_pure(begin, p - begin) && !declared(begin, p - begin)) return false;
+    }
+    return true;
+}
+
+
 static void _buildMath(jerry_value_t context)
 {
     auto bm_mul = jerry_function_external(_mul);
@@ -1430,11 +1530,13 @@ void LottieExpressions::buildGlobal(Context& context, float frameNo, LottieExpre
 void LottieExpressions::buildComp(jerry_value_t context, float frameNo, LottieRootLayer* comp, LottieExpression* exp)
 {
     //layer(index) / layer(name) / layer(otherLayer, reIndex)
-    auto layer = jerry_function_external(_layer);
-    jerry_object_set_sz(context, "layer", layer);
+    if (!_updateContent(context, "layer", exp, frameNo, comp)) {
+        auto layer = jerry_function_external(_layer);
+        jerry_object_set_sz(context, "layer", layer);
 
-    jerry_object_set_native_ptr(layer, &freeCb, _expcontent(exp, frameNo, comp));
-    jerry_value_free(layer);
+        jerry_object_set_native_ptr(layer, &freeCb, _expcontent(exp, frameNo, comp));
+        jerry_value_free(layer);
+    }
 
     auto numLayers = jerry_number((float)comp->children.count);
     jerry_object_set_sz(context, "numLayers", numLayers);
@@ -1446,6 +1548,10 @@ void LottieExpressions::buildComp(Context& context, LottieComposition* comp, flo
 {
     buildComp(context.comp, frameNo, comp->root, exp);
 
+    //the static values are built once per an update pass
+    if (context.composition == comp) return;
+    context.composition = comp;
+
     //marker
     //marker.key(index)
     //marker.key(name)
@@ -1513,12 +1619,43 @@ jerry_value_t LottieExpressions::buildGlobal(Context& context)
     return context.global;
 }
 
-jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
+LottieExpressions::Script* LottieExpressions::compile(Context& context, LottieExpression* exp)
 {
-    if (exp->disabled) return jerry_undefined();
+    if (auto script = context.scripts.find(exp->id)) return script;
+
+    if (context.scripts.count >= EXP_SCRIPT_CACHE_MAX) release(context);
+
+    //parse once, the byte code is reused over the frames
+    auto code = jerry_parse((jerry_char_t *) exp->code, strlen(exp->code), JERRY_PARSE_NO_OPTS);
+    auto& script = context.scripts[exp->id];
 
+    //keep the failure in the context, the model could be shared over the threads
+    if (jerry_value_is_exception(code)) {
+        TVGERR("LOTTIE", "Failed to dispatch the expressions!");
+        jerry_value_free(code);
+        script.code = jerry_undefined();
+        script.disabled = true;
+        return &script;
+    }
+
+    script.code = code;
+    script.constant = _constant(exp->code);
+    return &script;
+}
+
+
+jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
+{
     auto& context = this->context();
 
+    auto script = compile(context, exp);
+    if (script->disabled) return jerry_undefined();
+
+    //reuse the result of the same frame in this pass, or the constant one
+    if (script->memoized && (script->constant || (script->pass == context.pass && script->frameNo == frameNo))) {
+        return jerry_value_copy(script->result);
+    }
+
     buildGlobal(context, frameNo, exp);
 
     //main composition
@@ -1530,9 +1667,14 @@ jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
     //update global context values
     _buildProperty(frameNo, context.global, exp);
 
-    //this layer
-    jerry_object_set_native_ptr(context.thisLayer, nullptr, exp->layer);
-    _buildLayer(context.thisLayer, frameNo, exp->layer, exp->comp->root, exp);
+    //this layer, the static values are built once per an update pass
+    if (context.layer != exp->layer) {
+        jerry_object_set_native_ptr(context.thisLayer, nullptr, exp->layer);
+        _buildLayer(context.thisLayer, frameNo, exp->layer, exp->comp->root, exp);
+        context.layer = exp->layer;
+    } else {
+        _updateLayer(context.thisLayer, frameNo, exp->layer, exp);
+    }
 
     //this property
     jerry_object_set_native_ptr(context.thisProperty, nullptr, exp->property);
@@ -1542,18 +1684,26 @@ jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
     if (exp->object->type == LottieObject::Transform) _buildTransform(context.global, frameNo, static_cast<LottieTransform*>(exp->object));
 
     //evaluate the code
-    auto eval = jerry_eval((jerry_char_t *) exp->code, strlen(exp->code), JERRY_PARSE_NO_OPTS);
+    auto eval = jerry_run(script->code);
 
     if (jerry_value_is_exception(eval)) {
         TVGERR("LOTTIE", "Failed to dispatch the expressions!");
         jerry_value_free(eval);
-        exp->disabled = true;
+        script->disabled = true;
         return jerry_undefined();
     }
 
     jerry_value_free(eval);
 
-    return jerry_object_get_sz(context.global, "$bm_rt");
+    auto ret = jerry_object_get_sz(context.global, "$bm_rt");
+
+    if (script->memoized) jerry_value_free(script->result);
+    script->result = jerry_value_copy(ret);
+    script->frameNo = frameNo;
+    script->pass = context.pass;
+    script->memoized = true;
+
+    return ret;
 }
 
 
@@ -1564,7 +1714,10 @@ jerry_value_t LottieExpressions::evaluate(float frameNo, LottieExpression* exp)
 LottieExpressions* LottieExpressions::instance()
 {
     ScopedLock lock(_lockKey);
-    if (!_exps) _exps = new LottieExpressions;
+    if (!_exps) {
+        _exps = new LottieExpressions;
+        _exps->gen = ++_gen;
+    }
     ++_refCnt;
     return _exps;
 }
@@ -1585,17 +1738,26 @@ void LottieExpressions::retrieve(LottieExpressions* instance)
 LottieExpressions::Context& LottieExpressions::context()
 {
 #ifdef THORVG_THREAD_SUPPORT
-    auto tid = this_thread::get_id();
+    //the context of this thread, the lock is taken only at the first access of the thread
+    static thread_local Context* cached = nullptr;
+    static thread_local uint32_t cachedGen = 0;
+    if (cachedGen == gen) return *cached;
+
     ScopedLock lock(_lockKey);
 
-    for (auto context : contexts) {
-        if (context->tid == tid) return *context;
+    Context* context;
+    if (idle.empty()) {
+        context = new Context;
+        init(*context);
+    } else {
+        context = idle.last();
+        idle.pop();
+        jerry_port_context_set(context->ctx);
     }
-
-    auto context = new Context;
-    context->tid = tid;
-    init(*context);
     contexts.push(context);
+
+    cached = context;
+    cachedGen = gen;
     return *context;
 #else
     if (contexts.empty()) {
@@ -1608,6 +1770,29 @@ LottieExpressions::Context& LottieExpressions::context()
 }
 
 
+//builds the contexts ahead of the first frames, one per a worker thread and the main thread
+void LottieExpressions::prepare()
+{
+#ifdef THORVG_THREAD_SUPPORT
+    ScopedLock lock(_lockKey);
+
+    auto cnt = TaskScheduler::threads() + 1;
+    if (contexts.count + idle.count >= cnt) return;
+
+    //jerry_init() switches the context of this thread
+    auto cur = jerry_port_context_get();
+    while (contexts.count + idle.count < cnt) {
+        auto context = new Context;
+        init(*context);
+        idle.push(context);
+    }
+    jerry_port_context_set(cur);
+#else
+    context();
+#endif
+}
+
+
 void LottieExpressions::init(Context& context)
 {
     jerry_init(JERRY_INIT_EMPTY);
@@ -1619,11 +1804,22 @@ void LottieExpressions::init(Context& context)
 }
 
 
+void LottieExpressions::release(Context& context)
+{
+    context.scripts.foreach([](const uint32_t&, Script& script) {
+        jerry_value_free(script.code);
+        if (script.memoized) jerry_value_free(script.result);
+    });
+    context.scripts.clear();
+}
+
+
 void LottieExpressions::clear(Context& context)
 {
 #ifdef THORVG_THREAD_SUPPORT
     jerry_port_context_set(context.ctx);
 #endif
+    release(context);
     jerry_value_free(context.thisProperty);
     jerry_value_free(context.thisLayer);
     jerry_value_free(context.thisComp);
@@ -1640,6 +1836,12 @@ LottieExpressions::~LottieExpressions()
         delete(context);
     }
     contexts.clear();
+
+    for (auto context : idle) {
+        clear(*context);
+        delete(context);
+    }
+    idle.clear();
 }
 
 
@@ -1656,9 +1858,15 @@ LottieExpressions::LottieExpressions()
 }
 
 
-void LottieExpressions::update(float curTime)
+void LottieExpressions::update(float curTime, const LottieLayerCache* caches)
 {
     auto& context = this->context();
+    _caches = caches;
+
+    //a new pass, the composition could be changed since the last one
+    ++context.pass;
+    context.composition = nullptr;
+    context.layer = nullptr;
 
     //time, #current time in seconds
     auto time = jerry_number(curTime);
@@ -23,18 +23,17 @@
 #ifndef _TVG_LOTTIE_EXPRESSIONS_H_
 #define _TVG_LOTTIE_EXPRESSIONS_H_
 
-#ifdef THORVG_THREAD_SUPPORT
-    #include <thread>
-#endif
-
 #include "tvgArray.h"
+#include "tvgMap.h"
 #include "tvgCommon.h"
 #include "tvgLottieCommon.h"
 
 struct LottieExpression;
 struct LottieComposition;
+struct LottieLayer;
 struct LottieRootLayer;
 struct LottieModifier;
+struct LottieLayerCache;
 
 #ifdef THORVG_LOTTIE_EXPRESSIONS_SUPPORT
 
@@ -45,6 +44,8 @@ struct LottieExpressions
     static LottieExpressions* instance();
     static void retrieve(LottieExpressions* instance);
 
+    void prepare();
+
     template<typename Property, typename NumType>
     bool result(float frameNo, NumType& out, LottieExpression* exp)
     {
@@ -152,12 +153,24 @@ struct LottieExpressions
         return true;
     }
 
-    void update(float curTime);
+    void update(float curTime, const LottieLayerCache* caches);
 
 private:
     LottieExpressions();
     ~LottieExpressions();
 
+    //an expression code parsed once per context, and its last result
+    struct Script
+    {
+        jerry_value_t code;
+        jerry_value_t result;
+        float frameNo;
+        uint32_t pass;
+        bool memoized = false;
+        bool constant = false;      //no time dependency, the result is valid over the frames
+        bool disabled = false;      //failed to compile or evaluate, it's skipped over the frames
+    };
+
     struct Context
     {
         //global objects, attributes, and methods per local thread instance
@@ -166,16 +179,22 @@ private:
         jerry_value_t thisComp;
         jerry_value_t thisLayer;
         jerry_value_t thisProperty;
+        Map<uint32_t, Script> scripts;          //by the expression id
+        uint32_t pass = 0;                      //update count, the memoized results are valid within a pass
+        //the composition and layer whose static values were built in the current pass
+        LottieComposition* composition = nullptr;
+        LottieLayer* layer = nullptr;
 #ifdef THORVG_THREAD_SUPPORT
         jerry_context_t* ctx;
-        thread::id tid;
 #endif
     };
 
     Context& context();
     void init(Context& context);
     void clear(Context& context);
+    void release(Context& context);
 
+    Script* compile(Context& context, LottieExpression* exp);
     jerry_value_t evaluate(float frameNo, LottieExpression* exp);
     jerry_value_t buildGlobal(Context& context);
 
@@ -188,6 +207,8 @@ private:
     float toFloat(jerry_value_t obj);
 
     Array<Context*> contexts;
+    Array<Context*> idle;       //prepared contexts, not taken by any thread yet
+    uint32_t gen;               //instance generation, it validates the per-thread context references
 };
 
 #else
@@ -196,6 +217,7 @@ struct LottieExpressions
 {
     static LottieExpressions* instance() { return nullptr; }
     static void retrieve(TVG_UNUSED LottieExpressions*) {}
+    void prepare() {}
 
     template<typename Property, typename NumType> bool result(TVG_UNUSED float, TVG_UNUSED NumType&, TVG_UNUSED LottieExpression*) { return false; }
     template<typename Property> bool result(TVG_UNUSED float, TVG_UNUSED Point&, LottieExpression*) { return false; }
@@ -203,7 +225,7 @@ struct LottieExpressions
     template<typename Property> bool result(TVG_UNUSED float, TVG_UNUSED Fill*, TVG_UNUSED LottieExpression*) { return false; }
     template<typename Property> bool result(TVG_UNUSED float, TVG_UNUSED RenderPath&, TVG_UNUSED Matrix*, TVG_UNUSED LottieModifier*, TVG_UNUSED LottieExpression*) { return false; }
     bool result(TVG_UNUSED float, TVG_UNUSED TextDocument& doc, TVG_UNUSED LottieExpression*) { return false; }
-    void update(TVG_UNUSED float) {}
+    void update(TVG_UNUSED float, TVG_UNUSED const LottieLayerCache*) {}
 };
 
 #endif //THORVG_LOTTIE_EXPRESSIONS_SUPPORT
@@ -120,6 +120,18 @@ float LottieInterpolator::NewtonRaphsonIterate(float aX, float aGuessT)
 float LottieInterpolator::progress(float t)
 {
     if (outTangent.x == outTangent.y && inTangent.x == inTangent.y) return t;
+
+    //approximates with the precomputed easings if the instance prefers, no curve solving.
+    if (easings && t >= 0.0f && t <= 1.0f) {
+        auto state = LottieFrameState::current();
+        if (state && state->dense) {
+            auto x = t * float(EASING_TABLE_SIZE - 1);
+            auto i = int(x);
+            if (i >= EASING_TABLE_SIZE - 1) return easings[EASING_TABLE_SIZE - 1];
+            return tvg::lerp(easings[i], easings[i + 1], x - float(i));
+        }
+    }
+
     return _calcBezier(getTForX(t), outTangent.y, inTangent.y);
 }
 
@@ -129,6 +141,7 @@ void LottieInterpolator::set(const char* key, Point& inTangent, Point& outTangen
     this->key = duplicate(key);
     this->inTangent = inTangent;
     this->outTangent = outTangent;
+    this->easings = nullptr;
 
     if (outTangent.x == outTangent.y && inTangent.x == inTangent.y) return;
 
@@ -136,4 +149,16 @@ void LottieInterpolator::set(const char* key, Point& inTangent, Point& outTangen
     for (int i = 0; i < SPLINE_TABLE_SIZE; ++i) {
         samples[i] = _calcBezier(float(i) * SAMPLE_STEP_SIZE, outTangent.x, inTangent.x);
     }
-}
\ No newline at end of file
+}
+
+void LottieInterpolator::dense()
+{
+    if (easings || (outTangent.x == outTangent.y && inTangent.x == inTangent.y)) return;
+
+    //sample the exact curve once, lookups are linearly interpolated in between.
+    auto table = tvg::malloc<float>(sizeof(float) * EASING_TABLE_SIZE, AllocTag::Cache);
+    for (int i = 0; i < EASING_TABLE_SIZE; ++i) {
+        table[i] = progress(float(i) / float(EASING_TABLE_SIZE - 1));
+    }
+    easings = table;
+}
@@ -24,14 +24,32 @@
 #define _TVG_LOTTIE_INTERPOLATOR_H_
 
 #define SPLINE_TABLE_SIZE 11
+#define EASING_TABLE_SIZE 257
+
+//the keyframe states of the instance which updates the frame on the current thread, the model could be shared over the instances.
+struct LottieFrameState
+{
+    uint32_t* cursors = nullptr;  //the last visited keyframe segments by LottieProperty::seq
+    uint32_t cursorCnt = 0;
+    bool dense = false;           //approximate the easings with the dense tables
+
+    static LottieFrameState*& current()
+    {
+        static thread_local LottieFrameState* state = nullptr;
+        return state;
+    }
+};
+
 
 struct LottieInterpolator
 {
     char* key;
     Point outTangent, inTangent;
+    float* easings;     //dense easing table, see dense()
 
     float progress(float t);
     void set(const char* key, Point& inTangent, Point& outTangent);
+    void dense();
 
 private:
     static constexpr float SAMPLE_STEP_SIZE = 1.0f / float(SPLINE_TABLE_SIZE - 1);
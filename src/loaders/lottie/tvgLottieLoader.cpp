@@ -31,6 +31,18 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+static Inlist<LottieSharedComposition> _shareds;
+static Key _sharedKey;
+
+
+LottieSharedComposition::~LottieSharedComposition()
+{
+    delete(comp);
+    tvg::free(content);
+    tvg::free(dirName);
+}
+
+
 LottieCustomSlot::~LottieCustomSlot()
 {
     ARRAY_FOREACH(p, props) {
@@ -39,31 +51,163 @@ LottieCustomSlot::~LottieCustomSlot()
 }
 
 
+void LottieLoader::slot(LottieParser& parser)
+{
+    if (!parser.slots) return;
+
+    auto slotcode = gen(parser.slots, true);
+    apply(slotcode, true);
+    del(slotcode, true);
+    parser.slots = nullptr;
+}
+
+
+bool LottieLoader::acquire(unsigned long hash)
+{
+    ScopedLock lock(_sharedKey);
+
+    INLIST_FOREACH(_shareds, p) {
+        //the hash only filters, the same content is shared
+        if (p->hash != hash || p->size != size || strcmp(p->dirName, dirName) || memcmp(p->content, content, size)) continue;
+        ++p->refCnt;
+        shared = p;
+        builder->shared = true;
+        ScopedLock lock2(key);
+        comp = p->comp;
+        return true;
+    }
+    return false;
+}
+
+
+void LottieLoader::share(char* content, unsigned long hash)
+{
+    auto p = new LottieSharedComposition;
+    p->comp = comp;
+    p->content = content;
+    p->dirName = duplicate(dirName);
+    p->size = size;
+    p->hash = hash;
+
+    ScopedLock lock(_sharedKey);
+    _shareds.back(p);
+    shared = p;
+}
+
+
+void LottieLoader::unshare()
+{
+    builder->release(comp);
+
+    ScopedLock lock(_sharedKey);
+    if (--shared->refCnt == 0) {
+        _shareds.remove(shared);
+        delete(shared);
+    }
+    shared = nullptr;
+    builder->shared = false;
+}
+
+
+//copy-on-write, the instance requires its own model to override the properties.
+bool LottieLoader::detach()
+{
+    if (!shared) return true;
+
+    done();
+
+    //the last instance takes over the model
+    {
+        ScopedLock lock(_sharedKey);
+        if (shared->refCnt == 1) {
+            _shareds.remove(shared);
+            shared->comp = nullptr;
+            delete(shared);
+            shared = nullptr;
+            builder->shared = false;
+            return true;
+        }
+    }
+
+    //the original data is consumed by the in-situ parsing.
+    auto temp = tvg::malloc<char>(shared->size + 1);
+    memcpy(temp, shared->content, shared->size + 1);
+
+    LottieParser parser(temp, dirName, builder->expressions());
+    auto ret = parser.parse() && parser.comp;
+    tvg::free(temp);
+
+    if (!ret) {
+        delete(parser.comp);
+        return false;
+    }
+
+    unshare();
+    {
+        ScopedLock lock(key);
+        comp = parser.comp;
+    }
+    slot(parser);
+    builder->build(comp);
+    build = true;
+    return true;
+}
+
+
 bool LottieLoader::prepare()
 {
+    //the model could be shared if the assets are resolved in the same way.
+    auto shareable = !builder->resolver;
+    auto hash = 0UL;
+    char* origin = nullptr;
+
+    if (shareable) {
+        hash = djb2Encode(content, size);
+        if (acquire(hash)) {
+            builder->build(comp);
+            release();
+            return true;
+        }
+        //the original data is consumed by the in-situ parsing, keep it to compare with the next instances.
+        origin = tvg::malloc<char>(size + 1, AllocTag::Cache);
+        memcpy(origin, content, size);
+        origin[size] = '\0';
+    }
+
     LottieParser parser(content, dirName, builder->expressions());
-    if (!parser.parse()) return false;
+    if (!parser.parse()) {
+        tvg::free(origin);
+        return false;
+    }
     {
         ScopedLock lock(key);
         comp = parser.comp;
     }
-    if (!comp) return false;
-    if (parser.slots) {
-        auto slotcode = gen(parser.slots, true);
-        apply(slotcode, true);
-        del(slotcode, true);
-        parser.slots = nullptr;
+    if (!comp) {
+        tvg::free(origin);
+        return false;
     }
+    slot(parser);
     builder->build(comp);
+
+    if (shareable && comp->shareable) share(origin, hash);
+    else tvg::free(origin);
+
     release();
     return true;
 }
 
 
+void LottieLoader::update(float frameNo)
+{
+    builder->update(comp, frameNo);
+}
+
+
 void LottieLoader::run(unsigned tid)
 {
-    if (comp) builder->update(comp, frameNo);      //update frame
-    else if (prepare()) builder->update(comp, 0);  //initial loading
+    if (comp) update(frameNo);      //update frame
+    else if (prepare()) update(0);  //initial loading
     build = false;
 }
 
@@ -95,7 +239,8 @@ LottieLoader::~LottieLoader()
     release();
 
     //TODO: correct position?
-    delete(comp);
+    if (shared) unshare();
+    else delete(comp);
     delete(builder);
 
     tvg::free(dirName);
@@ -213,7 +358,7 @@ bool LottieLoader::open(const char* data, uint32_t size, const LoaderOps& _ops)
     if (ops->caller != tvg::Type::Picture) return false;
 
     if (ops->owner == Ownership::Copy) {
-        content = tvg::malloc<char>(size + 1);
+        content = tvg::malloc<char>(size + 1, AllocTag::Loader);
         memcpy((char*)content, data, size);
         const_cast<char*>(content)[size] = '\0';
     } else content = data;
@@ -277,8 +422,8 @@ Paint* LottieLoader::paint()
     sync();
 
     if (!comp) return nullptr;
-    comp->initiated = true;
-    return comp->root->scene;
+    builder->initiated = true;
+    return builder->scene;
 }
 
 
@@ -286,7 +431,7 @@ bool LottieLoader::apply(uint32_t slotcode, bool byDefault)
 {
     if (curSlot == slotcode) return true;
 
-    if (!ready() || comp->slots.count == 0) return false;
+    if (!ready() || comp->slots.count == 0 || !detach()) return false;
 
     auto applied = false;
 
@@ -314,7 +459,7 @@ bool LottieLoader::apply(uint32_t slotcode, bool byDefault)
 
 bool LottieLoader::del(uint32_t slotcode, bool byDefault)
 {
-    if (comp->slots.empty() || slotcode == 0 || !ready()) return false;
+    if (comp->slots.empty() || slotcode == 0 || !ready() || !detach()) return false;
 
     // Search matching value and remove
     INLIST_SAFE_FOREACH(this->slots, slot) {
@@ -336,7 +481,7 @@ bool LottieLoader::del(uint32_t slotcode, bool byDefault)
 
 uint32_t LottieLoader::gen(const char* slots, bool byDefault)
 {
-    if (!slots || !ready() || comp->slots.empty()) return 0;
+    if (!slots || !ready() || comp->slots.empty() || !detach()) return 0;
 
     //parsing slot json
     auto temp = byDefault ? slots : duplicate(slots);
@@ -394,7 +539,7 @@ bool LottieLoader::frame(float no)
 
     builder->tween.off();
 
-    if (comp) comp->clear();     //clear synchronously
+    builder->clear();     //clear synchronously
 
     TaskScheduler::request(this);
 
@@ -430,9 +575,10 @@ bool LottieLoader::sync()
     done();
 
     if (build) {
-        if (comp) comp->clear();
+        builder->clear(true);
         run(0);
     }
+    builder->sweep();
     return true;
 }
 
@@ -511,7 +657,7 @@ bool LottieLoader::tween(float progress)
 
     if (tvg::equal(progress, 1.0f)) frameNo = builder->tween.to;
     builder->tween.progress = progress;
-    if (comp) comp->clear();  // clear synchronously
+    builder->clear();  // clear synchronously
 
     TaskScheduler::request(this);
 
@@ -531,7 +677,7 @@ bool LottieLoader::tween(float from, float to, float progress)
     progress = shorten(progress);
     frameNo = shorten(from);
     builder->tween.on(shorten(to), progress);
-    if (comp) comp->clear();     //clear synchronously
+    builder->clear();     //clear synchronously
 
     TaskScheduler::request(this);
 
@@ -541,8 +687,8 @@ bool LottieLoader::tween(float from, float to, float progress)
 bool LottieLoader::quality(uint8_t value)
 {
     if (!ready()) return false;
-    if (comp->quality != value) {
-        comp->quality = value;
+    if (builder->quality != value) {
+        builder->quality = value;
         build = true;
     }
     return true;
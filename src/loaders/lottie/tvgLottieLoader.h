@@ -33,6 +33,7 @@ struct LottieComposition;
 struct LottieBuilder;
 struct LottieProperty;
 struct LottieSlot;
+struct LottieParser;
 
 
 struct LottieCustomSlot
@@ -51,6 +52,21 @@ struct LottieCustomSlot
     ~LottieCustomSlot();
 };
 
+//The parsed model of the same content is shared among the instances.
+struct LottieSharedComposition
+{
+    INLIST_ITEM(LottieSharedComposition);
+
+    LottieComposition* comp;
+    char* content;          //the original data to identify the instances and to build their own models
+    char* dirName;
+    uint32_t size;
+    unsigned long hash;
+    uint32_t refCnt = 1;
+
+    ~LottieSharedComposition();
+};
+
 struct LottieLoader : AnimLoader, Task
 {
     const char* content = nullptr;      //lottie file data
@@ -61,6 +77,7 @@ struct LottieLoader : AnimLoader, Task
 
     LottieBuilder* builder;
     LottieComposition* comp = nullptr;
+    LottieSharedComposition* shared = nullptr;  //valid if the comp is shared with the other instances
     Inlist<LottieCustomSlot> slots;     //user custom slot list
     uint32_t curSlot = 0;               //current applied slotcode
 
@@ -110,6 +127,12 @@ private:
     void run(unsigned tid) override;
     void release();
     bool prepare();
+    void update(float frameNo);
+    void slot(LottieParser& parser);
+    bool acquire(unsigned long hash);
+    void share(char* content, unsigned long hash);
+    void unshare();
+    bool detach();
 };
 
 #endif //_TVG_LOTTIELOADER_H_
@@ -22,15 +22,16 @@
 
 #include "tvgMath.h"
 #include "tvgTaskScheduler.h"
+#include "tvgLock.h"
 #include "tvgLottieModel.h"
 #include "tvgCompressor.h"
 
 
 /************************************************************************/
-/* LottieTextFollowPath                                                 */
+/* LottieTextFollower                                                   */
 /************************************************************************/
 
-Point LottieTextFollowPath::split(float dLen, float lenSearched, float& angle)
+Point LottieTextFollower::split(float dLen, float lenSearched, float& angle)
 {
     switch (*cmds) {
         case PathCommand::MoveTo: {
@@ -57,7 +58,7 @@ Point LottieTextFollowPath::split(float dLen, float lenSearched, float& angle)
     return {};
 }
 
-void LottieTextFollowPath::rewind()
+void LottieTextFollower::rewind()
 {
     pts = path.pts.data;
     cmds = path.cmds.data;
@@ -65,9 +66,8 @@ void LottieTextFollowPath::rewind()
     currentLen = 0.0f;
 }
 
-float LottieTextFollowPath::prepare(LottieMask* mask, float frameNo, float scale, LottieTween& tween, LottieExpressions* exps)
+float LottieTextFollower::prepare(LottieTextFollowPath* follow, LottieMask* mask, float frameNo, float scale, LottieTween& tween, LottieExpressions* exps)
 {
-    this->mask = mask;
     Matrix m{1.0f / scale, 0.0f, 0.0f, 0.0f, 1.0f / scale, 0.0f, 0.0f, 0.0f, 1.0f};
     path.clear();
     mask->pathset(frameNo, path, &m, tween, exps);
@@ -76,10 +76,10 @@ float LottieTextFollowPath::prepare(LottieMask* mask, float frameNo, float scale
     totalLen = tvg::length(cmds, cmdsCnt, pts, path.pts.count);
     start = pts;
 
-    return firstMargin(frameNo, tween, exps) / scale;
+    return follow->firstMargin(frameNo, tween, exps) / scale;
 }
 
-Point LottieTextFollowPath::position(float lenSearched, float& angle)
+Point LottieTextFollower::position(float lenSearched, float& angle)
 {
     //position before the start of the curve
     if (lenSearched <= 0.0f) {
@@ -282,8 +282,10 @@ float LottieTextRange::factor(float frameNo, float totalLen, float idx)
         if (minEase > 0.0f) out.x = minEase * 0.01f;
         else out.y = -minEase * 0.01f;
 
-        interpolator->set(nullptr, in, out);
-        f = interpolator->progress(f);
+        //a local one, the model could be shared over the threads
+        LottieInterpolator interpolator;
+        interpolator.set(nullptr, in, out);
+        f = interpolator.progress(f);
     }
     f = tvg::clamp(f, 0.0f, 1.0f);
 
@@ -627,6 +629,10 @@ LottieLayer::LottieLayer() : LottieRootLayer(LottieObject::Layer)
 {
     autoOrient = false;
     matteSrc = false;
+    dynamic = false;
+    retainable = false;
+    reusable = false;
+    isolated = false;
 }
 
 LottieLayer::~LottieLayer()
@@ -637,6 +643,7 @@ LottieLayer::~LottieLayer()
     ARRAY_FOREACH(p, masks) delete(*p);
     ARRAY_FOREACH(p, effects) delete(*p);
 
+    if (statical) statical->unref();
     delete(transform);
     delete(audioCtrl);
     tvg::free(name);
@@ -677,7 +684,7 @@ void LottieLayer::prepare(RGB32* color)
         obj->appendRect(0.0f, 0.0f, w, h);
         obj->ref();
         if (color && type == LottieLayer::Solid) obj->fill(color->r, color->g, color->b);
-        statical.pooler.push(obj);
+        statical = obj;
     }
 
     LottieGroup::prepare();
@@ -687,16 +694,28 @@ void LottieLayer::prepare(RGB32* color)
 /* LottieComposition                                                    */
 /************************************************************************/
 
-LottieComposition::~LottieComposition()
+static Key _easeKey;
+
+//the dense easing tables are built once, the instances choose them over the curve solving by the quality.
+void LottieComposition::ease()
 {
-    if (!initiated && root) Paint::rel(root->scene);
+    if (dense) return;
+    ScopedLock lock(_easeKey);
+    if (dense) return;
+    ARRAY_FOREACH(p, interpolators) (*p)->dense();
+    dense = true;
+}
 
+
+LottieComposition::~LottieComposition()
+{
     delete (root);
     tvg::free(version);
     tvg::free(name);
 
     ARRAY_FOREACH(p, interpolators) {
         tvg::free((*p)->key);
+        tvg::free((*p)->easings);
         tvg::free(*p);
     }
 
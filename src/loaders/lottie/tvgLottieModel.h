@@ -30,7 +30,6 @@
 #include "tvgInlist.h"
 #include "tvgRender.h"
 #include "tvgLottieProperty.h"
-#include "tvgLottieRenderPooler.h"
 #include "tvgLottieTween.h"
 
 #ifdef THORVG_MEDIA_LOADER_SUPPORT
@@ -252,7 +251,7 @@ struct LottieOverride
 #define OVERRIDE(target) LottieOverride::apply(target, prop, backup, release)
 };
 
-struct LottieObject
+struct LottieObject : Allocated
 {
     enum Type : uint8_t
     {
@@ -293,6 +292,7 @@ struct LottieObject
     virtual LottieProperty* property(uint16_t ix) { return nullptr; }
 
     unsigned long id = 0;      //unique id by name generated by djb2 encoding
+    uint32_t seq = 0;          //index of the frame states in the instances, see LottieBuilder
     Type type;
     bool hidden = false;       //remove?
 };
@@ -337,11 +337,6 @@ struct LottieTextRange : LottieObject
         style.flags.strokeWidth = 0;
     }
 
-    ~LottieTextRange()
-    {
-        tvg::free(interpolator);
-    }
-
     struct {
         LottieColor fillColor = RGB32{255, 255, 255};
         LottieColor strokeColor = RGB32{255, 255, 255};
@@ -368,7 +363,6 @@ struct LottieTextRange : LottieObject
     LottieFloat smoothness = 100.0f;
     LottieFloat start = 0.0f;
     LottieFloat end = 100.0f;
-    LottieInterpolator* interpolator = nullptr;
     Based based = Chars;
     Shape shape = Square;
     Unit rangeUnit = Percent;
@@ -449,6 +443,14 @@ struct LottieMarker
 
 
 struct LottieTextFollowPath
+{
+    LottieFloat firstMargin = 0.0f;
+    int8_t maskIdx = -1;
+};
+
+
+//walks along the mask path of a frame, it's local to the update since the model could be shared.
+struct LottieTextFollower
 {
 private:
     RenderPath path;
@@ -462,16 +464,12 @@ private:
     void rewind();
 
 public:
-    LottieFloat firstMargin = 0.0f;
-    LottieMask* mask;
-    int8_t maskIdx = -1;
-
     Point position(float lenSearched, float& angle);
-    float prepare(LottieMask* mask, float frameNo, float scale, LottieTween& tween, LottieExpressions* exps);
+    float prepare(LottieTextFollowPath* follow, LottieMask* mask, float frameNo, float scale, LottieTween& tween, LottieExpressions* exps);
 };
 
 
-struct LottieText : LottieObject, LottieRenderPooler<tvg::Shape>
+struct LottieText : LottieObject
 {
     struct AlignOption
     {
@@ -537,7 +535,7 @@ struct LottieTrimpath : LottieObject
 };
 
 
-struct LottieShape : LottieObject, LottieRenderPooler<Shape>
+struct LottieShape : LottieObject
 {
     bool clockwise = true;   //clockwise or counter-clockwise
 
@@ -967,7 +965,7 @@ struct LottieZigZag : LottieObject
     LottieInteger point = 1; //1: corner, 2: smooth
 };
 
-struct LottieGroup : LottieObject, LottieRenderPooler<tvg::Shape>
+struct LottieGroup : LottieObject
 {
     LottieGroup(LottieObject::Type type = LottieObject::Group);
 
@@ -995,7 +993,6 @@ struct LottieGroup : LottieObject, LottieRenderPooler<tvg::Shape>
         return nullptr;
     }
 
-    Scene* scene = nullptr;
     Array<LottieObject*> children;
     BlendMethod blendMethod = BlendMethod::Normal;
 
@@ -1052,7 +1049,7 @@ struct LottieLayer : LottieRootLayer
     Array<LottieEffect*> effects;
     LottieLayer* matteTarget = nullptr;
 
-    LottieRenderPooler<tvg::Shape> statical;  //static pooler for solid fill and clipper
+    tvg::Shape* statical = nullptr;  //the solid fill or the clipper, the instances pool its copies
 
     struct AudioControl {
         LottieFloat volume = 100.0f;
@@ -1065,16 +1062,14 @@ struct LottieLayer : LottieRootLayer
     int16_t pix = -1;           //index of the parent layer.
     int16_t ix = -1;            //index of the current layer.
 
-    struct {
-        float frameNo = -1.0f;
-        Matrix matrix;
-        uint8_t opacity;
-    } cache;
-
     MaskMethod matteType = MaskMethod::None;
     Type type = Null;
     bool autoOrient : 1;
     bool matteSrc : 1;
+    bool dynamic : 1;     //has the keyframes, expressions or slots
+    bool retainable : 1;  //gives the same scene over the frames, the builder can keep it
+    bool reusable : 1;    //changes over the frames, the builder can keep its scene and update it in place
+    bool isolated : 1;    //shares no mutable data with the other layers, could be updated in parallel
 
     AudioControl* audio()
     {
@@ -1137,15 +1132,10 @@ struct LottieSlot
 };
 
 
-struct LottieComposition
+struct LottieComposition : Allocated
 {
     ~LottieComposition();
 
-    void clear()
-    {
-        if (root && root->scene) root->scene->remove();
-    }
-
     float duration() const
     {
         return frameCnt() / frameRate;  // in second
@@ -1177,6 +1167,8 @@ struct LottieComposition
         return nullptr;
     }
 
+    void ease();
+
     void clamp(float& frameNo)
     {
         frameNo += root->inFrame;
@@ -1194,9 +1186,12 @@ struct LottieComposition
     Array<LottieFont*> fonts;
     Array<LottieSlot*> slots;
     Array<LottieMarker*> markers;
+    uint32_t layerCnt = 0;  //the layers are sequenced ahead of the other objects, see LottieObject::seq
+    uint32_t seqCnt = 0;    //the sequenced objects including the layers
+    uint32_t cursorCnt = 0; //the animated properties, see LottieProperty::seq
     bool expressions = false;
-    bool initiated = false;
-    uint8_t quality = 50;
+    bool shareable = true;  //the model could be shared with the other instances
+    std::atomic<bool> dense{false};  //the interpolators have the dense easing tables
 };
 
 #endif //_TVG_LOTTIE_MODEL_H_
@@ -45,6 +45,7 @@ static unsigned long _int2str(int num)
 void LottieParser::getExpression(char* code, LottieComposition* comp, LottieLayer* layer, LottieObject* object, LottieProperty* property)
 {
     if (!comp->expressions) comp->expressions = true;
+    if (layer) layer->dynamic = true;
 
     auto inst = new LottieExpression;
     inst->code = code;
@@ -422,6 +423,10 @@ void LottieParser::parseKeyFrame(T& prop)
     auto& frame = prop.newFrame();
     auto interpolator = false;
 
+    if (prop.seq == 0) prop.seq = ++comp->cursorCnt;
+
+    if (context.layer) context.layer->dynamic = true;
+
     enterObject();
 
     while (auto key = nextObjectKey()) {
@@ -483,6 +488,9 @@ void LottieParser::registerSlot(LottieObject* obj, const char* sid, LottieProper
 {
     auto val = djb2Encode(sid);
 
+    //the slot could override the property at any time
+    if (context.layer) context.layer->dynamic = true;
+
     //append object if the slot already exists.
     ARRAY_FOREACH(p, comp->slots) {
         if ((*p)->sid != val) continue;
@@ -1071,10 +1079,14 @@ LottieObject* LottieParser::parseAsset()
     if (data) {
         if (!strncmp(data, "data:image/", 11) || width != 0.0f || height != 0.0f) {
             obj = new LottieImage;
+#ifdef THORVG_MEDIA_LOADER_SUPPORT
+            comp->shareable = false;  //video playback is controlled by each instance
+#endif
             parseImage(static_cast<LottieImage*>(obj), data, subPath, width, height, embedded);
             if (sid) registerSlot(static_cast<LottieImage*>(obj), sid, static_cast<LottieImage*>(obj)->asset);
         } else if (!strncmp(data, "data:audio/", 11) || !embedded) {
             obj = new LottieAudio;
+            comp->shareable = false;  //audio playback is controlled by each instance
             parseAudio(static_cast<LottieAudio*>(obj), data, subPath, embedded);
         } else TVGLOG("LOTTIE", "Unexpected data type");
     }
@@ -1094,10 +1106,10 @@ void LottieParser::parseFontData(LottieFont* font, const char* data)
     if (!strncmp(data, "data:font/", sizeof("data:font/") - 1)) {
         data += sizeof("data:font/") - 1;
         if (!strncasecmp(data, TTF, 3)) {
-            font->mime = strdup(TTF);
+            font->mime = duplicate(TTF);
             data += 3;
         } else if (!strncasecmp(data, OTF, 3)) {
-            font->mime = strdup(OTF);
+            font->mime = duplicate(OTF);
             data += 3;
         } else {
             TVGLOG("LOTTIE", "Not support the current font type!");
@@ -1266,11 +1278,7 @@ void LottieParser::parseTextRange(LottieText* text)
                 enterObject();
                 while (auto key = nextObjectKey()) {
                     if (KEY_AS("t")) selector->expressible = (bool) getInt();
-                    else if (KEY_AS("xe"))
-                    {
-                        parseProperty(selector->maxEase);
-                        selector->interpolator = tvg::malloc<LottieInterpolator>(sizeof(LottieInterpolator));
-                    }
+                    else if (KEY_AS("xe")) parseProperty(selector->maxEase);
                     else if (KEY_AS("ne")) parseProperty(selector->minEase);
                     else if (KEY_AS("a")) parseProperty(selector->maxAmount);
                     else if (KEY_AS("b")) selector->based = (LottieTextRange::Based) getInt();
@@ -24,6 +24,7 @@
 #define _TVG_LOTTIE_PROPERTY_H_
 
 #include <algorithm>
+#include <atomic>
 #include "tvgMath.h"
 #include "tvgStr.h"
 #include "tvgLottieCommon.h"
@@ -131,7 +132,7 @@ struct LottieExpression
     LottieLayer* layer;
     LottieObject* object;
     LottieProperty* property;
-    bool disabled = false;
+    uint32_t id = serial();     //never reused, it identifies the compiled code
 
     LottieExpression() {}
 
@@ -142,18 +143,23 @@ struct LottieExpression
         layer = rhs->layer;
         object = rhs->object;
         property = rhs->property;
-        disabled = rhs->disabled;
     }
 
     ~LottieExpression()
     {
         tvg::free(code);
     }
+
+    static uint32_t serial()
+    {
+        static std::atomic<uint32_t> cnt{0};
+        return ++cnt;
+    }
 };
 
 
 //Property would have an either keyframes or single value.
-struct LottieProperty
+struct LottieProperty : Allocated
 {
     enum class Type : uint8_t
     {
@@ -175,6 +181,7 @@ struct LottieProperty
     LottieExpression* exp = nullptr;
     Type type;
     uint8_t ix = 0;  //property index
+    uint32_t seq = 0;  //index + 1 of the keyframe cursor in the instances, 0 if it's not animated
     unsigned long sid = 0; //property sid for slot
 
     LottieProperty(Type type = Type::Invalid) : type(type) {}
@@ -248,6 +255,27 @@ uint32_t _bsearch(T* frames, float frameNo)
 }
 
 
+//playback is mostly sequential, look up the last visited segment and its neighbors first.
+//the cursors are kept by the instance, the keyframes could be shared over the instances. see LottieFrameState
+template<typename T>
+uint32_t _seek(T* frames, float frameNo, uint32_t seq)
+{
+    auto state = LottieFrameState::current();
+    if (!state || seq == 0 || seq > state->cursorCnt) return _bsearch(frames, frameNo);
+
+    auto& cursor = state->cursors[seq - 1];
+    auto key = cursor;
+    if (key + 1 < frames->count) {
+        auto frame = frames->data + key;
+        if (frameNo >= frame->no) {
+            if (frameNo < (frame + 1)->no) return key;
+            if (key + 2 < frames->count && frameNo < (frame + 2)->no) return (cursor = key + 1);
+        } else if (key > 0 && frameNo >= (frame - 1)->no) return (cursor = key - 1);
+    }
+    return (cursor = _bsearch(frames, frameNo));
+}
+
+
 template<typename T>
 uint32_t _nearest(T* frames, float frameNo)
 {
@@ -385,7 +413,7 @@ struct LottieGenericProperty : LottieProperty
         if (frames->count == 1 || frameNo <= frames->first().no) return frames->first().value;
         if (frameNo >= frames->last().no) return frames->last().value;
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _seek(frames, frameNo, seq);
         if (tvg::equal(frame->no, frameNo)) return frame->value;
         return frame->interpolate(frame + 1, frameNo);
     }
@@ -427,7 +455,7 @@ struct LottieGenericProperty : LottieProperty
             return frame->angle(frame + 1, frames->last().no);
         }
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _seek(frames, frameNo, seq);
         return frame->angle(frame + 1, frameNo);
     }
 
@@ -529,7 +557,7 @@ struct LottiePathSet : LottieProperty
         else if (frames->count == 1 || frameNo <= frames->first().no) path = &frames->first().value;
         else if (frameNo >= frames->last().no) path = &frames->last().value;
         else {
-            frame = frames->data + _bsearch(frames, frameNo);
+            frame = frames->data + _seek(frames, frameNo, seq);
             if (tvg::equal(frame->no, frameNo)) path = &frame->value;
             else if (frame->value.ptsCnt != (frame + 1)->value.ptsCnt) {
                 path = &frame->value;
@@ -562,27 +590,26 @@ struct LottiePathSet : LottieProperty
             return;
         }
 
-        // interpolation
+        // interpolation, into a local path since the keyframes could be shared over the threads
         auto s = frame->value.pts;
         auto e = (frame + 1)->value.pts;
-        auto backup = frame->value.pts;
-        frame->value.pts = tvg::malloc<Point>(frame->value.ptsCnt * sizeof(Point));
-        auto p = frame->value.pts;
+        auto interpolated = frame->value;
+        interpolated.pts = tvg::malloc<Point>(interpolated.ptsCnt * sizeof(Point));
+        auto p = interpolated.pts;
 
-        for (auto i = 0; i < frame->value.ptsCnt; ++i, ++s, ++e, ++p) {
+        for (auto i = 0; i < interpolated.ptsCnt; ++i, ++s, ++e, ++p) {
             *p = tvg::lerp(*s, *e, t);
             if (transform) *p *= *transform;
         }
 
         if (modifier) {
             RenderPath in;
-            frame->value.convert(in);
+            interpolated.convert(in);
             modifier->path(in, out, nullptr);
             in.dismiss();
         }
 
-        std::swap(frame->value.pts, backup);
-        tvg::free(backup);
+        tvg::free(interpolated.pts);
     }
 
     void defaultPath(float frameNo, RenderPath& out, Matrix* transform)
@@ -731,7 +758,7 @@ struct LottieColorStop : LottieProperty
 
         if (frameNo >= frames->last().no) return fill->colorStops(frames->last().value.data, count);
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _seek(frames, frameNo, seq);
         if (tvg::equal(frame->no, frameNo)) return fill->colorStops(frame->value.data, count);
 
         //interpolate
@@ -889,20 +916,10 @@ struct LottieTextDoc : LottieProperty
         if (frames->count == 1 || frameNo <= frames->first().no) return frames->first().value;
         if (frameNo >= frames->last().no) return frames->last().value;
 
-        auto frame = frames->data + _bsearch(frames, frameNo);
+        auto frame = frames->data + _seek(frames, frameNo, seq);
         return frame->value;
     }
 
-    TextDocument& operator()(float frameNo, LottieExpressions* exps)
-    {
-        auto& out = (*this)(frameNo);
-
-        //overriding with expressions
-        if (exps && exp) exps->result(frameNo, out, exp);
-
-        return out;
-    }
-
     void copy(LottieTextDoc& rhs, bool shallow = true)
     {
         if (LottieProperty::copy(&rhs, shallow)) return;
@@ -40,7 +40,8 @@ struct LottieRenderPooler
         }
     }
 
-    T* pooling(bool copy = false)
+    //the source is the original of the copies, the new one is generated if it's not given.
+    T* pooling(T* source = nullptr)
     {
         //return available one.
         ARRAY_FOREACH(p, pooler) {
@@ -48,7 +49,7 @@ struct LottieRenderPooler
         }
 
         //no empty, generate a new one.
-        auto p = copy ? static_cast<T*>(pooler[0]->duplicate()) : T::gen();
+        auto p = source ? static_cast<T*>(source->duplicate()) : T::gen();
         p->ref();
         pooler.push(p);
         return p;
@@ -60,22 +60,17 @@ private:
     void release()
     {
         // delete the fill values
-        for (size_t i = 0; i < data.size; ++i) {
-            INLIST_FOREACH(data.buckets[i], item) {
-                auto& value = item->val;
-                if (value.type == 0) {
-                    continue;
-                } else if (value.type == 1) {  // path
-                    free(value.from.vPath.pts);
-                    free(value.from.vPath.cmds);
-                    free(value.cur.vPath.pts);
-                    free(value.cur.vPath.cmds);
-                } else {  // fill
-                    delete (value.from.vFill);
-                    delete (value.cur.vFill);
-                }
+        data.foreach([](size_t, ValueSet& value) {
+            if (value.type == 1) {  // path
+                tvg::free(value.from.vPath.pts);
+                tvg::free(value.from.vPath.cmds);
+                tvg::free(value.cur.vPath.pts);
+                tvg::free(value.cur.vPath.cmds);
+            } else if (value.type == 2) {  // fill
+                delete (value.from.vFill);
+                delete (value.cur.vFill);
             }
-        }
+        });
         data.clear();
     }
 
@@ -114,7 +109,7 @@ private:
     {
         auto set = data.find(key);
         if (!set) return false;
-        std::swap(set->val.from, set->val.cur);  // FIXME: copy data
+        std::swap(set->from, set->cur);  // FIXME: copy data
         return true;
     }
 
@@ -137,11 +132,7 @@ public:
         legacy = false;
 
         // initialize the data
-        for (size_t i = 0; i < data.size; ++i) {
-            INLIST_FOREACH(data.buckets[i], item) {
-                item->val.inited = false;
-            }
-        }
+        data.foreach([](size_t, ValueSet& value) { value.inited = false; });
     }
 
     // legacy
@@ -166,8 +157,8 @@ public:
 
         auto set = data.find(key);
         if (!set) return false;
-        auto ret = set->val.inited;
-        set->val.inited = true;
+        auto ret = set->inited;
+        set->inited = true;
         return ret;
     }
 
@@ -2538,7 +2538,7 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h, LodePNG
 
     if (!state->error) {
         outsize = lodepng_get_raw_size(*w, *h, &state->info_png.color);
-        *out = tvg::malloc<unsigned char>(outsize);
+        *out = tvg::malloc<unsigned char>(outsize, AllocTag::Loader);
         if (!*out) state->error = 83; /*alloc fail*/
     }
     if (!state->error) {
@@ -2653,7 +2653,7 @@ unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h, LodePNGSt
         }
 
         outsize = lodepng_get_raw_size(*w, *h, &state->info_raw);
-        *out = tvg::malloc<unsigned char>(outsize);
+        *out = tvg::malloc<unsigned char>(outsize, AllocTag::Loader);
         if (!(*out)) {
             state->error = 83; /*alloc fail*/
         }
@@ -56,7 +56,7 @@ PngLoader::PngLoader() : BitmapLoader(FileType::Png)
 PngLoader::~PngLoader()
 {
     done();
-    if (owner != Ownership::Borrow) tvg::free(data);
+    if (owner != Ownership::Borrow) unmap((char*)data, size);
     tvg::free(surface.buf8);
     lodepng_state_cleanup(&state);
 }
@@ -64,7 +64,7 @@ PngLoader::~PngLoader()
 bool PngLoader::open(const char* path, const LoaderOps& ops)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
-    if (!(data = (unsigned char*)Loader::open(path, size))) return false;
+    if (!(data = (unsigned char*)map(path, size))) return false;
     owner = Ownership::Transfer;
 
     lodepng_state_init(&state);
@@ -85,7 +85,7 @@ bool PngLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
     if (lodepng_inspect(&width, &height, &state, (unsigned char*)(data), size) > 0) return false;
 
     if (ops.owner == Ownership::Copy) {
-        this->data = tvg::malloc<unsigned char>(size);
+        this->data = tvg::malloc<unsigned char>(size, AllocTag::Loader);
         memcpy((unsigned char *)this->data, data, size);
     } else {
         this->data = (unsigned char *) data;
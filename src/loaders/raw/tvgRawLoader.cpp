@@ -39,7 +39,7 @@ bool RawLoader::open(const uint32_t* data, uint32_t w, uint32_t h, ColorSpace cs
     this->owner = owner;
 
     if (owner == Ownership::Copy) {
-        surface.buf32 = tvg::malloc<uint32_t>(sizeof(uint32_t) * w * h);
+        surface.buf32 = tvg::malloc<uint32_t>(sizeof(uint32_t) * w * h, AllocTag::Loader);
         memcpy((void*)surface.buf32, data, sizeof(uint32_t) * w * h);
     } else {
         surface.buf32 = const_cast<uint32_t*>(data);
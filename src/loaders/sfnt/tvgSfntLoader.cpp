@@ -140,7 +140,7 @@ static uint8_t* _map(SfntLoader* loader, const char* path, uint32_t& size)
         return nullptr;
     }
 
-    auto data = tvg::malloc<uint8_t>(size);
+    auto data = tvg::malloc<uint8_t>(size, AllocTag::Loader);
 
     fseek(f, 0, SEEK_SET);
     auto ret = fread(data, sizeof(char), size, f);
@@ -188,8 +188,16 @@ static size_t _codepoints(const char** utf8, const char* end)
     return 0;
 }
 
-static void _build(const RenderPath& in, const Point& cursor, const Point& offset, RenderPath& out)
+void SfntLoader::build(const SfntGlyphMetrics* glyph, const Point& cursor, const Point& offset, RenderPath& out)
 {
+    auto& in = glyph->path;
+
+    //the glyph origins are resolved from their first points after the alignments
+    if (run && in.pts.count > 0) {
+        run->glyphs.push({&in, {}, glyph->idx});
+        heads.push(out.pts.count);
+    }
+
     out.cmds.push(in.cmds);
     out.pts.grow(in.pts.count);
     ARRAY_FOREACH(p, in.pts) {
@@ -264,8 +272,7 @@ SfntGlyphMetrics* SfntLoader::request(uint32_t code)
 {
     if (code == 0) return nullptr;
 
-    auto it = glyphs.find(code);
-    if (it) return &it->val;
+    if (auto it = glyphs.find(code)) return it;
     auto& rtgm = glyphs[code];
     if (reader->convert(rtgm, code, rtgm.path)) return &rtgm;
 
@@ -291,7 +298,7 @@ void SfntLoader::wrapNone(FontMetrics& fm, const Point& box, const char* utf8, c
         Point offset{};
         if (ltgm) reader->positioning(ltgm->idx, rtgm->idx, offset);
 
-        _build(rtgm->path, cursor, offset, out);
+        build(rtgm, cursor, offset, out);
         cursor.x += (rtgm->advance + offset.x) * fm.spacing.x;
 
         if (cursor.x > fm.size.x) fm.size.x = cursor.x;  //text horizontal size
@@ -330,11 +337,11 @@ void SfntLoader::wrapChar(FontMetrics& fm, const Point& box, const char* utf8, c
             if (cursor.x + xadv > box.x) {
                 line = feedLine(fm, box.x, cursor.x, line, out.pts.count, cursor, out);
             }
-            _build(rtgm->path, cursor, offset, out);
+            build(rtgm, cursor, offset, out);
             cursor.x += xadv;
         //not enough layout space, force pushing
         } else {
-            _build(rtgm->path, cursor, offset, out);
+            build(rtgm, cursor, offset, out);
             line = feedLine(fm, box.x, cursor.x, line, out.pts.count, cursor, out);
         }
 
@@ -392,7 +399,7 @@ void SfntLoader::wrapWord(FontMetrics& fm, const Point& box, const char* utf8, c
                 line = feedLine(fm, box.x, cursor.x, line, out.pts.count, cursor, out);
             }
         }
-        _build(rtgm->path, cursor, offset, out);
+        build(rtgm, cursor, offset, out);
         cursor.x += xadv;
 
         //capture the word start
@@ -441,7 +448,7 @@ void SfntLoader::wrapEllipsis(FontMetrics& fm, const Point& box, const char* utf
         //normal case
         if (cursor.x + xadv < box.x) {
             capture = {out.pts.count, out.cmds.count, xadv};
-            _build(rtgm->path, cursor, offset, out);
+            build(rtgm, cursor, offset, out);
             cursor.x += xadv;
         //ellipsis
         } else {
@@ -457,11 +464,17 @@ void SfntLoader::wrapEllipsis(FontMetrics& fm, const Point& box, const char* utf
                 out.pts.count = capture.pts;
                 out.cmds.count = capture.cmds;
                 cursor.x -= capture.xadv;
+                if (run) {
+                    while (heads.count > 0 && heads.last() >= capture.pts) {
+                        heads.pop();
+                        run->glyphs.pop();
+                    }
+                }
             }
             //append ...
             auto tmp = (rtgm->advance + offset.x) * fm.spacing.x;
             for (int i = 0; i < 3; ++i) {
-                _build(rtgm->path, cursor, offset, out);
+                build(rtgm, cursor, offset, out);
                 cursor.x += tmp;
             }
             stop = true;
@@ -546,7 +559,7 @@ bool SfntLoader::open(const char* data, uint32_t size, TVG_UNUSED const LoaderOp
     nomap = true;
 
     if (ops.owner == Ownership::Copy) {
-        reader->data = tvg::malloc<uint8_t>(size);
+        reader->data = tvg::malloc<uint8_t>(size, AllocTag::Loader);
         memcpy((char*)reader->data, data, reader->size);
     }
     owner = ops.owner;
@@ -554,9 +567,14 @@ bool SfntLoader::open(const char* data, uint32_t size, TVG_UNUSED const LoaderOp
     return reader->header();
 }
 
-bool SfntLoader::get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out)
+bool SfntLoader::get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out, RenderGlyphRun* run)
 {
     out.clear();
+    if (run) {
+        run->glyphs.clear();
+        run->font = id;
+        run->em = reader->metrics.unitsPerEm;
+    }
 
     fm.lines = 1;
 
@@ -569,12 +587,26 @@ bool SfntLoader::get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out)
     auto box = fm.box * fm.scale;
     auto end = text + len;
 
+    this->run = run;
+    heads.clear();
+
     if (fm.wrap == TextWrap::None || fm.box.x == 0.0f) wrapNone(fm, box, text, end, out);
     else if (fm.wrap == TextWrap::Character) wrapChar(fm, box, text, end, out);
     else if (fm.wrap == TextWrap::Word) wrapWord(fm, box, text, end, out, false);
     else if (fm.wrap == TextWrap::Smart) wrapWord(fm, box, text, end, out, true);
     else if (fm.wrap == TextWrap::Ellipsis) wrapEllipsis(fm, box, text, end, out);
-    else return false;
+    else {
+        this->run = nullptr;
+        return false;
+    }
+
+    if (run) {
+        for (uint32_t i = 0; i < run->glyphs.count; ++i) {
+            auto& glyph = run->glyphs[i];
+            glyph.pos = out.pts[heads[i]] - glyph.path->pts[0];
+        }
+        this->run = nullptr;
+    }
 
     return true;
 }
@@ -42,6 +42,8 @@ struct SfntLoader : public FontLoader
     Map<uint32_t, SfntGlyphMetrics> glyphs;  // glyph cache. key: codepoint
     SfntReader* reader = nullptr;
     char* text = nullptr;
+    RenderGlyphRun* run = nullptr;  // the glyph layout in progress
+    Array<uint32_t> heads;          // the first point of each glyph in the run
     bool nomap = false;
 
     SfntLoader();
@@ -53,7 +55,7 @@ struct SfntLoader : public FontLoader
     bool open(const char* path, const LoaderOps& ops) override;
     bool open(const char* data, uint32_t size, const LoaderOps& ops) override;
     void transform(Paint* paint, FontMetrics& fm, float italicShear) override;
-    bool get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out) override;
+    bool get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out, RenderGlyphRun* run) override;
     void copy(const FontMetrics& in, FontMetrics& out) override;
     void release(FontMetrics& fm) override;
     void metrics(const FontMetrics& fm, TextMetrics& out) override;
@@ -67,6 +69,7 @@ private:
         return (reader->metrics.hhea.advance * loc - reader->metrics.hhea.linegap) * spacing;
     }
 
+    void build(const SfntGlyphMetrics* glyph, const Point& cursor, const Point& offset, RenderPath& out);
     uint32_t feedLine(FontMetrics& fm, float box, float x, uint32_t begin, uint32_t end, Point& cursor, RenderPath& out);
     void wrapNone(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out);
     void wrapChar(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out);
@@ -4165,7 +4165,7 @@ bool SvgLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
     if (ops.caller != tvg::Type::Picture) return false;
 
     if (ops.owner == Ownership::Copy) {
-        content = tvg::malloc<char>(size + 1);
+        content = tvg::malloc<char>(size + 1, AllocTag::Loader);
         memcpy((char*)content, data, size);
         content[size] = '\0';
     } else content = (char*)data;
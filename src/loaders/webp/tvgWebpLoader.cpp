@@ -27,7 +27,7 @@
 
 void WebpLoader::clear()
 {
-    if (owner != Ownership::Borrow) tvg::free(data);
+    if (owner != Ownership::Borrow) unmap((char*)data, size);
     data = nullptr;
     owner = Ownership::Borrow;
 }
@@ -65,7 +65,7 @@ WebpLoader::~WebpLoader()
 bool WebpLoader::open(const char* path, const LoaderOps& ops)
 {
 #ifdef THORVG_FILE_IO_SUPPORT
-    if (!(data = (uint8_t*)Loader::open(path, size))) return false;
+    if (!(data = (uint8_t*)map(path, size))) return false;
     owner = Ownership::Transfer;
 
     WebPBitstreamFeatures features;
@@ -82,7 +82,7 @@ bool WebpLoader::open(const char* path, const LoaderOps& ops)
 bool WebpLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
 {
     if (ops.owner == Ownership::Copy) {
-        this->data = tvg::malloc<uint8_t>(size);
+        this->data = tvg::malloc<uint8_t>(size, AllocTag::Loader);
         memcpy((uint8_t*)this->data, data, size);
     } else {
         this->data = (uint8_t*) data;
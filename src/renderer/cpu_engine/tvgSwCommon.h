@@ -32,6 +32,19 @@
 #define SW_CURVE_TYPE_POINT 0
 #define SW_CURVE_TYPE_CUBIC 1
 #define SW_COLOR_TABLE 1024
+#define SW_GLYPH_CACHE_BUDGET (1024 * 1024)  //default memory cap of the glyph coverages in bytes
+#define SW_GLYPH_CACHE_MAX_SIZE 48           //the largest font size in pixels drawn with the glyph cache
+
+//the x86 kernels are compiled per instruction set and picked at runtime by rasterSimdLevel
+#ifdef THORVG_AVX_VECTOR_SUPPORT
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #define AVX_TARGET(isa)
+    #else
+        #define AVX_TARGET(isa) __attribute__((target(isa)))
+    #endif
+    //all the 16 lanes, for the zero-masked avx512 forms. GCC 12 warns about the undefined passthrough of some unmasked ones.
+    #define AVX512_ALL __mmask16(0xffff)
+#endif
 
 struct SwCompositor;
 struct SwSurface;
@@ -122,7 +135,7 @@ struct SwSpan
     }
 };
 
-struct SwRle
+struct SwRle : Allocated
 {
     Array<SwSpan> spans;
 
@@ -323,24 +336,82 @@ struct SwCellPool
     uint32_t size;
     SwCell* buffer;
 
-    SwCellPool() : size(DEFAULT_POOL_SIZE), buffer(tvg::malloc<SwCell>(DEFAULT_POOL_SIZE)) {}
+    SwCellPool() : size(DEFAULT_POOL_SIZE), buffer(tvg::malloc<SwCell>(DEFAULT_POOL_SIZE, AllocTag::Renderer)) {}
     ~SwCellPool() { tvg::free(buffer); }
 };
 
+//bump allocator of the transient data of a task, the allocations are released at once by the SwArenaScope
+struct SwArena
+{
+    #define SW_ARENA_CHUNK_SIZE 65536
+
+    struct Chunk
+    {
+        uint8_t* data;
+        size_t size;
+    };
+
+    Array<Chunk> chunks;
+    uint32_t cur = 0;       //index of the active chunk
+    size_t used = 0;        //used bytes of the active chunk
+
+    ~SwArena()
+    {
+        ARRAY_FOREACH(p, chunks) tvg::free(p->data);
+    }
+
+    template<typename T>
+    T* alloc(uint32_t cnt)
+    {
+        auto size = (sizeof(T) * cnt + 15) & ~size_t(15);
+        if (cur < chunks.count && used + size <= chunks[cur].size) {
+            auto p = chunks[cur].data + used;
+            used += size;
+            return reinterpret_cast<T*>(p);
+        }
+        return reinterpret_cast<T*>(grow(size));
+    }
+
+    size_t reserved() const
+    {
+        size_t size = 0;
+        ARRAY_FOREACH(p, chunks) size += p->size;
+        return size;
+    }
+
+    void* grow(size_t size);
+    void rewind(uint32_t chunk, size_t offset);
+};
+
+struct SwArenaScope
+{
+    SwArena* arena;
+    uint32_t chunk;
+    size_t offset;
+
+    SwArenaScope(SwArena* arena) : arena(arena), chunk(arena->cur), offset(arena->used) {}
+    ~SwArenaScope() { arena->rewind(chunk, offset); }
+};
+
 struct SwMpool
 {
     SwOutline* outlines;
     SwStrokeBorder* lBorders;
     SwStrokeBorder* rBorders;
     SwCellPool* cellPools;
+    SwArena* arenas;
+    RenderPath* paths;
+    uint32_t cnt;
 
     SwMpool(uint32_t threads)
     {
-        auto allocSize = threads + 1;
-        outlines = new SwOutline[allocSize];
-        lBorders = new SwStrokeBorder[allocSize];
-        rBorders = new SwStrokeBorder[allocSize];
-        cellPools = new SwCellPool[allocSize];
+        cnt = threads + 1;
+        outlines = new SwOutline[cnt];
+        lBorders = new SwStrokeBorder[cnt];
+        rBorders = new SwStrokeBorder[cnt];
+        cellPools = new SwCellPool[cnt];
+        arenas = new SwArena[cnt];
+        paths = new RenderPath[cnt];
     }
 
     ~SwMpool()
@@ -349,6 +420,8 @@ struct SwMpool
         delete[] (lBorders);
         delete[] (rBorders);
         delete[] (cellPools);
+        delete[] (arenas);
+        delete[] (paths);
     }
 
     SwCellPool* cell(unsigned idx)
@@ -356,6 +429,17 @@ struct SwMpool
         return &cellPools[idx];
     }
 
+    SwArena* arena(unsigned idx)
+    {
+        return &arenas[idx];
+    }
+
+    RenderPath* path(unsigned idx)
+    {
+        paths[idx].clear();
+        return &paths[idx];
+    }
+
     SwOutline* outline(unsigned idx)
     {
         outlines[idx].in.clear();
@@ -459,15 +543,18 @@ bool utilBBox(const BBox& bbox, const RenderRegion& clipBox, RenderRegion& rende
 
 void shapeReset(SwShape& shape);
 void shapeDelOutline(SwShape& shape);
-bool shapeGenRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool composite, bool antiAlias);
+bool shapeGenRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool composite, bool antiAlias, bool accumulate);
 void shapeResetStroke(SwShape& shape, const RenderShape* rshape, const Matrix& transform, SwMpool* mpool, unsigned tid);
-bool shapeGenStrokeRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool antiAlias);
+bool shapeGenStrokeRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool antiAlias, bool accumulate);
 void shapeFree(SwShape& shape);
 void shapeDelStroke(SwShape& shape);
 bool shapeGenFillColors(SwFill*& out, const Fill* fill, const Matrix& transform, SwSurface* surface, uint8_t opacity, bool ctable);
 void shapeResetFill(SwShape& shape);
 bool shapeStrokeBBox(SwShape& shape, const RenderShape* rshape, Point* pt4, const Matrix& m, SwMpool* mpool);
 void shapeDelFill(SwShape& shape);
+SwOutline* shapeGenOutline(const RenderPath& path, FillRule rule, SwMpool* mpool, unsigned tid);
+bool shapeGlyphCachable(const RenderShape* rshape, const Matrix& transform);
+bool shapeGenGlyphRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid);
 
 void strokeReset(SwStroke* stroke, const RenderShape* shape, const Matrix& transform, SwMpool* mpool, unsigned tid);
 bool strokeParseOutline(SwStroke* stroke, const SwOutline& outline, SwMpool* mpool, unsigned tid);
@@ -497,12 +584,12 @@ void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint3
 void fillRadial(const SwSurface* surface, const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, SwBlenderA op, SwBlender op2, uint8_t a);  // blending + BlendingMethod(op2) ver.
 void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint32_t len, uint8_t* cmp, SwAlpha alpha, uint8_t csize, uint8_t opacity);        // matting ver.
 
-SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox, SwMpool* mpool, unsigned tid, bool antiAlias);
+SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox, SwMpool* mpool, unsigned tid, bool antiAlias, bool accumulate);
 SwRle* rleRender(const RenderRegion* bbox);
 void rleFree(SwRle* rle);
 void rleReset(SwRle* rle);
 void rleMerge(SwRle* rle, SwRle* clip1, SwRle* clip2);
-bool rleClip(SwRle* rle, const SwRle* clip);
+bool rleClip(SwRle* rle, const SwRle* clip, SwArena* arena);
 bool rleClip(SwRle* rle, const RenderRegion* clip);
 bool rleIntersect(const SwRle* rle, const RenderRegion& region);
 
@@ -510,6 +597,11 @@ void mpoolInit(uint32_t threads);
 void mpoolTerm();
 SwMpool* mpoolReq();
 
+void glyphCacheBudget(size_t budget);
+void glyphCacheTerm();
+
+extern SimdLevel rasterSimdLevel;  //the vector instruction set of the raster kernels
+
 Result rasterCompositor(SwSurface* surface);
 bool rasterShape(SwSurface* surface, SwShape* shape, const RenderRegion& bbox, RenderColor& c);
 bool rasterTexmapPolygon(SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity);
@@ -521,6 +613,7 @@ bool rasterStroke(SwSurface* surface, SwShape* shape, const RenderRegion& bbox,
 bool rasterGradientShape(SwSurface* surface, SwShape* shape, const RenderRegion& bbox, const Fill* fdata, uint8_t opacity);
 bool rasterGradientStroke(SwSurface* surface, SwShape* shape, const RenderRegion& bbox, const Fill* fdata, uint8_t opacity);
 bool rasterClear(SwSurface* surface, uint32_t x, uint32_t y, uint32_t w, uint32_t h);
+SimdLevel rasterSimdSupport();
 void rasterPixel32(uint32_t* dst, uint32_t val, uint32_t offset, int32_t len);
 void rasterTranslucentPixel32(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity);
 void rasterPixel32(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity);
@@ -30,6 +30,7 @@
 #define RADIAL_A_THRESHOLD 0.0005f
 #define FIXPT_BITS 8
 #define FIXPT_SIZE (1<<FIXPT_BITS)
+#define FILL_BATCH 128  //pixels fetched from the color table at once
 
 /*
  * quadratic equation with the following coefficients (rx and ry defined in the _calculateCoefficients()):
@@ -310,6 +311,51 @@ static inline uint32_t _pixel(const SwFill* fill, float pos)
 }
 
 
+#include "tvgSwFillAvx.h"
+
+//fetch the gradient colors of the next span batch with the fixed point math
+static inline void _fetchLinear(const SwFill* fill, uint32_t* dst, int32_t& t, int32_t inc, uint32_t len)
+{
+#ifdef THORVG_AVX_VECTOR_SUPPORT
+    if (avxFetchLinear(fill, dst, t, inc, len)) {
+        t = static_cast<int32_t>(static_cast<uint32_t>(t) + static_cast<uint32_t>(inc) * len);
+        return;
+    }
+#endif
+    for (uint32_t i = 0; i < len; ++i, t += inc) dst[i] = _fixedPixel(fill, t);
+}
+
+
+//fetch the gradient colors of the next span batch, advancing the radial coefficients
+static inline void _fetchRadial(const SwFill* fill, uint32_t* dst, float& b, float deltaB, float& det, float& deltaDet, float deltaDeltaDet, uint32_t len)
+{
+#ifdef THORVG_AVX_VECTOR_SUPPORT
+    if (avxFetchRadial(fill, dst, b, deltaB, det, deltaDet, deltaDeltaDet, len)) return;
+#endif
+    for (uint32_t i = 0; i < len; ++i) {
+        dst[i] = _pixel(fill, sqrtf(det) - b);
+        det += deltaDet;
+        deltaDet += deltaDeltaDet;
+        b += deltaB;
+    }
+}
+
+
+static inline void _blendNormal(uint32_t* dst, const uint32_t* src, const uint8_t* alpha, uint32_t len)
+{
+#ifdef THORVG_AVX_VECTOR_SUPPORT
+    if (avxBlendNormal(dst, src, alpha, len)) return;
+#endif
+    for (uint32_t i = 0; i < len; ++i) dst[i] = opBlendNormal(src[i], dst[i], alpha[i]);
+}
+
+
+static inline uint32_t _batch(uint32_t len, uint32_t i)
+{
+    return (len - i < FILL_BATCH) ? (len - i) : FILL_BATCH;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -342,20 +388,18 @@ void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint3
         float b, deltaB, det, deltaDet, deltaDeltaDet;
         _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
 
-        if (opacity == 255) {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst, cmp += csize) {
-                *dst = opBlendNormal(_pixel(fill, sqrtf(det) - b), *dst, alpha(cmp));
-                det += deltaDet;
-                deltaDet += deltaDeltaDet;
-                b += deltaB;
-            }
-        } else {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst, cmp += csize) {
-                *dst = opBlendNormal(_pixel(fill, sqrtf(det) - b), *dst, MULTIPLY(opacity, alpha(cmp)));
-                det += deltaDet;
-                deltaDet += deltaDeltaDet;
-                b += deltaB;
+        uint32_t buf[FILL_BATCH];
+        uint8_t alphas[FILL_BATCH];
+        for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+            auto cnt = _batch(len, i);
+            _fetchRadial(fill, buf, b, deltaB, det, deltaDet, deltaDeltaDet, cnt);
+            if (opacity == 255) {
+                for (uint32_t j = 0; j < cnt; ++j, cmp += csize) alphas[j] = alpha(cmp);
+            } else {
+                for (uint32_t j = 0; j < cnt; ++j, cmp += csize) alphas[j] = MULTIPLY(opacity, alpha(cmp));
             }
+            _blendNormal(dst, buf, alphas, cnt);
+            dst += cnt;
         }
     }
 }
@@ -377,11 +421,11 @@ void fillRadial(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint3
         float b, deltaB, det, deltaDet, deltaDeltaDet;
         _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
 
-        for (uint32_t i = 0; i < len; ++i, ++dst) {
-            *dst = op(_pixel(fill, sqrtf(det) - b), *dst, a);
-            det += deltaDet;
-            deltaDet += deltaDeltaDet;
-            b += deltaB;
+        uint32_t buf[FILL_BATCH];
+        for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+            auto cnt = _batch(len, i);
+            _fetchRadial(fill, buf, b, deltaB, det, deltaDet, deltaDeltaDet, cnt);
+            for (uint32_t j = 0; j < cnt; ++j, ++dst) *dst = op(buf[j], *dst, a);
         }
     }
 }
@@ -404,12 +448,14 @@ void fillRadial(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32
         float b, deltaB, det, deltaDet, deltaDeltaDet;
         _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
 
-        for (uint32_t i = 0 ; i < len ; ++i, ++dst) {
-            auto src = MULTIPLY(a, A(_pixel(fill, sqrtf(det) - b)));
-            *dst = maskOp(src, *dst, ~src);
-            det += deltaDet;
-            deltaDet += deltaDeltaDet;
-            b += deltaB;
+        uint32_t buf[FILL_BATCH];
+        for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+            auto cnt = _batch(len, i);
+            _fetchRadial(fill, buf, b, deltaB, det, deltaDet, deltaDeltaDet, cnt);
+            for (uint32_t j = 0; j < cnt; ++j, ++dst) {
+                auto src = MULTIPLY(a, A(buf[j]));
+                *dst = maskOp(src, *dst, ~src);
+            }
         }
     }
 }
@@ -433,13 +479,15 @@ void fillRadial(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32
         float b, deltaB, det, deltaDet, deltaDeltaDet;
         _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
 
-        for (uint32_t i = 0 ; i < len ; ++i, ++dst, ++cmp) {
-            auto src = MULTIPLY(A(_pixel(fill, sqrtf(det))), a);
-            auto tmp = maskOp(src, *cmp, 0);
-            *dst = tmp + MULTIPLY(*dst, ~tmp);
-            det += deltaDet;
-            deltaDet += deltaDeltaDet;
-            b += deltaB;
+        uint32_t buf[FILL_BATCH];
+        for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+            auto cnt = _batch(len, i);
+            _fetchRadial(fill, buf, b, deltaB, det, deltaDet, deltaDeltaDet, cnt);
+            for (uint32_t j = 0; j < cnt; ++j, ++dst, ++cmp) {
+                auto src = MULTIPLY(A(buf[j]), a);
+                auto tmp = maskOp(src, *cmp, 0);
+                *dst = tmp + MULTIPLY(*dst, ~tmp);
+            }
         }
     }
 }
@@ -472,22 +520,21 @@ void fillRadial(const SwSurface* surface, const SwFill* fill, uint32_t* dst, uin
     } else {
         float b, deltaB, det, deltaDet, deltaDeltaDet;
         _calculateCoefficients(fill, x, y, b, deltaB, det, deltaDet, deltaDeltaDet);
-        if (a == 255) {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst) {
-                auto tmp = op(_pixel(fill, sqrtf(det) - b), *dst, 255);
-                *dst = op2(surface, tmp, *dst);
-                det += deltaDet;
-                deltaDet += deltaDeltaDet;
-                b += deltaB;
-            }
-        } else {
-            for (uint32_t i = 0 ; i < len ; ++i, ++dst) {
-                auto tmp = op(_pixel(fill, sqrtf(det) - b), *dst, 255);
-                auto tmp2 = op2(surface, tmp, *dst);
-                *dst = INTERPOLATE(tmp2, *dst, a);
-                det += deltaDet;
-                deltaDet += deltaDeltaDet;
-                b += deltaB;
+        uint32_t buf[FILL_BATCH];
+        for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+            auto cnt = _batch(len, i);
+            _fetchRadial(fill, buf, b, deltaB, det, deltaDet, deltaDeltaDet, cnt);
+            if (a == 255) {
+                for (uint32_t j = 0; j < cnt; ++j, ++dst) {
+                    auto tmp = op(buf[j], *dst, 255);
+                    *dst = op2(surface, tmp, *dst);
+                }
+            } else {
+                for (uint32_t j = 0; j < cnt; ++j, ++dst) {
+                    auto tmp = op(buf[j], *dst, 255);
+                    auto tmp2 = op2(surface, tmp, *dst);
+                    *dst = INTERPOLATE(tmp2, *dst, a);
+                }
             }
         }
     }
@@ -519,9 +566,14 @@ void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint3
         if (v < vMax && v > vMin) {
             auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
             auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-            for (uint32_t j = 0; j < len; ++j, ++dst, cmp += csize) {
-                *dst = opBlendNormal(_fixedPixel(fill, t2), *dst, alpha(cmp));
-                t2 += inc2;
+            uint32_t buf[FILL_BATCH];
+            uint8_t alphas[FILL_BATCH];
+            for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+                auto cnt = _batch(len, i);
+                _fetchLinear(fill, buf, t2, inc2, cnt);
+                for (uint32_t j = 0; j < cnt; ++j, cmp += csize) alphas[j] = alpha(cmp);
+                _blendNormal(dst, buf, alphas, cnt);
+                dst += cnt;
             }
         //we have to fallback to float math
         } else {
@@ -550,9 +602,14 @@ void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint3
         if (v < vMax && v > vMin) {
             auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
             auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-            for (uint32_t j = 0; j < len; ++j, ++dst, cmp += csize) {
-                *dst = opBlendNormal(_fixedPixel(fill, t2), *dst, MULTIPLY(alpha(cmp), opacity));
-                t2 += inc2;
+            uint32_t buf[FILL_BATCH];
+            uint8_t alphas[FILL_BATCH];
+            for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+                auto cnt = _batch(len, i);
+                _fetchLinear(fill, buf, t2, inc2, cnt);
+                for (uint32_t j = 0; j < cnt; ++j, cmp += csize) alphas[j] = MULTIPLY(alpha(cmp), opacity);
+                _blendNormal(dst, buf, alphas, cnt);
+                dst += cnt;
             }
         //we have to fallback to float math
         } else {
@@ -592,10 +649,14 @@ void fillLinear(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32
     if (v < vMax && v > vMin) {
         auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
         auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-        for (uint32_t j = 0; j < len; ++j, ++dst) {
-            auto src = MULTIPLY(A(_fixedPixel(fill, t2)), a);
-            *dst = maskOp(src, *dst, ~src);
-            t2 += inc2;
+        uint32_t buf[FILL_BATCH];
+        for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+            auto cnt = _batch(len, i);
+            _fetchLinear(fill, buf, t2, inc2, cnt);
+            for (uint32_t j = 0; j < cnt; ++j, ++dst) {
+                auto src = MULTIPLY(A(buf[j]), a);
+                *dst = maskOp(src, *dst, ~src);
+            }
         }
     //we have to fallback to float math
     } else {
@@ -636,11 +697,15 @@ void fillLinear(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32
     if (v < vMax && v > vMin) {
         auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
         auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-        for (uint32_t j = 0; j < len; ++j, ++dst, ++cmp) {
-            auto src = MULTIPLY(a, A(_fixedPixel(fill, t2)));
-            auto tmp = maskOp(src, *cmp, 0);
-            *dst = tmp + MULTIPLY(*dst, ~tmp);
-            t2 += inc2;
+        uint32_t buf[FILL_BATCH];
+        for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+            auto cnt = _batch(len, i);
+            _fetchLinear(fill, buf, t2, inc2, cnt);
+            for (uint32_t j = 0; j < cnt; ++j, ++dst, ++cmp) {
+                auto src = MULTIPLY(a, A(buf[j]));
+                auto tmp = maskOp(src, *cmp, 0);
+                *dst = tmp + MULTIPLY(*dst, ~tmp);
+            }
         }
     //we have to fallback to float math
     } else {
@@ -681,9 +746,11 @@ void fillLinear(const SwFill* fill, uint32_t* dst, uint32_t y, uint32_t x, uint3
     if (v < vMax && v > vMin) {
         auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
         auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-        for (uint32_t j = 0; j < len; ++j, ++dst) {
-            *dst = op(_fixedPixel(fill, t2), *dst, a);
-            t2 += inc2;
+        uint32_t buf[FILL_BATCH];
+        for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+            auto cnt = _batch(len, i);
+            _fetchLinear(fill, buf, t2, inc2, cnt);
+            for (uint32_t j = 0; j < cnt; ++j, ++dst) *dst = op(buf[j], *dst, a);
         }
     //we have to fallback to float math
     } else {
@@ -730,10 +797,14 @@ void fillLinear(const SwSurface* surface, const SwFill* fill, uint32_t* dst, uin
         if (v < vMax && v > vMin) {
             auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
             auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-            for (uint32_t j = 0; j < len; ++j, ++dst) {
-                auto tmp = op(_fixedPixel(fill, t2), *dst, 255);
-                *dst = op2(surface, tmp, *dst);
-                t2 += inc2;
+            uint32_t buf[FILL_BATCH];
+            for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+                auto cnt = _batch(len, i);
+                _fetchLinear(fill, buf, t2, inc2, cnt);
+                for (uint32_t j = 0; j < cnt; ++j, ++dst) {
+                    auto tmp = op(buf[j], *dst, 255);
+                    *dst = op2(surface, tmp, *dst);
+                }
             }
         //we have to fallback to float math
         } else {
@@ -750,11 +821,15 @@ void fillLinear(const SwSurface* surface, const SwFill* fill, uint32_t* dst, uin
         if (v < vMax && v > vMin) {
             auto t2 = static_cast<int32_t>(t * FIXPT_SIZE);
             auto inc2 = static_cast<int32_t>(inc * FIXPT_SIZE);
-            for (uint32_t j = 0; j < len; ++j, ++dst) {
-                auto tmp = op(_fixedPixel(fill, t2), *dst, 255);
-                auto tmp2 = op2(surface, tmp, *dst);
-                *dst = INTERPOLATE(tmp2, *dst, a);
-                t2 += inc2;
+            uint32_t buf[FILL_BATCH];
+            for (uint32_t i = 0; i < len; i += FILL_BATCH) {
+                auto cnt = _batch(len, i);
+                _fetchLinear(fill, buf, t2, inc2, cnt);
+                for (uint32_t j = 0; j < cnt; ++j, ++dst) {
+                    auto tmp = op(buf[j], *dst, 255);
+                    auto tmp2 = op2(surface, tmp, *dst);
+                    *dst = INTERPOLATE(tmp2, *dst, a);
+                }
             }
         //we have to fallback to float math
         } else {
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifdef THORVG_AVX_VECTOR_SUPPORT
+
+#include <immintrin.h>
+
+/* The gradient kernels rely on the gathers, so they run on the AVX2 level and above.
+   Only the color fetch and the normal blending are vectorized. The masked, matted and blending
+   fillers compose the fetched colors per pixel through their SwMask, SwAlpha and SwBlender ops. */
+
+/************************************************************************/
+/* AVX2                                                                 */
+/************************************************************************/
+
+AVX_TARGET("avx2")
+static inline __m256i _avx2Clamp(__m256i idx, FillSpread spread)
+{
+    switch (spread) {
+        case FillSpread::Pad: {
+            return _mm256_min_epi32(_mm256_max_epi32(idx, _mm256_setzero_si256()), _mm256_set1_epi32(SW_COLOR_TABLE - 1));
+        }
+        case FillSpread::Repeat: {
+            return _mm256_and_si256(idx, _mm256_set1_epi32(SW_COLOR_TABLE - 1));
+        }
+        default: {
+            idx = _mm256_and_si256(idx, _mm256_set1_epi32(SW_COLOR_TABLE * 2 - 1));
+            auto mirror = _mm256_sub_epi32(_mm256_set1_epi32(SW_COLOR_TABLE * 2 - 1), idx);
+            return _mm256_blendv_epi8(idx, mirror, _mm256_cmpgt_epi32(idx, _mm256_set1_epi32(SW_COLOR_TABLE - 1)));
+        }
+    }
+}
+
+
+//the exact ALPHA_BLEND() with a per-lane alpha
+AVX_TARGET("avx2")
+static inline __m256i _avx2AlphaBlend(__m256i c, __m256i a)
+{
+    auto RB = _mm256_set1_epi32(0x00ff00ff);
+    a = _mm256_add_epi32(a, _mm256_set1_epi32(1));
+    auto odd = _mm256_and_si256(_mm256_mullo_epi32(_mm256_and_si256(_mm256_srli_epi32(c, 8), RB), a), _mm256_set1_epi32(0xff00ff00));
+    auto even = _mm256_and_si256(_mm256_srli_epi32(_mm256_mullo_epi32(_mm256_and_si256(c, RB), a), 8), RB);
+    return _mm256_add_epi32(odd, even);
+}
+
+
+AVX_TARGET("avx2")
+static void avx2FetchLinear(const SwFill* fill, uint32_t* dst, int32_t t, int32_t inc, uint32_t len)
+{
+    auto table = reinterpret_cast<const int*>(fill->ctable);
+    auto pos = _mm256_add_epi32(_mm256_set1_epi32(t), _mm256_mullo_epi32(_mm256_set1_epi32(inc), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+    auto step = _mm256_set1_epi32(int32_t(uint32_t(inc) * 8));
+    auto half = _mm256_set1_epi32(FIXPT_SIZE / 2);
+
+    uint32_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        auto idx = _avx2Clamp(_mm256_srai_epi32(_mm256_add_epi32(pos, half), FIXPT_BITS), fill->spread);
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_i32gather_epi32(table, idx, 4));
+        pos = _mm256_add_epi32(pos, step);
+    }
+
+    //leftovers
+    t = int32_t(uint32_t(t) + uint32_t(inc) * i);
+    for (; i < len; ++i, t += inc) dst[i] = _fixedPixel(fill, t);
+}
+
+
+AVX_TARGET("avx2")
+static void avx2FetchRadial(const SwFill* fill, uint32_t* dst, float& b, float deltaB, float& det, float& deltaDet, float deltaDeltaDet, uint32_t len)
+{
+    auto table = reinterpret_cast<const int*>(fill->ctable);
+    auto scale = _mm256_set1_ps(SW_COLOR_TABLE - 1);
+    auto half = _mm256_set1_ps(0.5f);
+    float dets[8], bs[8];
+
+    uint32_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        //keep the incremental evaluation identical to the scalar version
+        for (int k = 0; k < 8; ++k) {
+            dets[k] = det;
+            bs[k] = b;
+            det += deltaDet;
+            deltaDet += deltaDeltaDet;
+            b += deltaB;
+        }
+        auto pos = _mm256_sub_ps(_mm256_sqrt_ps(_mm256_loadu_ps(dets)), _mm256_loadu_ps(bs));
+        auto idx = _avx2Clamp(_mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(pos, scale), half)), fill->spread);
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_i32gather_epi32(table, idx, 4));
+    }
+
+    //leftovers
+    for (; i < len; ++i) {
+        dst[i] = _pixel(fill, sqrtf(det) - b);
+        det += deltaDet;
+        deltaDet += deltaDeltaDet;
+        b += deltaB;
+    }
+}
+
+
+AVX_TARGET("avx2")
+static void avx2BlendNormal(uint32_t* dst, const uint32_t* src, const uint8_t* alpha, uint32_t len)
+{
+    auto full = _mm256_set1_epi32(255);
+
+    uint32_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        auto a = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(alpha + i)));
+        auto t = _avx2AlphaBlend(_mm256_loadu_si256((const __m256i*)(src + i)), a);
+        auto ia = _mm256_sub_epi32(full, _mm256_srli_epi32(t, 24));
+        auto d = _mm256_loadu_si256((const __m256i*)(dst + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_add_epi32(t, _avx2AlphaBlend(d, ia)));
+    }
+
+    //leftovers
+    for (; i < len; ++i) dst[i] = opBlendNormal(src[i], dst[i], alpha[i]);
+}
+
+
+/************************************************************************/
+/* AVX-512                                                              */
+/************************************************************************/
+
+AVX_TARGET("avx512f")
+static inline __m512i _avx512Clamp(__m512i idx, FillSpread spread)
+{
+    switch (spread) {
+        case FillSpread::Pad: {
+            return _mm512_maskz_min_epi32(AVX512_ALL, _mm512_maskz_max_epi32(AVX512_ALL, idx, _mm512_setzero_si512()), _mm512_set1_epi32(SW_COLOR_TABLE - 1));
+        }
+        case FillSpread::Repeat: {
+            return _mm512_and_si512(idx, _mm512_set1_epi32(SW_COLOR_TABLE - 1));
+        }
+        default: {
+            idx = _mm512_and_si512(idx, _mm512_set1_epi32(SW_COLOR_TABLE * 2 - 1));
+            auto mirror = _mm512_sub_epi32(_mm512_set1_epi32(SW_COLOR_TABLE * 2 - 1), idx);
+            return _mm512_mask_blend_epi32(_mm512_cmpgt_epi32_mask(idx, _mm512_set1_epi32(SW_COLOR_TABLE - 1)), idx, mirror);
+        }
+    }
+}
+
+
+AVX_TARGET("avx512f")
+static void avx512FetchLinear(const SwFill* fill, uint32_t* dst, int32_t t, int32_t inc, uint32_t len)
+{
+    auto table = reinterpret_cast<const int*>(fill->ctable);
+    auto pos = _mm512_add_epi32(_mm512_set1_epi32(t), _mm512_mullo_epi32(_mm512_set1_epi32(inc), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+    auto step = _mm512_set1_epi32(int32_t(uint32_t(inc) * 16));
+    auto half = _mm512_set1_epi32(FIXPT_SIZE / 2);
+
+    for (uint32_t i = 0; i < len; i += 16) {
+        auto idx = _avx512Clamp(_mm512_maskz_srai_epi32(AVX512_ALL, _mm512_add_epi32(pos, half), FIXPT_BITS), fill->spread);
+        //the leftovers are handled by the lane mask
+        auto mask = (len - i < 16) ? __mmask16((1u << (len - i)) - 1) : __mmask16(0xffff);
+        _mm512_mask_storeu_epi32(dst + i, mask, _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), mask, idx, table, 4));
+        pos = _mm512_add_epi32(pos, step);
+    }
+}
+
+
+AVX_TARGET("avx512f")
+static void avx512FetchRadial(const SwFill* fill, uint32_t* dst, float& b, float deltaB, float& det, float& deltaDet, float deltaDeltaDet, uint32_t len)
+{
+    auto table = reinterpret_cast<const int*>(fill->ctable);
+    auto scale = _mm512_set1_ps(SW_COLOR_TABLE - 1);
+    auto half = _mm512_set1_ps(0.5f);
+    float dets[16], bs[16];
+
+    for (uint32_t i = 0; i < len; i += 16) {
+        auto cnt = (len - i < 16) ? (len - i) : 16;
+        //keep the incremental evaluation identical to the scalar version
+        for (uint32_t k = 0; k < 16; ++k) {
+            if (k < cnt) {
+                dets[k] = det;
+                bs[k] = b;
+                det += deltaDet;
+                deltaDet += deltaDeltaDet;
+                b += deltaB;
+            } else {
+                dets[k] = bs[k] = 0.0f;
+            }
+        }
+        auto pos = _mm512_sub_ps(_mm512_maskz_sqrt_ps(AVX512_ALL, _mm512_loadu_ps(dets)), _mm512_loadu_ps(bs));
+        //no fused multiply-add here, the rounding must match the scalar _pixel()
+        auto idx = _mm512_maskz_cvttps_epi32(AVX512_ALL, _mm512_add_ps(_mm512_mul_ps(pos, scale), half));
+        idx = _avx512Clamp(idx, fill->spread);
+        auto mask = __mmask16((1u << cnt) - 1);
+        _mm512_mask_storeu_epi32(dst + i, mask, _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), mask, idx, table, 4));
+    }
+}
+
+
+/************************************************************************/
+/* Dispatchers                                                          */
+/************************************************************************/
+
+static bool avxFetchLinear(const SwFill* fill, uint32_t* dst, int32_t t, int32_t inc, uint32_t len)
+{
+    switch (rasterSimdLevel) {
+        case SimdLevel::AVX512: avx512FetchLinear(fill, dst, t, inc, len); return true;
+        case SimdLevel::AVX2: avx2FetchLinear(fill, dst, t, inc, len); return true;
+        default: return false;
+    }
+}
+
+
+static bool avxFetchRadial(const SwFill* fill, uint32_t* dst, float& b, float deltaB, float& det, float& deltaDet, float deltaDeltaDet, uint32_t len)
+{
+    switch (rasterSimdLevel) {
+        case SimdLevel::AVX512: avx512FetchRadial(fill, dst, b, deltaB, det, deltaDet, deltaDeltaDet, len); return true;
+        case SimdLevel::AVX2: avx2FetchRadial(fill, dst, b, deltaB, det, deltaDet, deltaDeltaDet, len); return true;
+        default: return false;
+    }
+}
+
+
+static bool avxBlendNormal(uint32_t* dst, const uint32_t* src, const uint8_t* alpha, uint32_t len)
+{
+    if (rasterSimdLevel != SimdLevel::AVX2 && rasterSimdLevel != SimdLevel::AVX512) return false;
+    avx2BlendNormal(dst, src, alpha, len);
+    return true;
+}
+
+#endif
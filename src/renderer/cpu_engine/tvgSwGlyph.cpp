@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgSwCommon.h"
+#include "tvgLock.h"
+#include "tvgMap.h"
+#include "tvgInlist.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#define SW_GLYPH_SUBPIXEL 4   //subpixel positions per axis
+
+//8-bit coverage of a glyph at a size and a subpixel offset
+struct SwGlyph
+{
+    INLIST_ITEM(SwGlyph);
+    uint64_t key;
+    int32_t x, y;     //offset from the glyph origin in pixels
+    int32_t w, h;
+    uint8_t* coverage;
+
+    ~SwGlyph()
+    {
+        tvg::free(coverage);
+    }
+};
+
+struct SwGlyphCache
+{
+    Map<uint64_t, SwGlyph*> glyphs;
+    Inlist<SwGlyph> lru;    //the least recently used at the head
+    size_t bytes = 0;
+};
+
+static SwGlyphCache* _cache = nullptr;
+static size_t _budget = SW_GLYPH_CACHE_BUDGET;
+static Key _key;
+
+
+static uint64_t _hash(uint32_t font, uint32_t idx, uint32_t size, uint32_t subx, uint32_t suby)
+{
+    return (uint64_t(font & 0xffffff) << 40) | (uint64_t(idx & 0xffff) << 24) | (uint64_t(size & 0xfffff) << 4) | (subx << 2) | suby;
+}
+
+
+static SwGlyph* _render(const RenderGlyph& glyph, float scale, const Point& offset, FillRule rule, SwMpool* mpool, unsigned tid)
+{
+    auto outline = shapeGenOutline(*glyph.path, rule, mpool, tid);
+    if (!outline || outline->in.empty()) return nullptr;
+
+    BBox bbox;
+    utilExport(outline, {scale, 0, offset.x, 0, scale, offset.y, 0, 0, 1}, bbox);
+
+    RenderRegion region = {{(int32_t)floorf(bbox.min.x), (int32_t)floorf(bbox.min.y)}, {(int32_t)ceilf(bbox.max.x), (int32_t)ceilf(bbox.max.y)}};
+    if (!region.valid()) return nullptr;
+
+    auto rle = rleRender(nullptr, outline, region, mpool, tid, true, false);
+    if (!rle) return nullptr;
+
+    auto out = new SwGlyph;
+    out->x = region.min.x;
+    out->y = region.min.y;
+    out->w = region.w();
+    out->h = region.h();
+    out->coverage = tvg::calloc<uint8_t>(out->w * out->h, 1, AllocTag::Cache);
+
+    ARRAY_FOREACH(span, rle->spans) {
+        memset(out->coverage + (span->y - out->y) * out->w + (span->x - out->x), span->coverage, span->len);
+    }
+    rleFree(rle);
+
+    return out;
+}
+
+
+static void _evict(size_t budget)
+{
+    while (_cache->bytes > budget) {
+        auto glyph = _cache->lru.front();
+        if (!glyph) break;
+        _cache->glyphs.remove(glyph->key);
+        _cache->bytes -= glyph->w * glyph->h;
+        delete(glyph);
+    }
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+bool shapeGlyphCachable(const RenderShape* rshape, const Matrix& transform)
+{
+    auto run = rshape->glyphs;
+    if (!run || run->glyphs.empty() || _budget == 0 || rshape->rule != FillRule::NonZero) return false;
+    if (rshape->stroke && rshape->stroke->width > 0.0f) return false;
+
+    //axis aligned uniform scaling only, the others go through the outlines
+    if (!tvg::zero(transform.e12) || !tvg::zero(transform.e21) || !tvg::equal(transform.e11, transform.e22)) return false;
+
+    auto ppem = transform.e11 * run->em;
+    return ppem > 0.0f && ppem <= SW_GLYPH_CACHE_MAX_SIZE;
+}
+
+
+bool shapeGenGlyphRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid)
+{
+    auto run = rshape->glyphs;
+
+    //the glyphs are drawn at the nearest quarter pixel size
+    auto size = std::max(uint32_t(nearbyintf(transform.e11 * run->em * SW_GLYPH_SUBPIXEL)), 1u);
+    auto scale = float(size) / (SW_GLYPH_SUBPIXEL * run->em);
+
+    struct Placement
+    {
+        SwGlyph* glyph;
+        int32_t x, y;
+    };
+
+    auto arena = mpool->arena(tid);
+    SwArenaScope scope(arena);
+    auto placements = arena->alloc<Placement>(run->glyphs.count);
+    uint32_t cnt = 0;
+
+    //the cached glyphs must not be evicted while they are composed
+    ScopedLock lock(_key);
+
+    if (!_cache) _cache = new SwGlyphCache;
+
+    renderBox = {{INT32_MAX, INT32_MAX}, {INT32_MIN, INT32_MIN}};
+
+    ARRAY_FOREACH(p, run->glyphs) {
+        //split the origin into the pixel and the subpixel positions
+        auto ox = p->pos.x * transform.e11 + transform.e13;
+        auto oy = p->pos.y * transform.e22 + transform.e23;
+        auto x = int32_t(floorf(ox));
+        auto y = int32_t(floorf(oy));
+        auto subx = uint32_t(nearbyintf((ox - x) * SW_GLYPH_SUBPIXEL));
+        auto suby = uint32_t(nearbyintf((oy - y) * SW_GLYPH_SUBPIXEL));
+        if (subx == SW_GLYPH_SUBPIXEL) {
+            ++x;
+            subx = 0;
+        }
+        if (suby == SW_GLYPH_SUBPIXEL) {
+            ++y;
+            suby = 0;
+        }
+
+        auto key = _hash(run->font, p->idx, size, subx, suby);
+        SwGlyph* glyph;
+        if (auto cached = _cache->glyphs.find(key)) {
+            glyph = *cached;
+            _cache->lru.remove(glyph);
+        } else {
+            glyph = _render(*p, scale, {float(subx) / SW_GLYPH_SUBPIXEL, float(suby) / SW_GLYPH_SUBPIXEL}, rshape->rule, mpool, tid);
+            if (!glyph) continue;
+            glyph->key = key;
+            _cache->glyphs[key] = glyph;
+            _cache->bytes += glyph->w * glyph->h;
+        }
+        _cache->lru.back(glyph);
+
+        x += glyph->x;
+        y += glyph->y;
+        placements[cnt++] = {glyph, x, y};
+        renderBox.add({{x, y}, {x + glyph->w, y + glyph->h}});
+    }
+
+    renderBox.intersect(clipBox);
+
+    if (renderBox.valid()) {
+        //accumulate the glyph coverages in the text region
+        auto w = renderBox.sw();
+        auto h = renderBox.sh();
+        auto buffer = arena->alloc<uint8_t>(w * h);
+        memset(buffer, 0, w * h);
+
+        for (auto p = placements; p < placements + cnt; ++p) {
+            auto region = RenderRegion::intersect(renderBox, {{p->x, p->y}, {p->x + p->glyph->w, p->y + p->glyph->h}});
+            if (!region.valid()) continue;
+            for (auto y = region.min.y; y < region.max.y; ++y) {
+                auto src = p->glyph->coverage + (y - p->y) * p->glyph->w + (region.min.x - p->x);
+                auto dst = buffer + (y - renderBox.min.y) * w + (region.min.x - renderBox.min.x);
+                for (auto x = region.min.x; x < region.max.x; ++x, ++src, ++dst) {
+                    auto v = *dst + *src;
+                    *dst = v > 255 ? 255 : v;
+                }
+            }
+        }
+
+        //encode the coverage runs into the spans
+        if (!shape.rle) shape.rle = new SwRle;
+        for (int32_t y = 0; y < h; ++y) {
+            auto row = buffer + y * w;
+            int32_t x = 0;
+            while (x < w) {
+                auto c = row[x];
+                auto begin = x;
+                while (++x < w && row[x] == c);
+                if (c > 0) shape.rle->spans.push({renderBox.min.x + begin, renderBox.min.y + y, x - begin, c});
+            }
+        }
+    }
+
+    _evict(_budget);
+
+    if (!shape.rle || shape.rle->spans.empty()) {
+        renderBox.reset();
+        return false;
+    }
+
+    shape.bbox = renderBox;
+    return true;
+}
+
+
+void glyphCacheBudget(size_t budget)
+{
+    ScopedLock lock(_key);
+    _budget = budget;
+    if (_cache) _evict(_budget);
+}
+
+
+void glyphCacheTerm()
+{
+    ScopedLock lock(_key);
+    delete(_cache);
+    _cache = nullptr;
+}
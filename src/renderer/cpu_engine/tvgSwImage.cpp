@@ -85,7 +85,7 @@ bool imagePrepare(SwImage& image, const Matrix& transform, const RenderRegion& c
 
 bool imageGenRle(SwImage& image, const RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool antiAlias)
 {
-    image.rle = rleRender(image.rle, image.outline, renderBox, mpool, tid, antiAlias);
+    image.rle = rleRender(image.rle, image.outline, renderBox, mpool, tid, antiAlias, false);
     return image.rle ? true : false;
 }
 
@@ -27,7 +27,9 @@
 /************************************************************************/
 
 static thread_local SwMpool* _pool = nullptr;
+static thread_local uint32_t _poolGen = 0;
 static Array<SwMpool*> _pools;
+static uint32_t _gen = 1;  //bumped on term, the pools left in the other threads expire with it
 static uint32_t _threads = 0;
 static StrictKey _key;
 
@@ -35,10 +37,38 @@ static StrictKey _key;
 /* External Class Implementation                                        */
 /************************************************************************/
 
+void* SwArena::grow(size_t size)
+{
+    //move on to the next chunk that fits, or append a new one
+    if (cur < chunks.count) ++cur;
+    while (cur < chunks.count && chunks[cur].size < size) ++cur;
+    if (cur == chunks.count) {
+        auto csize = std::max(size, size_t(SW_ARENA_CHUNK_SIZE));
+        chunks.push({tvg::malloc<uint8_t>(csize, AllocTag::Renderer), csize});
+    }
+    used = size;
+    return chunks[cur].data;
+}
+
+void SwArena::rewind(uint32_t chunk, size_t offset)
+{
+    cur = chunk;
+    used = offset;
+
+    //all released, merge the chunks so that the next frame fits in one
+    if (cur == 0 && used == 0 && chunks.count > 1) {
+        auto size = reserved();
+        ARRAY_FOREACH(p, chunks) tvg::free(p->data);
+        chunks.clear();
+        chunks.push({tvg::malloc<uint8_t>(size, AllocTag::Renderer), size});
+    }
+}
+
 SwMpool* mpoolReq()
 {
-    if (!_pool) {
+    if (!_pool || _poolGen != _gen) {
         _pool = new SwMpool(_threads);
+        _poolGen = _gen;
         ScopedLock lock(_key);
         _pools.push(_pool);
     }
@@ -52,9 +82,8 @@ void mpoolInit(uint32_t threads)
 
 void mpoolTerm()
 {
-    for (auto p : _pools) {
-        delete p;
-        _pool = nullptr;
-    }
+    for (auto p : _pools) delete p;
     _pools.reset();
+    _pool = nullptr;
+    ++_gen;
 }
\ No newline at end of file
@@ -30,6 +30,8 @@
 
 constexpr auto DOWN_SCALE_TOLERANCE = 0.5f;
 
+SimdLevel rasterSimdLevel = SimdLevel::None;
+
 struct FillLinear
 {
     void operator()(const SwFill* fill, uint8_t* dst, uint32_t y, uint32_t x, uint32_t len, SwMask op, uint8_t a)
@@ -260,7 +262,6 @@ static uint32_t _interpNoScaler(const uint32_t *img, uint32_t stride, TVG_UNUSED
 
 
 //Bilinear Interpolation
-//OPTIMIZE_ME: Skip the function pointer access
 static uint32_t _interpUpScaler(const uint32_t *img, uint32_t stride, uint32_t w, uint32_t h, float sx, float sy, TVG_UNUSED int32_t miny, TVG_UNUSED int32_t maxy, TVG_UNUSED int32_t n)
 {
     auto rx = (size_t)(sx);
@@ -283,7 +284,6 @@ static uint32_t _interpUpScaler(const uint32_t *img, uint32_t stride, uint32_t w
 
 
 //2n x 2n Mean Kernel
-//OPTIMIZE_ME: Skip the function pointer access
 static uint32_t _interpDownScaler(const uint32_t *img, uint32_t stride, uint32_t w, uint32_t h, float sx, TVG_UNUSED float sy, int32_t miny, int32_t maxy, int32_t n)
 {
     size_t c[4] = {0, 0, 0, 0};
@@ -330,6 +330,45 @@ static ImageScaleFilter _scaleMethod(const SwImage& image)
 }
 
 
+template<ImageScaleFilter scaler>
+static void _scalePixels(uint32_t* dst, const SwImage& image, const Matrix* itransform, int32_t x, int32_t len, float sy, int32_t miny, int32_t maxy, int32_t n)
+{
+    for (int32_t i = 0; i < len; ++i) {
+        auto sx = (x + i) * itransform->e11 + itransform->e13 - 0.49f;
+        dst[i] = scaler(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, n);
+    }
+}
+
+
+//Scale the image pixels of the output span [x, x + len) at the source row sy
+static void _scaleSpan(uint32_t* dst, const SwImage& image, const Matrix* itransform, ImageScaleFilter scaleMethod, int32_t x, int32_t len, float sy, int32_t miny, int32_t maxy, int32_t n)
+{
+    int32_t i = 0;
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+    if (scaleMethod == _interpUpScaler) i = avxRasterUpScale(dst, image.buf32, image.stride, image.w, image.h, itransform->e11, itransform->e13, x, len, sy);
+    else if (scaleMethod == _interpDownScaler) i = avxRasterDownScale(dst, image.buf32, image.stride, image.w, itransform->e11, itransform->e13, x, len, miny, maxy, n);
+    else i = avxRasterNoScale(dst, image.buf32, image.stride, itransform->e11, itransform->e13, x, len, sy);
+#endif
+    if (scaleMethod == _interpUpScaler) _scalePixels<_interpUpScaler>(dst + i, image, itransform, x + i, len - i, sy, miny, maxy, n);
+    else if (scaleMethod == _interpDownScaler) _scalePixels<_interpDownScaler>(dst + i, image, itransform, x + i, len - i, sy, miny, maxy, n);
+    else _scalePixels<_interpNoScaler>(dst + i, image, itransform, x + i, len - i, sy, miny, maxy, n);
+}
+
+
+//The scaled images are axis-aligned, the source x depends on the output x only.
+//Narrow down [x0, x1) to the output pixels which sample the image, they are the same for every row.
+static bool _scaledRangeX(const SwImage& image, const Matrix* itransform, int32_t& x0, int32_t& x1)
+{
+    auto inside = [&](int32_t x) {
+        auto sx = x * itransform->e11 + itransform->e13 - 0.49f;
+        return !(sx <= -0.5f || (uint32_t)(sx + 0.5f) >= image.w);
+    };
+    while (x0 < x1 && !inside(x0)) ++x0;
+    while (x1 > x0 && !inside(x1 - 1)) --x1;
+    return x0 < x1;
+}
+
+
 /************************************************************************/
 /* Rect                                                                 */
 /************************************************************************/
@@ -441,7 +480,8 @@ static bool _rasterTranslucentRect(SwSurface* surface, const RenderRegion& bbox,
 #if defined(THORVG_AVX_VECTOR_SUPPORT)
     return avxRasterTranslucentRect(surface, bbox, c);
 #elif defined(THORVG_NEON_VECTOR_SUPPORT)
-    return neonRasterTranslucentRect(surface, bbox, c);
+    if (rasterSimdLevel == SimdLevel::NEON) return neonRasterTranslucentRect(surface, bbox, c);
+    return cRasterTranslucentRect(surface, bbox, c);
 #else
     return cRasterTranslucentRect(surface, bbox, c);
 #endif
@@ -621,7 +661,8 @@ static bool _rasterTranslucentRle(SwSurface* surface, const SwRle* rle, const Re
 #if defined(THORVG_AVX_VECTOR_SUPPORT)
     return avxRasterTranslucentRle(surface, rle, bbox, c);
 #elif defined(THORVG_NEON_VECTOR_SUPPORT)
-    return neonRasterTranslucentRle(surface, rle, bbox, c);
+    if (rasterSimdLevel == SimdLevel::NEON) return neonRasterTranslucentRle(surface, rle, bbox, c);
+    return cRasterTranslucentRle(surface, rle, bbox, c);
 #else
     return cRasterTranslucentRle(surface, rle, bbox, c);
 #endif
@@ -687,6 +728,8 @@ static bool _rasterRle(SwSurface* surface, SwRle* rle, const RenderRegion& bbox,
 /* RLE Scaled Image                                                     */
 /************************************************************************/
 
+#define SCALED_IMAGE_BATCH 256
+
 #define SCALED_IMAGE_RANGE_Y(y) \
     auto sy = (y) * itransform->e22 + itransform->e23 - 0.49f; \
     if (sy <= -0.5f || (uint32_t)(sy + 0.5f) >= image.h) continue; \
@@ -698,9 +741,11 @@ static bool _rasterRle(SwSurface* surface, SwRle* rle, const RenderRegion& bbox,
         if (maxy >= (int32_t)image.h) maxy = (int32_t)image.h; \
     }
 
-#define SCALED_IMAGE_RANGE_X \
-    auto sx = (x) * itransform->e11 + itransform->e13 - 0.49f; \
-    if (sx <= -0.5f || (uint32_t)(sx + 0.5f) >= image.w) continue; \
+//clip the span to the scaled range [x0, x1)
+#define SCALED_IMAGE_RANGE_SPAN(span) \
+    auto sx0 = std::max((int32_t)span->x, x0); \
+    auto sx1 = std::min((int32_t)span->x + (int32_t)span->len, x1); \
+    if (sx0 >= sx1) continue;
 
 static bool _rasterScaledMaskedRleImage(SwSurface* surface, const SwImage& image, const Matrix* itransform, const RenderRegion& bbox, uint8_t opacity)
 {
@@ -718,22 +763,29 @@ static bool _rasterScaledMattedRleImage(SwSurface* surface, const SwImage& image
 
     TVGLOG("SW_ENGINE", "Scaled Matted(%d) Rle Image", (int)surface->compositor->method);
 
+    int32_t x0 = 0, x1 = surface->w;
+    if (!_scaledRangeX(image, itransform, x0, x1)) return true;
+
     auto csize = surface->compositor->image.channelSize;
     auto alpha = surface->alpha(surface->compositor->method);
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
+    uint32_t buf[SCALED_IMAGE_BATCH];
 
     ARRAY_FOREACH(span, image.rle->spans) {
         SCALED_IMAGE_RANGE_Y(span->y)
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
-        auto cmp = &surface->compositor->image.buf8[(span->y * surface->compositor->image.stride + span->x) * csize];
+        SCALED_IMAGE_RANGE_SPAN(span)
+        auto dst = &surface->buf32[span->y * surface->stride + sx0];
+        auto cmp = &surface->compositor->image.buf8[(span->y * surface->compositor->image.stride + sx0) * csize];
         auto a = MULTIPLY(span->coverage, opacity);
-        for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst, cmp += csize) {
-            SCALED_IMAGE_RANGE_X
-            auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-            src = ALPHA_BLEND(src, (a == 255) ? alpha(cmp) : MULTIPLY(alpha(cmp), a));
-            *dst = src + ALPHA_BLEND(*dst, IA(src));
+        for (auto x = sx0; x < sx1; x += SCALED_IMAGE_BATCH) {
+            auto len = std::min(sx1 - x, SCALED_IMAGE_BATCH);
+            _scaleSpan(buf, image, itransform, scaleMethod, x, len, sy, miny, maxy, sampleSize);
+            for (auto src = buf; src < buf + len; ++src, ++dst, cmp += csize) {
+                auto tmp = ALPHA_BLEND(*src, (a == 255) ? alpha(cmp) : MULTIPLY(alpha(cmp), a));
+                *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+            }
         }
     }
     return true;
@@ -747,25 +799,30 @@ static bool _rasterScaledBlendingRleImage(SwSurface* surface, const SwImage& ima
         return false;
     }
 
+    int32_t x0 = 0, x1 = surface->w;
+    if (!_scaledRangeX(image, itransform, x0, x1)) return true;
+
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
+    uint32_t buf[SCALED_IMAGE_BATCH];
 
     ARRAY_FOREACH(span, image.rle->spans) {
         SCALED_IMAGE_RANGE_Y(span->y)
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
+        SCALED_IMAGE_RANGE_SPAN(span)
+        auto dst = &surface->buf32[span->y * surface->stride + sx0];
         auto alpha = MULTIPLY(span->coverage, opacity);
-        if (alpha == 255) {
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
-                SCALED_IMAGE_RANGE_X
-                auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-                *dst = INTERPOLATE(surface->blender(surface, rasterUnpremultiply(src), *dst), *dst, A(src));
-            }
-        } else {
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
-                SCALED_IMAGE_RANGE_X
-                auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-                *dst = INTERPOLATE(surface->blender(surface, rasterUnpremultiply(src), *dst), *dst, MULTIPLY(alpha, A(src)));
+        for (auto x = sx0; x < sx1; x += SCALED_IMAGE_BATCH) {
+            auto len = std::min(sx1 - x, SCALED_IMAGE_BATCH);
+            _scaleSpan(buf, image, itransform, scaleMethod, x, len, sy, miny, maxy, sampleSize);
+            if (alpha == 255) {
+                for (auto src = buf; src < buf + len; ++src, ++dst) {
+                    *dst = INTERPOLATE(surface->blender(surface, rasterUnpremultiply(*src), *dst), *dst, A(*src));
+                }
+            } else {
+                for (auto src = buf; src < buf + len; ++src, ++dst) {
+                    *dst = INTERPOLATE(surface->blender(surface, rasterUnpremultiply(*src), *dst), *dst, MULTIPLY(alpha, A(*src)));
+                }
             }
         }
     }
@@ -775,31 +832,38 @@ static bool _rasterScaledBlendingRleImage(SwSurface* surface, const SwImage& ima
 
 static bool _rasterScaledRleImage(SwSurface* surface, const SwImage& image, const Matrix* itransform, const RenderRegion& bbox, uint8_t opacity)
 {
+    int32_t x0 = 0, x1 = surface->w;
+    if (!_scaledRangeX(image, itransform, x0, x1)) return true;
+
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
+    uint32_t buf[SCALED_IMAGE_BATCH];
 
     if (surface->channelSize == sizeof(uint32_t)) {
         ARRAY_FOREACH(span, image.rle->spans) {
             SCALED_IMAGE_RANGE_Y(span->y)
-            auto dst = &surface->buf32[span->y * surface->stride + span->x];
+            SCALED_IMAGE_RANGE_SPAN(span)
+            auto dst = &surface->buf32[span->y * surface->stride + sx0];
             auto alpha = MULTIPLY(span->coverage, opacity);
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
-                SCALED_IMAGE_RANGE_X
-                auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-                if (alpha < 255) src = ALPHA_BLEND(src, alpha);
-                *dst = src + ALPHA_BLEND(*dst, IA(src));
+            for (auto x = sx0; x < sx1; x += SCALED_IMAGE_BATCH, dst += SCALED_IMAGE_BATCH) {
+                auto len = std::min(sx1 - x, SCALED_IMAGE_BATCH);
+                _scaleSpan(buf, image, itransform, scaleMethod, x, len, sy, miny, maxy, sampleSize);
+                rasterTranslucentPixel32(dst, buf, len, alpha);
             }
         }
     } else if (surface->channelSize == sizeof(uint8_t)) {
         ARRAY_FOREACH(span, image.rle->spans) {
             SCALED_IMAGE_RANGE_Y(span->y)
-            auto dst = &surface->buf8[span->y * surface->stride + span->x];
+            SCALED_IMAGE_RANGE_SPAN(span)
+            auto dst = &surface->buf8[span->y * surface->stride + sx0];
             auto alpha = MULTIPLY(span->coverage, opacity);
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
-                SCALED_IMAGE_RANGE_X
-                auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-                *dst = MULTIPLY(A(src), alpha);
+            for (auto x = sx0; x < sx1; x += SCALED_IMAGE_BATCH) {
+                auto len = std::min(sx1 - x, SCALED_IMAGE_BATCH);
+                _scaleSpan(buf, image, itransform, scaleMethod, x, len, sy, miny, maxy, sampleSize);
+                for (auto src = buf; src < buf + len; ++src, ++dst) {
+                    *dst = MULTIPLY(A(*src), alpha);
+                }
             }
         }
     }
@@ -908,9 +972,12 @@ static bool _rasterScaledMattedImage(SwSurface* surface, const SwImage& image, c
         return false;
     }
 
-    auto dbuffer = surface->buf32 + (bbox.min.y * surface->stride + bbox.min.x);
+    int32_t x0 = bbox.min.x, x1 = bbox.max.x;
+    if (!_scaledRangeX(image, itransform, x0, x1)) return true;
+
+    auto dbuffer = surface->buf32 + (bbox.min.y * surface->stride + x0);
     auto csize = surface->compositor->image.channelSize;
-    auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * surface->compositor->image.stride + bbox.min.x) * csize;
+    auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * surface->compositor->image.stride + x0) * csize;
     auto alpha = surface->alpha(surface->compositor->method);
 
     TVGLOG("SW_ENGINE", "Scaled Matted(%d) Image [Region: %d %d %d %d]", (int)surface->compositor->method, bbox.min.x, bbox.min.y, bbox.max.x - bbox.min.x, bbox.max.y - bbox.min.y);
@@ -918,19 +985,20 @@ static bool _rasterScaledMattedImage(SwSurface* surface, const SwImage& image, c
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
+    uint32_t buf[SCALED_IMAGE_BATCH];
 
-    for (auto y = bbox.min.y; y < bbox.max.y; ++y) {
+    for (auto y = bbox.min.y; y < bbox.max.y; ++y, dbuffer += surface->stride, cbuffer += surface->compositor->image.stride * csize) {
         SCALED_IMAGE_RANGE_Y(y)
         auto dst = dbuffer;
         auto cmp = cbuffer;
-        for (auto x = bbox.min.x; x < bbox.max.x; ++x, ++dst, cmp += csize) {
-            SCALED_IMAGE_RANGE_X
-            auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-            auto tmp = ALPHA_BLEND(src, opacity == 255 ? alpha(cmp) : MULTIPLY(opacity, alpha(cmp)));
-            *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+        for (auto x = x0; x < x1; x += SCALED_IMAGE_BATCH) {
+            auto len = std::min(x1 - x, SCALED_IMAGE_BATCH);
+            _scaleSpan(buf, image, itransform, scaleMethod, x, len, sy, miny, maxy, sampleSize);
+            for (auto src = buf; src < buf + len; ++src, ++dst, cmp += csize) {
+                auto tmp = ALPHA_BLEND(*src, opacity == 255 ? alpha(cmp) : MULTIPLY(opacity, alpha(cmp)));
+                *dst = tmp + ALPHA_BLEND(*dst, IA(tmp));
+            }
         }
-        dbuffer += surface->stride;
-        cbuffer += surface->compositor->image.stride * csize;
     }
     return true;
 }
@@ -943,18 +1011,24 @@ static bool _rasterScaledBlendingImage(SwSurface* surface, const SwImage& image,
         return false;
     }
 
-    auto dbuffer = surface->buf32 + (bbox.min.y * surface->stride + bbox.min.x);
+    int32_t x0 = bbox.min.x, x1 = bbox.max.x;
+    if (!_scaledRangeX(image, itransform, x0, x1)) return true;
+
+    auto dbuffer = surface->buf32 + (bbox.min.y * surface->stride + x0);
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
+    uint32_t buf[SCALED_IMAGE_BATCH];
 
     for (auto y = bbox.min.y; y < bbox.max.y; ++y, dbuffer += surface->stride) {
         SCALED_IMAGE_RANGE_Y(y)
         auto dst = dbuffer;
-        for (auto x = bbox.min.x; x < bbox.max.x; ++x, ++dst) {
-            SCALED_IMAGE_RANGE_X
-            auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-            *dst = INTERPOLATE(surface->blender(surface, rasterUnpremultiply(src), *dst), *dst, MULTIPLY(opacity, A(src)));
+        for (auto x = x0; x < x1; x += SCALED_IMAGE_BATCH) {
+            auto len = std::min(x1 - x, SCALED_IMAGE_BATCH);
+            _scaleSpan(buf, image, itransform, scaleMethod, x, len, sy, miny, maxy, sampleSize);
+            for (auto src = buf; src < buf + len; ++src, ++dst) {
+                *dst = INTERPOLATE(surface->blender(surface, rasterUnpremultiply(*src), *dst), *dst, MULTIPLY(opacity, A(*src)));
+            }
         }
     }
     return true;
@@ -963,45 +1037,46 @@ static bool _rasterScaledBlendingImage(SwSurface* surface, const SwImage& image,
 
 static bool _rasterScaledImage(SwSurface* surface, const SwImage& image, const Matrix* itransform, const RenderRegion& bbox, uint8_t opacity)
 {
+    int32_t x0 = bbox.min.x, x1 = bbox.max.x;
+    if (!_scaledRangeX(image, itransform, x0, x1)) return true;
+
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
+    uint32_t buf[SCALED_IMAGE_BATCH];
 
     //32bits channels
     if (surface->channelSize == sizeof(uint32_t)) {
-        auto buffer = surface->buf32 + (bbox.min.y * surface->stride + bbox.min.x);
+        auto buffer = surface->buf32 + (bbox.min.y * surface->stride + x0);
         for (auto y = bbox.min.y; y < bbox.max.y; ++y, buffer += surface->stride) {
             SCALED_IMAGE_RANGE_Y(y)
+            //scale into the target directly
+            if (image.alphaIgnored && opacity == 255) {
+                _scaleSpan(buffer, image, itransform, scaleMethod, x0, x1 - x0, sy, miny, maxy, sampleSize);
+                continue;
+            }
             auto dst = buffer;
-            if (opacity == 255) {
-                for (auto x = bbox.min.x; x < bbox.max.x; ++x, ++dst) {
-                    SCALED_IMAGE_RANGE_X
-                    auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-                    if (image.alphaIgnored) *dst = src;
-                    else *dst = src + ALPHA_BLEND(*dst, IA(src));
-                }
-            } else {
-                for (auto x = bbox.min.x; x < bbox.max.x; ++x, ++dst) {
-                    SCALED_IMAGE_RANGE_X
-                    auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-                    if (image.alphaIgnored) {
-                        *dst = INTERPOLATE(src, *dst, opacity);
-                    } else {
-                        src = ALPHA_BLEND(src, opacity);
-                        *dst = src + ALPHA_BLEND(*dst, IA(src));
-                    }
+            for (auto x = x0; x < x1; x += SCALED_IMAGE_BATCH, dst += SCALED_IMAGE_BATCH) {
+                auto len = std::min(x1 - x, SCALED_IMAGE_BATCH);
+                _scaleSpan(buf, image, itransform, scaleMethod, x, len, sy, miny, maxy, sampleSize);
+                if (image.alphaIgnored) {
+                    for (int32_t i = 0; i < len; ++i) dst[i] = INTERPOLATE(buf[i], dst[i], opacity);
+                } else {
+                    rasterTranslucentPixel32(dst, buf, len, opacity);
                 }
             }
         }
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        auto buffer = surface->buf8 + (bbox.min.y * surface->stride + bbox.min.x);
+        auto buffer = surface->buf8 + (bbox.min.y * surface->stride + x0);
         for (auto y = bbox.min.y; y < bbox.max.y; ++y, buffer += surface->stride) {
             SCALED_IMAGE_RANGE_Y(y)
             auto dst = buffer;
-            for (auto x = bbox.min.x; x < bbox.max.x; ++x, ++dst) {
-                SCALED_IMAGE_RANGE_X
-                auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
-                *dst = MULTIPLY(A(src), opacity);
+            for (auto x = x0; x < x1; x += SCALED_IMAGE_BATCH) {
+                auto len = std::min(x1 - x, SCALED_IMAGE_BATCH);
+                _scaleSpan(buf, image, itransform, scaleMethod, x, len, sy, miny, maxy, sampleSize);
+                for (auto src = buf; src < buf + len; ++src, ++dst) {
+                    *dst = MULTIPLY(A(*src), opacity);
+                }
             }
         }
     }
@@ -1329,39 +1404,43 @@ static bool _rasterRadialGradientRect(SwSurface* surface, const RenderRegion& bb
 /************************************************************************/
 
 template<typename fillMethod>
-static bool _rasterCompositeGradientMaskedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill, SwMask maskOp)
+static bool _rasterCompositeGradientMaskedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill, SwMask maskOp)
 {
-    auto span = rle->data();
     auto cstride = surface->compositor->image.stride;
     auto cbuffer = surface->compositor->image.buf8;
+    const SwSpan* end;
+    int32_t x, len;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto cmp = &cbuffer[span->y * cstride + span->x];
-        fillMethod()(fill, cmp, span->y, span->x, span->len, maskOp, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto cmp = &cbuffer[span->y * cstride + x];
+        fillMethod()(fill, cmp, span->y, x, len, maskOp, span->coverage);
     }
     return _compositeMaskImage(surface, surface->compositor->image, surface->compositor->bbox);
 }
 
 
 template<typename fillMethod>
-static bool _rasterDirectGradientMaskedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill, SwMask maskOp)
+static bool _rasterDirectGradientMaskedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill, SwMask maskOp)
 {
-    auto span = rle->data();
     auto cstride = surface->compositor->image.stride;
     auto cbuffer = surface->compositor->image.buf8;
     auto dbuffer = surface->buf8;
+    const SwSpan* end;
+    int32_t x, len;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto cmp = &cbuffer[span->y * cstride + span->x];
-        auto dst = &dbuffer[span->y * surface->stride + span->x];
-        fillMethod()(fill, dst, span->y, span->x, span->len, cmp, maskOp, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto cmp = &cbuffer[span->y * cstride + x];
+        auto dst = &dbuffer[span->y * surface->stride + x];
+        fillMethod()(fill, dst, span->y, x, len, cmp, maskOp, span->coverage);
     }
     return true;
 }
 
 
 template<typename fillMethod>
-static bool _rasterGradientMaskedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterGradientMaskedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     auto method = surface->compositor->method;
 
@@ -1369,61 +1448,68 @@ static bool _rasterGradientMaskedRle(SwSurface* surface, const SwRle* rle, const
 
     auto maskOp = _getMaskOp(method);
 
-    if (_direct(method)) return _rasterDirectGradientMaskedRle<fillMethod>(surface, rle, fill, maskOp);
-    else return _rasterCompositeGradientMaskedRle<fillMethod>(surface, rle, fill, maskOp);
+    if (_direct(method)) return _rasterDirectGradientMaskedRle<fillMethod>(surface, rle, bbox, fill, maskOp);
+    else return _rasterCompositeGradientMaskedRle<fillMethod>(surface, rle, bbox, fill, maskOp);
     return false;
 }
 
 
 template<typename fillMethod>
-static bool _rasterGradientMattedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterGradientMattedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     TVGLOG("SW_ENGINE", "Matted(%d) Rle Linear Gradient", (int)surface->compositor->method);
 
-    auto span = rle->data();
     auto csize = surface->compositor->image.channelSize;
     auto cbuffer = surface->compositor->image.buf8;
     auto alpha = surface->alpha(surface->compositor->method);
+    const SwSpan* end;
+    int32_t x, len;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
-        auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + span->x) * csize];
-        fillMethod()(fill, dst, span->y, span->x, span->len, cmp, alpha, csize, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto dst = &surface->buf32[span->y * surface->stride + x];
+        auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + x) * csize];
+        fillMethod()(fill, dst, span->y, x, len, cmp, alpha, csize, span->coverage);
     }
     return true;
 }
 
 
 template<typename fillMethod>
-static bool _rasterBlendingGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterBlendingGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
-        fillMethod()(surface, fill, dst, span->y, span->x, span->len, opBlendPreNormal, surface->blender, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto dst = &surface->buf32[span->y * surface->stride + x];
+        fillMethod()(surface, fill, dst, span->y, x, len, opBlendPreNormal, surface->blender, span->coverage);
     }
     return true;
 }
 
 
 template<typename fillMethod>
-static bool _rasterTranslucentGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterTranslucentGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
 
     //32 bits
     if (surface->channelSize == sizeof(uint32_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf32[span->y * surface->stride + span->x];
-            if (span->coverage == 255) fillMethod()(fill, dst, span->y, span->x, span->len, opBlendPreNormal, 255);
-            else fillMethod()(fill, dst, span->y, span->x, span->len, opBlendNormal, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf32[span->y * surface->stride + x];
+            if (span->coverage == 255) fillMethod()(fill, dst, span->y, x, len, opBlendPreNormal, 255);
+            else fillMethod()(fill, dst, span->y, x, len, opBlendNormal, span->coverage);
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf8[span->y * surface->stride + span->x];
-            fillMethod()(fill, dst, span->y, span->x, span->len, _opMaskAdd, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf8[span->y * surface->stride + x];
+            fillMethod()(fill, dst, span->y, x, len, _opMaskAdd, span->coverage);
         }
     }
     return true;
@@ -1431,23 +1517,26 @@ static bool _rasterTranslucentGradientRle(SwSurface* surface, const SwRle* rle,
 
 
 template<typename fillMethod>
-static bool _rasterSolidGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterSolidGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
 
     //32 bits
     if (surface->channelSize == sizeof(uint32_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf32[span->y * surface->stride + span->x];
-            if (span->coverage == 255) fillMethod()(fill, dst, span->y, span->x, span->len, opBlendSrcOver, 255);
-            else fillMethod()(fill, dst, span->y, span->x, span->len, opBlendInterp, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf32[span->y * surface->stride + x];
+            if (span->coverage == 255) fillMethod()(fill, dst, span->y, x, len, opBlendSrcOver, 255);
+            else fillMethod()(fill, dst, span->y, x, len, opBlendInterp, span->coverage);
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf8[span->y * surface->stride + span->x];
-            if (span->coverage == 255) fillMethod()(fill, dst, span->y, span->x, span->len, _opMaskNone, 255);
-            else fillMethod()(fill, dst, span->y, span->x, span->len, _opMaskAdd, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf8[span->y * surface->stride + x];
+            if (span->coverage == 255) fillMethod()(fill, dst, span->y, x, len, _opMaskNone, 255);
+            else fillMethod()(fill, dst, span->y, x, len, _opMaskAdd, span->coverage);
         }
     }
 
@@ -1455,31 +1544,31 @@ static bool _rasterSolidGradientRle(SwSurface* surface, const SwRle* rle, const
 }
 
 
-static bool _rasterLinearGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterLinearGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     if (_compositing(surface)) {
-        if (_matting(surface)) return _rasterGradientMattedRle<FillLinear>(surface, rle, fill);
-        else return _rasterGradientMaskedRle<FillLinear>(surface, rle, fill);
+        if (_matting(surface)) return _rasterGradientMattedRle<FillLinear>(surface, rle, bbox, fill);
+        else return _rasterGradientMaskedRle<FillLinear>(surface, rle, bbox, fill);
     } else if (_blending(surface)) {
-        return _rasterBlendingGradientRle<FillLinear>(surface, rle, fill);
+        return _rasterBlendingGradientRle<FillLinear>(surface, rle, bbox, fill);
     } else {
-        if (fill->translucent) return _rasterTranslucentGradientRle<FillLinear>(surface, rle, fill);
-        else return _rasterSolidGradientRle<FillLinear>(surface, rle, fill);
+        if (fill->translucent) return _rasterTranslucentGradientRle<FillLinear>(surface, rle, bbox, fill);
+        else return _rasterSolidGradientRle<FillLinear>(surface, rle, bbox, fill);
     }
     return false;
 }
 
 
-static bool _rasterRadialGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterRadialGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     if (_compositing(surface)) {
-        if (_matting(surface)) return _rasterGradientMattedRle<FillRadial>(surface, rle, fill);
-        else return _rasterGradientMaskedRle<FillRadial>(surface, rle, fill);
+        if (_matting(surface)) return _rasterGradientMattedRle<FillRadial>(surface, rle, bbox, fill);
+        else return _rasterGradientMaskedRle<FillRadial>(surface, rle, bbox, fill);
     } else if (_blending(surface)) {
-        return _rasterBlendingGradientRle<FillRadial>(surface, rle, fill);
+        return _rasterBlendingGradientRle<FillRadial>(surface, rle, bbox, fill);
     } else {
-        if (fill->translucent) return _rasterTranslucentGradientRle<FillRadial>(surface, rle, fill);
-        else return _rasterSolidGradientRle<FillRadial>(surface, rle, fill);
+        if (fill->translucent) return _rasterTranslucentGradientRle<FillRadial>(surface, rle, bbox, fill);
+        else return _rasterSolidGradientRle<FillRadial>(surface, rle, bbox, fill);
     }
     return false;
 }
@@ -1489,17 +1578,32 @@ static bool _rasterRadialGradientRle(SwSurface* surface, const SwRle* rle, const
 /* External Class Implementation                                        */
 /************************************************************************/
 
+SimdLevel rasterSimdSupport()
+{
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+    return avxSupport();
+#elif defined(THORVG_NEON_VECTOR_SUPPORT)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::None;
+#endif
+}
+
+
 void rasterTranslucentPixel32(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity)
 {
-    //TODO: Support SIMD accelerations
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+    avxRasterTranslucentPixels(dst, src, len, opacity);
+#else
     cRasterTranslucentPixels(dst, src, len, opacity);
+#endif
 }
 
 
 void rasterPixel32(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity)
 {
-    //TODO: Support SIMD accelerations
-    cRasterPixels(dst, src, len, opacity);
+    if (opacity == 255) cRasterPixels(dst, src, len, opacity);
+    else rasterTranslucentPixel32(dst, src, len, opacity);
 }
 
 
@@ -1508,7 +1612,8 @@ void rasterGrayscale8(uint8_t *dst, uint8_t val, uint32_t offset, int32_t len)
 #if defined(THORVG_AVX_VECTOR_SUPPORT)
     avxRasterGrayscale8(dst, val, offset, len);
 #elif defined(THORVG_NEON_VECTOR_SUPPORT)
-    neonRasterGrayscale8(dst, val, offset, len);
+    if (rasterSimdLevel == SimdLevel::NEON) neonRasterGrayscale8(dst, val, offset, len);
+    else cRasterPixels(dst, val, offset, len);
 #else
     cRasterPixels(dst, val, offset, len);
 #endif
@@ -1520,7 +1625,8 @@ void rasterPixel32(uint32_t *dst, uint32_t val, uint32_t offset, int32_t len)
 #if defined(THORVG_AVX_VECTOR_SUPPORT)
     avxRasterPixel32(dst, val, offset, len);
 #elif defined(THORVG_NEON_VECTOR_SUPPORT)
-    neonRasterPixel32(dst, val, offset, len);
+    if (rasterSimdLevel == SimdLevel::NEON) neonRasterPixel32(dst, val, offset, len);
+    else cRasterPixels(dst, val, offset, len);
 #else
     cRasterPixels(dst, val, offset, len);
 #endif
@@ -1711,8 +1817,8 @@ bool rasterGradientShape(SwSurface* surface, SwShape* shape, const RenderRegion&
         if (type == Type::LinearGradient) return _rasterLinearGradientRect(surface, bbox, shape->fill);
         else if (type == Type::RadialGradient)return _rasterRadialGradientRect(surface, bbox, shape->fill);
     } else if (shape->rle && shape->rle->valid()) {
-        if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->rle, shape->fill);
-        else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->rle, shape->fill);
+        if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->rle, bbox, shape->fill);
+        else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->rle, bbox, shape->fill);
     } return false;
 }
 
@@ -1728,8 +1834,8 @@ bool rasterGradientStroke(SwSurface* surface, SwShape* shape, const RenderRegion
     }
 
     auto type = fdata->type();
-    if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->strokeRle, shape->stroke->fill);
-    else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->strokeRle, shape->stroke->fill);
+    if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->strokeRle, bbox, shape->stroke->fill);
+    else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->strokeRle, bbox, shape->stroke->fill);
     return false;
 }
 
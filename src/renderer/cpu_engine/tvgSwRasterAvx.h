@@ -24,135 +24,446 @@
 
 #include <immintrin.h>
 
-#define N_32BITS_IN_128REG 4
-#define N_32BITS_IN_256REG 8
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#else
+    #include <cpuid.h>
+#endif
+
 
-static inline __m128i ALPHA_BLEND(__m128i c, __m128i a)
+static SimdLevel _avxDetect()
 {
-    //1. set the masks for the A/G and R/B channels
-    auto AG = _mm_set1_epi32(0xff00ff00);
-    auto RB = _mm_set1_epi32(0x00ff00ff);
+    uint32_t info[4] = {};  //eax, ebx, ecx, edx
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    __cpuid((int*)info, 1);
+#else
+    if (!__get_cpuid(1, &info[0], &info[1], &info[2], &info[3])) return SimdLevel::None;
+#endif
+    if (!(info[3] & (1 << 26))) return SimdLevel::None;                            //sse2
+    if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28))) return SimdLevel::SSE2;  //osxsave, avx
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    auto xcr0 = _xgetbv(0);
+    __cpuidex((int*)info, 7, 0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    uint64_t xcr0 = ((uint64_t)edx << 32) | eax;
+    if (!__get_cpuid_count(7, 0, &info[0], &info[1], &info[2], &info[3])) return SimdLevel::SSE2;
+#endif
+
+    //the os must preserve the ymm (and the zmm/opmask) registers
+    if ((xcr0 & 0x06) != 0x06 || !(info[1] & (1 << 5))) return SimdLevel::SSE2;                             //avx2
+    if ((xcr0 & 0xe6) == 0xe6 && (info[1] & (1 << 16)) && (info[1] & (1 << 30))) return SimdLevel::AVX512;  //avx512f, avx512bw
+    return SimdLevel::AVX2;
+}
 
-    //2. mask the alpha vector - originally quartet [a, a, a, a]
-    auto aAG = _mm_and_si128(a, AG);
-    auto aRB = _mm_and_si128(a, RB);
-
-    //3. calculate the alpha blending of the 2nd and 4th channel
-    //- mask the color vector
-    //- multiply it by the masked alpha vector
-    //- add the correction to compensate bit shifting used instead of dividing by 255
-    //- shift bits - corresponding to division by 256
-    auto even = _mm_and_si128(c, RB);
-    even = _mm_mullo_epi16(even, aRB);
-    even =_mm_add_epi16(even, RB);
-    even = _mm_srli_epi16(even, 8);
-
-    //4. calculate the alpha blending of the 1st and 3rd channel:
-    //- mask the color vector
-    //- multiply it by the corresponding masked alpha vector and store the high bits of the result
-    //- add the correction to compensate division by 256 instead of by 255 (next step)
-    //- remove the low 8 bits to mimic the division by 256
-    auto odd = _mm_and_si128(c, AG);
-    odd = _mm_mulhi_epu16(odd, aAG);
-    odd = _mm_add_epi16(odd, RB);
-    odd = _mm_and_si128(odd, AG);
-
-    //5. the final result
+
+static SimdLevel avxSupport()
+{
+    static auto level = _avxDetect();
+    return level;
+}
+
+
+/************************************************************************/
+/* SSE2                                                                 */
+/************************************************************************/
+
+/* The vector ALPHA_BLEND() works on the 16-bit lanes and gives the exact result of the scalar one,
+   so all the levels render identically. a holds (alpha + 1) in both 16-bit halves of every pixel. */
+
+AVX_TARGET("sse2")
+static inline __m128i _sse2AlphaBlend(__m128i c, __m128i a)
+{
+    auto RB = _mm_set1_epi32(0x00ff00ff);
+    auto even = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(c, RB), a), 8);
+    auto odd = _mm_andnot_si128(RB, _mm_mullo_epi16(_mm_srli_epi16(c, 8), a));
     return _mm_or_si128(odd, even);
 }
 
 
-static void avxRasterGrayscale8(uint8_t* dst, uint8_t val, uint32_t offset, int32_t len) 
+//(IA(c) + 1) of every pixel, laid out for _sse2AlphaBlend()
+AVX_TARGET("sse2")
+static inline __m128i _sse2IA(__m128i c)
+{
+    auto ia = _mm_sub_epi32(_mm_set1_epi32(256), _mm_srli_epi32(c, 24));
+    return _mm_or_si128(ia, _mm_slli_epi32(ia, 16));
+}
+
+
+AVX_TARGET("sse2")
+static void sse2RasterGrayscale8(uint8_t* dst, uint8_t val, int32_t len)
+{
+    auto vec = _mm_set1_epi8(val);
+    for (; len >= 16; len -= 16, dst += 16) _mm_storeu_si128((__m128i*)dst, vec);
+    while (len--) *dst++ = val;
+}
+
+
+AVX_TARGET("sse2")
+static void sse2RasterPixel32(uint32_t* dst, uint32_t val, int32_t len)
+{
+    auto vec = _mm_set1_epi32(val);
+    for (; len >= 4; len -= 4, dst += 4) _mm_storeu_si128((__m128i*)dst, vec);
+    while (len--) *dst++ = val;
+}
+
+
+//dst = src + ALPHA_BLEND(dst, ialpha)
+AVX_TARGET("sse2")
+static void sse2RasterTranslucentSpan(uint32_t* dst, uint32_t src, uint8_t ialpha, int32_t len)
+{
+    auto vsrc = _mm_set1_epi32(src);
+    auto va = _mm_set1_epi16(ialpha + 1);
+    for (; len >= 4; len -= 4, dst += 4) {
+        auto d = _mm_loadu_si128((__m128i*)dst);
+        _mm_storeu_si128((__m128i*)dst, _mm_add_epi32(vsrc, _sse2AlphaBlend(d, va)));
+    }
+    for (; len > 0; --len, ++dst) *dst = src + ALPHA_BLEND(*dst, ialpha);
+}
+
+
+AVX_TARGET("sse2")
+static void sse2RasterTranslucentPixels(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity)
+{
+    auto vo = _mm_set1_epi16(opacity + 1);
+    for (; len >= 4; len -= 4, dst += 4, src += 4) {
+        auto s = _mm_loadu_si128((__m128i*)src);
+        if (opacity < 255) s = _sse2AlphaBlend(s, vo);
+        auto d = _mm_loadu_si128((__m128i*)dst);
+        _mm_storeu_si128((__m128i*)dst, _mm_add_epi32(s, _sse2AlphaBlend(d, _sse2IA(s))));
+    }
+    cRasterTranslucentPixels(dst, src, len, opacity);
+}
+
+
+//2n x 2n mean kernel, the four channels are accumulated at once
+AVX_TARGET("sse2")
+static int32_t sse2RasterDownScale(uint32_t* dst, const uint32_t* img, uint32_t stride, uint32_t w, float e11, float e13, int32_t x, int32_t len, int32_t miny, int32_t maxy, int32_t n)
+{
+    auto zero = _mm_setzero_si128();
+    int32_t inc = (n / 2) + 1;
+    uint32_t c[4];
+
+    for (int32_t i = 0; i < len; ++i, ++x) {
+        auto sx = x * e11 + e13 - 0.49f;
+        int32_t minx = (int32_t)sx - n;
+        if (minx < 0) minx = 0;
+        int32_t maxx = (int32_t)sx + n;
+        if (maxx >= (int32_t)w) maxx = w;
+
+        auto sum = zero;
+        uint32_t cnt = 0;
+        auto src = img + minx + miny * stride;
+        for (auto y = miny; y < maxy; y += inc, src += (stride * inc)) {
+            auto p = src;
+            for (auto x = minx; x < maxx; x += inc, p += inc, ++cnt) {
+                sum = _mm_add_epi32(sum, _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*p), zero), zero));
+            }
+        }
+        _mm_storeu_si128((__m128i*)c, sum);
+        dst[i] = ((c[3] / cnt) << 24) | ((c[2] / cnt) << 16) | ((c[1] / cnt) << 8) | (c[0] / cnt);
+    }
+    return len;
+}
+
+
+/************************************************************************/
+/* AVX2                                                                 */
+/************************************************************************/
+
+AVX_TARGET("avx2")
+static inline __m256i _avx2AlphaBlend(__m256i c, __m256i a)
+{
+    auto RB = _mm256_set1_epi32(0x00ff00ff);
+    auto even = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_and_si256(c, RB), a), 8);
+    auto odd = _mm256_andnot_si256(RB, _mm256_mullo_epi16(_mm256_srli_epi16(c, 8), a));
+    return _mm256_or_si256(odd, even);
+}
+
+
+AVX_TARGET("avx2")
+static inline __m256i _avx2IA(__m256i c)
+{
+    auto ia = _mm256_sub_epi32(_mm256_set1_epi32(256), _mm256_srli_epi32(c, 24));
+    return _mm256_or_si256(ia, _mm256_slli_epi32(ia, 16));
+}
+
+
+AVX_TARGET("avx2")
+static void avx2RasterGrayscale8(uint8_t* dst, uint8_t val, int32_t len)
+{
+    auto vec = _mm256_set1_epi8(val);
+    for (; len >= 32; len -= 32, dst += 32) _mm256_storeu_si256((__m256i*)dst, vec);
+    sse2RasterGrayscale8(dst, val, len);
+}
+
+
+AVX_TARGET("avx2")
+static void avx2RasterPixel32(uint32_t* dst, uint32_t val, int32_t len)
+{
+    auto vec = _mm256_set1_epi32(val);
+    for (; len >= 8; len -= 8, dst += 8) _mm256_storeu_si256((__m256i*)dst, vec);
+    sse2RasterPixel32(dst, val, len);
+}
+
+
+AVX_TARGET("avx2")
+static void avx2RasterTranslucentSpan(uint32_t* dst, uint32_t src, uint8_t ialpha, int32_t len)
 {
-    dst += offset; 
+    auto vsrc = _mm256_set1_epi32(src);
+    auto va = _mm256_set1_epi16(ialpha + 1);
+    for (; len >= 8; len -= 8, dst += 8) {
+        auto d = _mm256_loadu_si256((__m256i*)dst);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_add_epi32(vsrc, _avx2AlphaBlend(d, va)));
+    }
+    sse2RasterTranslucentSpan(dst, src, ialpha, len);
+}
 
-    __m256i vecVal = _mm256_set1_epi8(val);
+
+AVX_TARGET("avx2")
+static void avx2RasterTranslucentPixels(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity)
+{
+    auto vo = _mm256_set1_epi16(opacity + 1);
+    for (; len >= 8; len -= 8, dst += 8, src += 8) {
+        auto s = _mm256_loadu_si256((__m256i*)src);
+        if (opacity < 255) s = _avx2AlphaBlend(s, vo);
+        auto d = _mm256_loadu_si256((__m256i*)dst);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_add_epi32(s, _avx2AlphaBlend(d, _avx2IA(s))));
+    }
+    sse2RasterTranslucentPixels(dst, src, len, opacity);
+}
+
+
+//the exact INTERPOLATE() with a per-lane a
+AVX_TARGET("avx2")
+static inline __m256i _avx2Interpolate(__m256i s, __m256i d, __m256i a)
+{
+    auto RB = _mm256_set1_epi32(0x00ff00ff);
+    auto AG = _mm256_set1_epi32(0xff00ff00);
+    auto ds = _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(s, 8), RB), _mm256_and_si256(_mm256_srli_epi32(d, 8), RB));
+    auto odd = _mm256_and_si256(_mm256_add_epi32(_mm256_mullo_epi32(ds, a), _mm256_and_si256(d, AG)), AG);
+    ds = _mm256_sub_epi32(_mm256_and_si256(s, RB), _mm256_and_si256(d, RB));
+    auto even = _mm256_and_si256(_mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(ds, a), 8), _mm256_and_si256(d, RB)), RB);
+    return _mm256_add_epi32(odd, even);
+}
+
+
+//the source x of the 8 output pixels from x, exactly as the scalar (x * e11 + e13 - 0.49f)
+AVX_TARGET("avx2")
+static inline __m256 _avx2ScaledX(__m256i x, __m256 e11, __m256 e13)
+{
+    return _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(x), e11), e13), _mm256_set1_ps(0.49f));
+}
+
+
+//Bilinear interpolation, returns the number of the scaled pixels
+AVX_TARGET("avx2")
+static int32_t avx2RasterUpScale(uint32_t* dst, const uint32_t* img, uint32_t stride, uint32_t w, uint32_t h, float e11, float e13, int32_t x, int32_t len, float sy)
+{
+    //the vertical terms are shared by the span
+    auto ry = (size_t)(sy);
+    auto ry2 = ry + 1;
+    if (ry2 >= h) ry2 = h - 1;
+    auto dy = _mm256_set1_epi32((sy > 0.0f) ? static_cast<uint8_t>((sy - ry) * 255.0f) : 0);
+    auto row1 = reinterpret_cast<const int*>(img + ry * stride);
+    auto row2 = reinterpret_cast<const int*>(img + ry2 * stride);
+
+    auto ve11 = _mm256_set1_ps(e11);
+    auto ve13 = _mm256_set1_ps(e13);
+    auto vx = _mm256_add_epi32(_mm256_set1_epi32(x), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    auto maxx = _mm256_set1_epi32(w - 1);
 
     int32_t i = 0;
-    for (; i <= len - 32; i += 32) {
-        _mm256_storeu_si256((__m256i*)(dst + i), vecVal);
+    for (; i + 8 <= len; i += 8, dst += 8) {
+        auto sx = _avx2ScaledX(vx, ve11, ve13);
+        auto rx = _mm256_cvttps_epi32(sx);
+        auto rx2 = _mm256_min_epi32(_mm256_add_epi32(rx, _mm256_set1_epi32(1)), maxx);
+        auto dx = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(sx, _mm256_cvtepi32_ps(rx)), _mm256_set1_ps(255.0f)));
+        dx = _mm256_and_si256(dx, _mm256_castps_si256(_mm256_cmp_ps(sx, _mm256_setzero_ps(), _CMP_GT_OQ)));
+
+        auto c1 = _mm256_i32gather_epi32(row1, rx, 4);
+        auto c2 = _mm256_i32gather_epi32(row1, rx2, 4);
+        auto c3 = _mm256_i32gather_epi32(row2, rx, 4);
+        auto c4 = _mm256_i32gather_epi32(row2, rx2, 4);
+        _mm256_storeu_si256((__m256i*)dst, _avx2Interpolate(_avx2Interpolate(c4, c3, dx), _avx2Interpolate(c2, c1, dx), dy));
+
+        vx = _mm256_add_epi32(vx, _mm256_set1_epi32(8));
     }
+    return i;
+}
 
-    for (; i < len; ++i) {
-        dst[i] = val;
+
+//Nearest interpolation, returns the number of the scaled pixels
+AVX_TARGET("avx2")
+static int32_t avx2RasterNoScale(uint32_t* dst, const uint32_t* img, uint32_t stride, float e11, float e13, int32_t x, int32_t len, float sy)
+{
+    auto row = reinterpret_cast<const int*>(img + uint32_t(sy) * stride);
+    auto ve11 = _mm256_set1_ps(e11);
+    auto ve13 = _mm256_set1_ps(e13);
+    auto vx = _mm256_add_epi32(_mm256_set1_epi32(x), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+    int32_t i = 0;
+    for (; i + 8 <= len; i += 8, dst += 8) {
+        auto rx = _mm256_cvttps_epi32(_avx2ScaledX(vx, ve11, ve13));
+        _mm256_storeu_si256((__m256i*)dst, _mm256_i32gather_epi32(row, rx, 4));
+        vx = _mm256_add_epi32(vx, _mm256_set1_epi32(8));
     }
+    return i;
+}
+
+
+/************************************************************************/
+/* AVX-512                                                              */
+/************************************************************************/
+
+AVX_TARGET("avx512f,avx512bw")
+static inline __m512i _avx512AlphaBlend(__m512i c, __m512i a)
+{
+    auto RB = _mm512_set1_epi32(0x00ff00ff);
+    auto even = _mm512_srli_epi16(_mm512_mullo_epi16(_mm512_and_si512(c, RB), a), 8);
+    auto odd = _mm512_maskz_andnot_epi32(AVX512_ALL, RB, _mm512_mullo_epi16(_mm512_srli_epi16(c, 8), a));
+    return _mm512_or_si512(odd, even);
+}
+
+
+AVX_TARGET("avx512f,avx512bw")
+static inline __m512i _avx512IA(__m512i c)
+{
+    auto ia = _mm512_sub_epi32(_mm512_set1_epi32(256), _mm512_maskz_srli_epi32(AVX512_ALL, c, 24));
+    return _mm512_or_si512(ia, _mm512_maskz_slli_epi32(AVX512_ALL, ia, 16));
+}
+
+
+AVX_TARGET("avx512f,avx512bw")
+static void avx512RasterGrayscale8(uint8_t* dst, uint8_t val, int32_t len)
+{
+    auto vec = _mm512_set1_epi8(val);
+    for (; len >= 64; len -= 64, dst += 64) _mm512_storeu_si512(dst, vec);
+    avx2RasterGrayscale8(dst, val, len);
 }
 
 
-static void avxRasterPixel32(uint32_t *dst, uint32_t val, uint32_t offset, int32_t len)
+AVX_TARGET("avx512f,avx512bw")
+static void avx512RasterPixel32(uint32_t* dst, uint32_t val, int32_t len)
 {
-    //1. calculate how many iterations we need to cover the length
-    uint32_t iterations = len / N_32BITS_IN_256REG;
-    uint32_t avxFilled = iterations * N_32BITS_IN_256REG;
+    auto vec = _mm512_set1_epi32(val);
+    for (; len >= 16; len -= 16, dst += 16) _mm512_storeu_si512(dst, vec);
+    avx2RasterPixel32(dst, val, len);
+}
 
-    //2. set the beginning of the array
-    dst += offset;
 
-    //3. fill the octets
-    for (uint32_t i = 0; i < iterations; ++i, dst += N_32BITS_IN_256REG) {
-        _mm256_storeu_si256((__m256i*)dst, _mm256_set1_epi32(val));
+AVX_TARGET("avx512f,avx512bw")
+static void avx512RasterTranslucentSpan(uint32_t* dst, uint32_t src, uint8_t ialpha, int32_t len)
+{
+    auto vsrc = _mm512_set1_epi32(src);
+    auto va = _mm512_set1_epi16(ialpha + 1);
+    for (; len >= 16; len -= 16, dst += 16) {
+        auto d = _mm512_loadu_si512(dst);
+        _mm512_storeu_si512(dst, _mm512_add_epi32(vsrc, _avx512AlphaBlend(d, va)));
     }
+    avx2RasterTranslucentSpan(dst, src, ialpha, len);
+}
+
 
-    //4. fill leftovers (in the first step we have to set the pointer to the place where the avx job is done)
-    int32_t leftovers = len - avxFilled;
-    while (leftovers--) *dst++ = val;
+AVX_TARGET("avx512f,avx512bw")
+static void avx512RasterTranslucentPixels(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity)
+{
+    auto vo = _mm512_set1_epi16(opacity + 1);
+    for (; len >= 16; len -= 16, dst += 16, src += 16) {
+        auto s = _mm512_loadu_si512(src);
+        if (opacity < 255) s = _avx512AlphaBlend(s, vo);
+        auto d = _mm512_loadu_si512(dst);
+        _mm512_storeu_si512(dst, _mm512_add_epi32(s, _avx512AlphaBlend(d, _avx512IA(s))));
+    }
+    avx2RasterTranslucentPixels(dst, src, len, opacity);
 }
 
 
-static bool avxRasterTranslucentRect(SwSurface* surface, const RenderRegion& bbox, const RenderColor& c)
+/************************************************************************/
+/* Dispatchers                                                          */
+/************************************************************************/
+
+static void avxRasterGrayscale8(uint8_t* dst, uint8_t val, uint32_t offset, int32_t len)
 {
-    auto h = bbox.h();
-    auto w = bbox.w();
+    switch (rasterSimdLevel) {
+        case SimdLevel::AVX512: avx512RasterGrayscale8(dst + offset, val, len); break;
+        case SimdLevel::AVX2: avx2RasterGrayscale8(dst + offset, val, len); break;
+        case SimdLevel::SSE2: sse2RasterGrayscale8(dst + offset, val, len); break;
+        default: cRasterPixels(dst, val, offset, len); break;
+    }
+}
 
-    //32bits channels
-    if (surface->channelSize == sizeof(uint32_t)) {
-        auto color = surface->join(c.r, c.g, c.b, c.a);
-        auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
 
-        uint32_t ialpha = 255 - c.a;
+static void avxRasterPixel32(uint32_t* dst, uint32_t val, uint32_t offset, int32_t len)
+{
+    switch (rasterSimdLevel) {
+        case SimdLevel::AVX512: avx512RasterPixel32(dst + offset, val, len); break;
+        case SimdLevel::AVX2: avx2RasterPixel32(dst + offset, val, len); break;
+        case SimdLevel::SSE2: sse2RasterPixel32(dst + offset, val, len); break;
+        default: cRasterPixels(dst, val, offset, len); break;
+    }
+}
 
-        auto avxColor = _mm_set1_epi32(color);
-        auto avxIalpha = _mm_set1_epi8(ialpha);
 
-        for (uint32_t y = 0; y < h; ++y) {
-            auto dst = &buffer[y * surface->stride];
+static void avxRasterTranslucentPixels(uint32_t* dst, uint32_t* src, uint32_t len, uint8_t opacity)
+{
+    switch (rasterSimdLevel) {
+        case SimdLevel::AVX512: avx512RasterTranslucentPixels(dst, src, len, opacity); break;
+        case SimdLevel::AVX2: avx2RasterTranslucentPixels(dst, src, len, opacity); break;
+        case SimdLevel::SSE2: sse2RasterTranslucentPixels(dst, src, len, opacity); break;
+        default: cRasterTranslucentPixels(dst, src, len, opacity); break;
+    }
+}
 
-            //1. fill the not aligned memory (for 128-bit registers a 16-bytes alignment is required)
-            auto notAligned = ((uintptr_t)dst & 0xf) / 4;
-            if (notAligned) {
-                notAligned = (N_32BITS_IN_128REG - notAligned > w ? w : N_32BITS_IN_128REG - notAligned);
-                for (uint32_t x = 0; x < notAligned; ++x, ++dst) {
-                    *dst = color + ALPHA_BLEND(*dst, ialpha);
-                }
-            }
 
-            //2. fill the aligned memory - N_32BITS_IN_128REG pixels processed at once
-            uint32_t iterations = (w - notAligned) / N_32BITS_IN_128REG;
-            uint32_t avxFilled = iterations * N_32BITS_IN_128REG;
-            auto avxDst = (__m128i*)dst;
-            for (uint32_t x = 0; x < iterations; ++x, ++avxDst) {
-                *avxDst = _mm_add_epi32(avxColor, ALPHA_BLEND(*avxDst, avxIalpha));
-            }
+//The scalers return the number of the processed pixels, the rest is left to the scalar ones.
+//The AVX-512 level shares the AVX2 scalers, the wider gathers don't pay off for the image rows.
 
-            //3. fill the remaining pixels
-            int32_t leftovers = w - notAligned - avxFilled;
-            dst += avxFilled;
-            while (leftovers--) {
-                *dst = color + ALPHA_BLEND(*dst, ialpha);
-                dst++;
-            }
-        }
-    //8bit grayscale
-    } else if (surface->channelSize == sizeof(uint8_t)) {
-        TVGLOG("SW_ENGINE", "Require AVX Optimization, Channel Size = %d", surface->channelSize);
-        auto buffer = surface->buf8 + (bbox.min.y * surface->stride) + bbox.min.x;
-        auto ialpha = ~c.a;
-        for (uint32_t y = 0; y < h; ++y) {
-            auto dst = &buffer[y * surface->stride];
-            for (uint32_t x = 0; x < w; ++x, ++dst) {
-                *dst = c.a + MULTIPLY(*dst, ialpha);
-            }
-        }
+static int32_t avxRasterUpScale(uint32_t* dst, const uint32_t* img, uint32_t stride, uint32_t w, uint32_t h, float e11, float e13, int32_t x, int32_t len, float sy)
+{
+    if (rasterSimdLevel != SimdLevel::AVX2 && rasterSimdLevel != SimdLevel::AVX512) return 0;
+    return avx2RasterUpScale(dst, img, stride, w, h, e11, e13, x, len, sy);
+}
+
+
+static int32_t avxRasterNoScale(uint32_t* dst, const uint32_t* img, uint32_t stride, float e11, float e13, int32_t x, int32_t len, float sy)
+{
+    if (rasterSimdLevel != SimdLevel::AVX2 && rasterSimdLevel != SimdLevel::AVX512) return 0;
+    return avx2RasterNoScale(dst, img, stride, e11, e13, x, len, sy);
+}
+
+
+static int32_t avxRasterDownScale(uint32_t* dst, const uint32_t* img, uint32_t stride, uint32_t w, float e11, float e13, int32_t x, int32_t len, int32_t miny, int32_t maxy, int32_t n)
+{
+    if (rasterSimdLevel == SimdLevel::None) return 0;
+    return sse2RasterDownScale(dst, img, stride, w, e11, e13, x, len, miny, maxy, n);
+}
+
+
+static void _avxRasterTranslucentSpan(uint32_t* dst, uint32_t src, uint8_t ialpha, int32_t len)
+{
+    switch (rasterSimdLevel) {
+        case SimdLevel::AVX512: avx512RasterTranslucentSpan(dst, src, ialpha, len); break;
+        case SimdLevel::AVX2: avx2RasterTranslucentSpan(dst, src, ialpha, len); break;
+        default: sse2RasterTranslucentSpan(dst, src, ialpha, len); break;
+    }
+}
+
+
+static bool avxRasterTranslucentRect(SwSurface* surface, const RenderRegion& bbox, const RenderColor& c)
+{
+    //TODO: 8bit grayscale
+    if (surface->channelSize != sizeof(uint32_t) || rasterSimdLevel == SimdLevel::None) return cRasterTranslucentRect(surface, bbox, c);
+
+    auto color = surface->join(c.r, c.g, c.b, c.a);
+    auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+    auto ialpha = 255 - c.a;
+
+    for (uint32_t y = 0; y < bbox.h(); ++y) {
+        _avxRasterTranslucentSpan(&buffer[y * surface->stride], color, ialpha, bbox.w());
     }
     return true;
 }
@@ -160,71 +471,19 @@ static bool avxRasterTranslucentRect(SwSurface* surface, const RenderRegion& bbo
 
 static bool avxRasterTranslucentRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const RenderColor& c)
 {
+    //TODO: 8bit grayscale
+    if (surface->channelSize != sizeof(uint32_t) || rasterSimdLevel == SimdLevel::None) return cRasterTranslucentRle(surface, rle, bbox, c);
+
     const SwSpan* end;
     int32_t x, len;
+    auto color = surface->join(c.r, c.g, c.b, c.a);
 
-    //32bit channels
-    if (surface->channelSize == sizeof(uint32_t)) {
-        auto color = surface->join(c.r, c.g, c.b, c.a);
-        uint32_t src;
-
-        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
-            if (!span->fetch(bbox, x, len)) continue;
-            if (span->coverage < 255) src = ALPHA_BLEND(color, span->coverage);
-            else src = color;
-
-            auto dst = &surface->buf32[span->y * surface->stride + x];
-            auto ialpha = IA(src);
-
-            //1. fill the not aligned memory (for 128-bit registers a 16-bytes alignment is required)
-            int32_t notAligned = ((uintptr_t)dst & 0xf) / 4;
-            if (notAligned) {
-                notAligned = (N_32BITS_IN_128REG - notAligned > len ? len : N_32BITS_IN_128REG - notAligned);
-                for (auto x = 0; x < notAligned; ++x, ++dst) {
-                    *dst = src + ALPHA_BLEND(*dst, ialpha);
-                }
-            }
-
-            //2. fill the aligned memory using avx - N_32BITS_IN_128REG pixels processed at once
-            //In order to avoid unnecessary avx variables declarations a check is made whether there are any iterations at all
-            int32_t iterations = (len - notAligned) / N_32BITS_IN_128REG;
-            int32_t avxFilled = 0;
-            if (iterations > 0) {
-                auto avxSrc = _mm_set1_epi32(src);
-                auto avxIalpha = _mm_set1_epi8(ialpha);
-
-                avxFilled = iterations * N_32BITS_IN_128REG;
-                auto avxDst = (__m128i*)dst;
-                for (auto x = 0; x < iterations; ++x, ++avxDst) {
-                    *avxDst = _mm_add_epi32(avxSrc, ALPHA_BLEND(*avxDst, avxIalpha));
-                }
-            }
-
-            //3. fill the remaining pixels
-            auto leftovers = len - notAligned - avxFilled;
-            dst += avxFilled;
-            while (leftovers--) {
-                *dst = src + ALPHA_BLEND(*dst, ialpha);
-                dst++;
-            }
-        }
-    //8bit grayscale
-    } else if (surface->channelSize == sizeof(uint8_t)) {
-        TVGLOG("SW_ENGINE", "Require AVX Optimization, Channel Size = %d", surface->channelSize);
-        uint8_t src;
-        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
-            if (!span->fetch(bbox, x, len)) continue;
-            auto dst = &surface->buf8[span->y * surface->stride + x];
-            if (span->coverage < 255) src = MULTIPLY(span->coverage, c.a);
-            else src = c.a;
-            auto ialpha = ~c.a;
-            for (auto x = 0; x < len; ++x, ++dst) {
-                *dst = src + MULTIPLY(*dst, ialpha);
-            }
-        }
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto src = (span->coverage < 255) ? ALPHA_BLEND(color, span->coverage) : color;
+        _avxRasterTranslucentSpan(&surface->buf32[span->y * surface->stride + x], src, IA(src), len);
     }
     return true;
 }
 
-
 #endif
@@ -32,8 +32,12 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+//the tiles span the full width, the gradient spans are stepped from their beginnings and mustn't be split horizontally
+#define SW_TILE_ROWS 64
+
 static int32_t _rendererCnt = -1;
 static StrictKey _rendererMtx;
+static bool _simdForced = false;  //the user stepped down the simd level
 
 struct SwTask : Task
 {
@@ -84,7 +88,9 @@ struct SwTask : Task
         return true;
     }
 
-    virtual bool clip(SwRle* target) = 0;
+    virtual bool clip(SwRle* target, SwArena* arena) = 0;
+    virtual void raster(SwSurface* surface, const RenderRegion& region) = 0;   //rasterize within the given region
+    virtual bool tileable() = 0;   //safe to be rasterized in parallel with the other tiles?
     virtual ~SwTask() {}
 };
 
@@ -117,14 +123,57 @@ struct SwShapeTask : SwTask
         return (rshape->stroke->width * sqrt(transform.e11 * transform.e11 + transform.e12 * transform.e12));
     }
 
-    bool clip(SwRle* target) override
+    bool clip(SwRle* target, SwArena* arena) override
     {
-        if (shape.strokeRle) return rleClip(target, shape.strokeRle);
+        if (shape.strokeRle) return rleClip(target, shape.strokeRle, arena);
         if (shape.fastTrack) return rleClip(target, &curBox);
-        if (shape.rle) return rleClip(target, shape.rle);
+        if (shape.rle) return rleClip(target, shape.rle, arena);
         return false;
     }
 
+    void raster(SwSurface* surface, const RenderRegion& region) override
+    {
+        auto fill = [&]() {
+            if (!shape.bbox.intersected(region)) return;
+            auto bbox = RenderRegion::intersect(shape.bbox, region);
+            if (auto fill = rshape->fill) {
+                rasterGradientShape(surface, &shape, bbox, fill, opacity);
+            } else {
+                RenderColor c;
+                rshape->fillColor(&c.r, &c.g, &c.b, &c.a);
+                c.a = MULTIPLY(opacity, c.a);
+                if (c.a > 0) rasterShape(surface, &shape, bbox, c);
+            }
+        };
+
+        auto stroke = [&]() {
+            if (!rshape->stroke || !curBox.intersected(region)) return;
+            auto bbox = RenderRegion::intersect(curBox, region);
+            if (auto strokeFill = rshape->strokeFill()) {
+                rasterGradientStroke(surface, &shape, bbox, strokeFill, opacity);
+            } else {
+                RenderColor c;
+                if (rshape->strokeFill(&c.r, &c.g, &c.b, &c.a)) {
+                    c.a = MULTIPLY(opacity, c.a);
+                    if (c.a > 0) rasterStroke(surface, &shape, bbox, c);
+                }
+            }
+        };
+
+        if (rshape->strokeFirst()) {
+            stroke();
+            fill();
+        } else {
+            fill();
+            stroke();
+        }
+    }
+
+    bool tileable() override
+    {
+        return true;
+    }
+
     void run(unsigned tid) override
     {
         auto strokeWidth = validStrokeWidth(clipper);
@@ -136,7 +185,13 @@ struct SwShapeTask : SwTask
             shapeReset(shape);
             if (rshape->fill || rshape->color.a > 0 || clipper) {
                 auto composite = clips.count > 0 ? true : false;
-                if (!shapeGenRle(shape, rshape, transform, clipBox, curBox, renderer->mpool, tid, composite, antialiasing(strokeWidth))) {
+                //the small texts are composed of the cached glyph coverages
+                if (!clipper && renderer->antiAlias && shapeGlyphCachable(rshape, transform)) {
+                    if (!shapeGenGlyphRle(shape, rshape, transform, clipBox, curBox, renderer->mpool, tid)) {
+                        updateFill = false;
+                        curBox.reset();
+                    }
+                } else if (!shapeGenRle(shape, rshape, transform, clipBox, curBox, renderer->mpool, tid, composite, antialiasing(strokeWidth), renderer->accumulate)) {
                     updateFill = false;
                     curBox.reset();
                 }
@@ -149,7 +204,7 @@ struct SwShapeTask : SwTask
         //Stroke
         if (strokeWidth > 0.0f) {
             auto updateStroke = updateShape || (flags[0] & RenderUpdateFlag::Stroke);
-            if (updateStroke && !shapeGenStrokeRle(shape, rshape, transform, clipBox, curBox, renderer->mpool, tid, renderer->antiAlias)) goto err;
+            if (updateStroke && !shapeGenStrokeRle(shape, rshape, transform, clipBox, curBox, renderer->mpool, tid, renderer->antiAlias, renderer->accumulate)) goto err;
             auto ctable = flags[0] & RenderUpdateFlag::GradientStroke;
             if (ctable || flags[0] & RenderUpdateFlag::Transform) {
                 if (!shapeGenFillColors(shape.stroke->fill, rshape->strokeFill(), transform, renderer->surface, opacity, ctable)) goto err;
@@ -163,8 +218,9 @@ struct SwShapeTask : SwTask
         //Clip Path
         ARRAY_FOREACH(p, clips) {
             auto clipper = static_cast<SwTask*>(*p);
-            auto clipShapeRle = shape.rle ? clipper->clip(shape.rle) : true;
-            auto clipStrokeRle = shape.strokeRle ? clipper->clip(shape.strokeRle) : true;
+            auto arena = renderer->mpool->arena(tid);
+            auto clipShapeRle = shape.rle ? clipper->clip(shape.rle, arena) : true;
+            auto clipStrokeRle = shape.strokeRle ? clipper->clip(shape.strokeRle, arena) : true;
             if (!clipShapeRle || !clipStrokeRle) goto err;
         }
 
@@ -190,12 +246,46 @@ struct SwImageTask : SwTask
         imageFree(image);
     }
 
-    bool clip(SwRle* target) override
+    bool clip(SwRle* target, SwArena* arena) override
     {
         TVGERR("SW_ENGINE", "Image is used as ClipPath?");
         return true;
     }
 
+    void raster(SwSurface* surface, const RenderRegion& region) override
+    {
+        auto bbox = RenderRegion::intersect(curBox, region);
+        if (bbox.invalid() || bbox.x() >= surface->w || bbox.y() >= surface->h) return;
+
+        //RLE Image
+        if (image.rle) {
+            if (image.rle->invalid()) return;
+            if (image.direct) rasterDirectRleImage(surface, image, bbox, opacity);
+            else if (image.scaled) rasterScaledRleImage(surface, image, transform, bbox, opacity);
+            else {
+                //create a intermediate buffer for rle clipping
+                auto cmp = renderer->request(sizeof(pixel_t), false);
+                cmp->compositor->method = MaskMethod::None;
+                cmp->compositor->valid = true;
+                cmp->compositor->image.rle = image.rle;
+                rasterClear(cmp, bbox.x(), bbox.y(), bbox.w(), bbox.h());
+                rasterTexmapPolygon(cmp, image, transform, bbox, 255);
+                rasterDirectRleImage(surface, cmp->compositor->image, bbox, opacity);
+            }
+        //Whole Image
+        } else {
+            if (image.direct) rasterDirectImage(surface, image, bbox, opacity);
+            else if (image.scaled) rasterScaledImage(surface, image, transform, bbox, opacity);
+            else rasterTexmapPolygon(surface, image, transform, bbox, opacity);
+        }
+    }
+
+    //the texture mapper and the intermediate rle buffer are not thread-safe. the scaled rle image doesn't clip the spans by the region.
+    bool tileable() override
+    {
+        return image.rle ? image.direct : (image.direct || image.scaled);
+    }
+
     void run(unsigned tid) override
     {
         //Convert colorspace if it's not aligned.
@@ -223,7 +313,7 @@ struct SwImageTask : SwTask
                 if (image.rle) {
                     ARRAY_FOREACH(p, clips) {
                         auto clipper = static_cast<SwTask*>(*p);
-                        if (!clipper->clip(image.rle)) goto err;
+                        if (!clipper->clip(image.rle, renderer->mpool->arena(tid))) goto err;
                     }
                     if (!nodirty) dirtyRegion->add(prvBox, curBox);
                     return;
@@ -240,12 +330,35 @@ struct SwImageTask : SwTask
 };
 
 
+struct SwTile : Task
+{
+    struct Command
+    {
+        SwTask* task;
+        RenderRegion region;
+    };
+
+    SwSurface* surface = nullptr;      //target surface of the current flush
+    RenderRegion bbox;                 //tile region on the screen
+    Array<Command> cmds;               //binned draw commands in the paint order
+
+    void run(unsigned tid) override
+    {
+        ARRAY_FOREACH(p, cmds) {
+            p->task->raster(surface, RenderRegion::intersect(p->region, bbox));
+        }
+        cmds.clear();
+    }
+};
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
 
 SwRenderer::~SwRenderer()
 {
+    clearTiles();
     clearCompositors();
 
     delete(surface);
@@ -268,6 +381,9 @@ bool SwRenderer::clear()
 
 bool SwRenderer::sync()
 {
+    //draw the remaining commands if the rendering was not finished.
+    flush();
+
     //clear if the rendering was not triggered.
     ARRAY_FOREACH(p, tasks) {
         (*p)->done();
@@ -283,6 +399,7 @@ Result SwRenderer::target(pixel_t* data, uint32_t stride, uint32_t w, uint32_t h
 {
     if (!data || stride == 0 || w == 0 || h == 0 || w > stride) return Result::InvalidArguments;
 
+    flush();
     clearCompositors();
 
     if (!surface) surface = new SwSurface;
@@ -297,6 +414,19 @@ Result SwRenderer::target(pixel_t* data, uint32_t stride, uint32_t w, uint32_t h
 
     dirtyRegion.init(w, h);
 
+    //build up the tile bins
+    if (tiled) {
+        clearTiles();
+        auto rows = (h + SW_TILE_ROWS - 1) / SW_TILE_ROWS;
+        tiles.reserve(rows);
+        for (uint32_t y = 0; y < rows; ++y) {
+            auto tile = new SwTile;
+            tile->bbox.min = {0, int32_t(y * SW_TILE_ROWS)};
+            tile->bbox.max = {int32_t(w), int32_t(std::min(h, (y + 1) * SW_TILE_ROWS))};
+            tiles.push(tile);
+        }
+    }
+
     fulldraw = true;  //reset the screen
 
     return rasterCompositor(surface);
@@ -347,8 +477,72 @@ void SwRenderer::clearCompositors()
 }
 
 
+void SwRenderer::clearTiles()
+{
+    ARRAY_FOREACH(p, tiles) delete(*p);
+    tiles.reset();
+    binned = false;
+}
+
+
+void SwRenderer::flush()
+{
+    if (!binned) return;
+
+    ARRAY_FOREACH(p, tiles) {
+        if ((*p)->cmds.empty()) continue;
+        (*p)->surface = surface;
+        TaskScheduler::request(*p);
+    }
+    ARRAY_FOREACH(p, tiles) (*p)->done();
+
+    binned = false;
+}
+
+
+void SwRenderer::draw(SwTask* task, const RenderRegion& region)
+{
+    //bin the command to the overlapped tiles if the current target allows per-tile rasterization
+    if (tiled && task->tileable() && !(surface->compositor && surface->compositor->method != MaskMethod::None)) {
+        auto rows = (surface->h + SW_TILE_ROWS - 1) / SW_TILE_ROWS;
+        if (rows == tiles.count && !tiles.empty() && uint32_t(tiles.last()->bbox.max.x) == surface->w) {
+            auto bbox = RenderRegion::intersect(region, {{0, 0}, {int32_t(surface->w), int32_t(surface->h)}});
+            if (bbox.invalid()) return;
+            for (auto y = bbox.min.y / SW_TILE_ROWS; y <= (bbox.max.y - 1) / SW_TILE_ROWS; ++y) {
+                tiles[y]->cmds.push({task, bbox});
+            }
+            binned = true;
+            return;
+        }
+    }
+
+    //the pending commands must be drawn prior to this one
+    flush();
+    task->raster(surface, region);
+}
+
+
+void SwRenderer::rasterize(SwTask* task, const RenderRegion& bbox)
+{
+    //full scene or partial rendering
+    if (fulldraw || task->nodirty || task->pushed || dirtyRegion.deactivated()) {
+        draw(task, bbox);
+    } else if (bbox.valid()) {
+        for (int idx = 0; idx < RenderDirtyRegion::PARTITIONING; ++idx) {
+            if (!dirtyRegion.partition(idx).intersected(bbox)) continue;
+            ARRAY_FOREACH(p, dirtyRegion.get(idx)) {
+                if (bbox.max.x <= p->min.x) break;   //dirtyRegion is sorted in x order
+                if (bbox.intersected(*p)) draw(task, RenderRegion::intersect(bbox, *p));
+            }
+        }
+    }
+}
+
+
 bool SwRenderer::postRender()
 {
+    flush();
+
     //Unmultiply alpha if needed
     if (surface->cs == ColorSpace::ABGR8888S || surface->cs == ColorSpace::ARGB8888S) {
         rasterUnpremultiply(surface);
@@ -381,49 +575,8 @@ bool SwRenderer::renderImage(RenderData data)
     if (!task) return false;
     task->done();
 
-    if (task->valid) {
-        auto raster = [&](SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity) {
-            if (bbox.invalid() || bbox.x() >= surface->w || bbox.y() >= surface->h) return true;
-
-            //RLE Image
-            if (image.rle) {
-                if (image.rle->invalid()) return true;
-                if (image.direct) return rasterDirectRleImage(surface, image, bbox, opacity);
-                else if (image.scaled) return rasterScaledRleImage(surface, image, transform, bbox, opacity);
-                else {
-                    //create a intermediate buffer for rle clipping
-                    auto cmp = request(sizeof(pixel_t), false);
-                    cmp->compositor->method = MaskMethod::None;
-                    cmp->compositor->valid = true;
-                    cmp->compositor->image.rle = image.rle;
-                    rasterClear(cmp, bbox.x(), bbox.y(), bbox.w(), bbox.h());
-                    rasterTexmapPolygon(cmp, image, transform, bbox, 255);
-                    return rasterDirectRleImage(surface, cmp->compositor->image, bbox, opacity);
-                }
-            //Whole Image
-            } else {
-                if (image.direct) return rasterDirectImage(surface, image, bbox, opacity);
-                else if (image.scaled) return rasterScaledImage(surface, image, transform, bbox, opacity);
-                else return rasterTexmapPolygon(surface, image, transform, bbox, opacity);
-            }
-        };
+    if (task->valid) rasterize(task, task->curBox);
 
-        //full scene or partial rendering
-        if (fulldraw || task->nodirty || task->pushed || dirtyRegion.deactivated()) {
-            raster(surface, task->image, task->transform, task->curBox, task->opacity);
-        } else if (task->curBox.valid()) {
-            for (int idx = 0; idx < RenderDirtyRegion::PARTITIONING; ++idx) {
-                if (!dirtyRegion.partition(idx).intersected(task->curBox)) continue;
-                ARRAY_FOREACH(p, dirtyRegion.get(idx)) {
-                    if (task->curBox.max.x <= p->min.x) break;   //dirtyRegion is sorted in x order
-                    if (task->curBox.intersected(*p)) {
-                        auto bbox = RenderRegion::intersect(task->curBox, *p);
-                        raster(surface, task->image, task->transform, bbox, task->opacity);
-                    }
-                }
-            }
-        }
-    }
     return task->complete();
 }
 
@@ -435,53 +588,9 @@ bool SwRenderer::renderShape(RenderData data)
     task->done();
 
     if (task->valid) {
-        auto fill = [](SwShapeTask* task, SwSurface* surface, const RenderRegion& bbox) {
-            if (auto fill = task->rshape->fill) {
-                rasterGradientShape(surface, &task->shape, bbox, fill, task->opacity);
-            } else {
-                RenderColor c;
-                task->rshape->fillColor(&c.r, &c.g, &c.b, &c.a);
-                c.a = MULTIPLY(task->opacity, c.a);
-                if (c.a > 0) rasterShape(surface, &task->shape, bbox, c);
-            }
-        };
-
-        auto stroke = [](SwShapeTask* task, SwSurface* surface, const RenderRegion& bbox) {
-            if (auto strokeFill = task->rshape->strokeFill()) {
-                rasterGradientStroke(surface, &task->shape, bbox, strokeFill, task->opacity);
-            } else {
-                RenderColor c;
-                if (task->rshape->strokeFill(&c.r, &c.g, &c.b, &c.a)) {
-                    c.a = MULTIPLY(task->opacity, c.a);
-                    if (c.a > 0) rasterStroke(surface, &task->shape, bbox, c);
-                }
-            }
-        };
-
-        //full scene or partial rendering
-        if (fulldraw || task->nodirty || task->pushed || dirtyRegion.deactivated()) {
-            if (task->rshape->strokeFirst()) {
-                stroke(task, surface, task->curBox);
-                fill(task, surface, task->shape.bbox);
-            } else {
-                fill(task, surface, task->shape.bbox);
-                stroke(task, surface, task->curBox);
-            }
-        } else if (task->curBox.valid()) {
-            for (int idx = 0; idx < RenderDirtyRegion::PARTITIONING; ++idx) {
-                if (!dirtyRegion.partition(idx).intersected(task->curBox)) continue;
-                ARRAY_FOREACH(p, dirtyRegion.get(idx)) {
-                    if (task->curBox.max.x <= p->min.x) break;   //dirtyRegion is sorted in x order
-                    if (task->rshape->strokeFirst()) {
-                        if (task->rshape->stroke && task->curBox.intersected(*p)) stroke(task, surface, RenderRegion::intersect(task->curBox, *p));
-                        if (task->shape.bbox.intersected(*p)) fill(task, surface, RenderRegion::intersect(task->shape.bbox, *p));
-                    } else {
-                        if (task->shape.bbox.intersected(*p)) fill(task, surface, RenderRegion::intersect(task->shape.bbox, *p));
-                        if (task->rshape->stroke && task->curBox.intersected(*p)) stroke(task, surface, RenderRegion::intersect(task->curBox, *p));
-                    }
-                }
-            }
-        }
+        //the stroke region may not cover the whole fill region
+        auto bbox = task->shape.bbox.valid() ? RenderRegion::add(task->curBox, task->shape.bbox) : task->curBox;
+        rasterize(task, bbox);
     }
     return task->complete();
 }
@@ -490,6 +599,7 @@ bool SwRenderer::renderShape(RenderData data)
 bool SwRenderer::blend(BlendMethod method)
 {
     if (surface->blendMethod == method) return true;
+    flush();
     surface->blendMethod = method;
 
     switch (method) {
@@ -561,6 +671,8 @@ bool SwRenderer::beginComposite(RenderCompositor* cmp, MaskMethod method, uint8_
     if (!cmp) return false;
     auto p = static_cast<SwCompositor*>(cmp);
 
+    flush();
+
     p->method = method;
     p->opacity = opacity;
 
@@ -609,7 +721,7 @@ SwSurface* SwRenderer::request(int channelSize, bool square)
         //Inherits attributes from main surface
         cmp = new SwSurface(surface);
         cmp->compositor = new SwCompositor;
-        cmp->compositor->image.data = tvg::malloc<pixel_t>(channelSize * w * h);
+        cmp->compositor->image.data = tvg::malloc<pixel_t>(channelSize * w * h, AllocTag::Renderer);
         cmp->w = cmp->compositor->image.w = w;
         cmp->h = cmp->compositor->image.h = h;
         cmp->stride = cmp->compositor->image.stride = w;
@@ -632,6 +744,8 @@ RenderCompositor* SwRenderer::target(const RenderRegion& region, ColorSpace cs,
     auto bbox = RenderRegion::intersect(region, {{0, 0}, {int32_t(surface->w), int32_t(surface->h)}});
     if (bbox.invalid()) return nullptr;
 
+    flush();
+
     auto cmp = request(CHANNEL_SIZE(cs), (flags & CompositionFlag::PostProcessing));
     cmp->compositor->recoverSfc = surface;
     cmp->compositor->recoverCmp = surface->compositor;
@@ -655,6 +769,8 @@ bool SwRenderer::endComposite(RenderCompositor* cmp)
 
     auto p = static_cast<SwCompositor*>(cmp);
 
+    flush();
+
     //Recover Context
     surface = p->recoverSfc;
     surface->compositor = p->recoverCmp;
@@ -765,6 +881,8 @@ bool SwRenderer::render(RenderCompositor* cmp, const RenderEffect* effect, bool
 {
     auto p = static_cast<SwCompositor*>(cmp);
 
+    flush();
+
     if (p->image.channelSize != sizeof(uint32_t)) {
         TVGERR("SW_ENGINE", "Not supported grayscale Gaussian Blur!");
         return false;
@@ -841,16 +959,18 @@ SwTask* SwRenderer::prepareCommon(SwTask* task, const Matrix& transform, const A
         tasks.push(task);
     }
 
-    //TODO: Failed threading them. It would be better if it's possible.
-    //See: https://github.com/thorvg/thorvg/issues/1409
-    //Guarantee composition targets get ready.
-    ARRAY_FOREACH(p, clips) {
-        static_cast<SwTask*>(*p)->done();
-    }
-
     if (task->ready(ready)) return task;
 
-    if (flags) TaskScheduler::request(task);
+    if (!flags) return task;
+
+    //Guarantee composition targets get ready before the task runs.
+    if (clips.count > 0) {
+        Array<Task*> deps(clips.count);
+        ARRAY_FOREACH(p, clips) {
+            deps.push(static_cast<SwTask*>(*p));
+        }
+        TaskScheduler::request(task, deps);
+    } else TaskScheduler::request(task);
 
     return task;
 }
@@ -882,6 +1002,40 @@ RenderData SwRenderer::prepare(const RenderShape& rshape, RenderData data, const
     return prepareCommon(task, transform, clips, opacity, flags, (opacity == 0 && !clipper));
 }
 
+void SwRenderer::init()
+{
+    //the user override survives the re-initializations
+    if (!_simdForced) rasterSimdLevel = rasterSimdSupport();
+}
+
+
+bool SwRenderer::simd(SimdLevel level)
+{
+    auto support = rasterSimdSupport();
+
+    //x86 levels are supersets of the lower ones, neon is exclusive
+    if (support == SimdLevel::NEON || level == SimdLevel::NEON) {
+        if (level != SimdLevel::None && level != support) return false;
+    } else if (level > support) return false;
+
+    rasterSimdLevel = level;
+    _simdForced = (level != support);
+    return true;
+}
+
+
+SimdLevel SwRenderer::simd()
+{
+    return rasterSimdLevel;
+}
+
+
+void SwRenderer::glyphCache(size_t budget)
+{
+    glyphCacheBudget(budget);
+}
+
+
 bool SwRenderer::term()
 {
     _rendererMtx.lock();
@@ -891,6 +1045,7 @@ bool SwRenderer::term()
     }
 
     mpoolTerm();
+    glyphCacheTerm();
 
     _rendererCnt = -1;
     _rendererMtx.unlock();
@@ -915,7 +1070,11 @@ SwRenderer::SwRenderer(uint32_t threads, EngineOption op)
 
     mpool = mpoolReq();
 
-    auto byDefault = (op == EngineOption::Default);
+    //the tiled and the accumulated rasterizations don't opt out the default options
+    auto mode = uint8_t(op) & ~(uint8_t(EngineOption::Tiled) | uint8_t(EngineOption::Accumulated));
+    auto byDefault = (mode == uint8_t(EngineOption::Default)) || (mode == 0 && op != EngineOption::None);
     dirtyRegion.support = (byDefault || (op & EngineOption::SmartRender));
     antiAlias = (byDefault || !(op & EngineOption::Aliased));
+    tiled = (op & EngineOption::Tiled);
+    accumulate = (op & EngineOption::Accumulated);
 }
@@ -27,6 +27,7 @@
 
 struct SwSurface;
 struct SwTask;
+struct SwTile;
 struct SwCompositor;
 struct SwMpool;
 
@@ -74,21 +75,33 @@ struct SwRenderer : RenderMethod
     bool partial(bool disable) override;
 
     SwRenderer(uint32_t threads, EngineOption op);
+    static void init();
     static bool term();
+    static bool simd(SimdLevel level);
+    static SimdLevel simd();
+    static void glyphCache(size_t budget);
 
     SwSurface*           surface = nullptr;           // active surface
     SwMpool*             mpool;                       // designated memory pool
     bool                 antiAlias;                   // anti-aliasing support
+    bool                 accumulate;                  // dense accumulation buffer rasterizer
 
 private:
     bool                 fulldraw = true;             //buffer is cleared (need to redraw full screen)
+    bool                 tiled = false;               //tile-binned parallel rasterization
+    bool                 binned = false;              //draw commands are pending in the tile bins
     Array<SwTask*>       tasks;                       //async task list
     Array<SwSurface*>    compositors;                 //render targets cache list
+    Array<SwTile*>       tiles;                       //draw command bins of the screen tiles in the row order
     RenderDirtyRegion    dirtyRegion;                 //partial rendering support
 
     ~SwRenderer();
 
     SwTask* prepareCommon(SwTask* task, const Matrix& transform, const Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flags, bool ready);
+    void rasterize(SwTask* task, const RenderRegion& bbox);
+    void draw(SwTask* task, const RenderRegion& region);
+    void flush();
+    void clearTiles();
 };
 
 }
@@ -189,8 +189,14 @@
 */
 
 #include <limits.h>
+#include <string.h>
+#include "tvgTaskScheduler.h"
 #include "tvgSwCommon.h"
 
+#ifdef THORVG_AVX_VECTOR_SUPPORT
+    #include <immintrin.h>
+#endif
+
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
@@ -198,6 +204,16 @@
 constexpr auto PIXEL_BITS = 8;   //must be at least 6 bits!
 constexpr auto ONE_PIXEL = (1 << PIXEL_BITS);
 
+//conditions of the parallel rendering of a giant shape
+#define RLE_BAND_TASK_MAX 8
+#define RLE_BAND_MIN_ROWS 128
+#define RLE_BAND_MIN_AREA (512 * 512)
+#define RLE_BAND_MIN_POINTS 4096
+
+//rows of a strip of the accumulation buffers
+#define RLE_ACC_BUDGET (512 * 1024)
+#define RLE_ACC_MIN_ROWS 16
+
 struct Band
 {
     int32_t min, max;
@@ -240,6 +256,12 @@ struct RleWorker
     SwCell** yCells;
     int32_t yCnt;
 
+    //dense accumulation buffers of the strip rows, the cell x is stored at (x + 1)
+    long* areas;
+    int32_t* covers;
+    int32_t* ranges;   //touched min, max x of every row
+    int32_t stride;
+
     bool invalid;
     bool antiAlias;
 };
@@ -311,14 +333,8 @@ static void _splitLine(SwPoint* base)
     base[1] = {(base[0].x >> 1) + (base[1].x >> 1), (base[0].y >> 1) + (base[1].y >> 1)};
 }
 
-static void _horizLine(RleWorker& rw, int32_t x, int32_t y, int32_t area, int32_t aCount)
+static inline int _coverage(const RleWorker& rw, int32_t area)
 {
-    x += rw.cellMin.x;
-    y += rw.cellMin.y;
-
-    //Clip Y range
-    if (y < rw.cellMin.y || y >= rw.cellMax.y) return;
-
     /* compute the coverage line's coverage, depending on the outline fill rule */
     /* the coverage percentage is area/(PIXEL_BITS*PIXEL_BITS*2) */
     auto coverage = static_cast<int>(area >> (PIXEL_BITS * 2 + 1 - 8));    //range 0 - 255
@@ -332,11 +348,18 @@ static void _horizLine(RleWorker& rw, int32_t x, int32_t y, int32_t area, int32_
         if (coverage > 255) coverage = 255;
     }
 
-    if (coverage == 0) return;
+    if (coverage > 0 && !rw.antiAlias) coverage = 255;
 
-    auto rle = rw.rle;
+    return coverage;
+}
 
-    if (!rw.antiAlias) coverage = 255;
+
+static void _span(RleWorker& rw, int32_t x, int32_t y, int coverage, int32_t aCount)
+{
+    //Clip Y range
+    if (y < rw.cellMin.y || y >= rw.cellMax.y) return;
+
+    auto rle = rw.rle;
 
     //see whether we can add this span to the current list
     if (!rle->spans.empty()) {
@@ -367,6 +390,14 @@ static void _horizLine(RleWorker& rw, int32_t x, int32_t y, int32_t area, int32_
 }
 
 
+static void _horizLine(RleWorker& rw, int32_t x, int32_t y, int32_t area, int32_t aCount)
+{
+    auto coverage = _coverage(rw, area);
+    if (coverage == 0) return;
+    _span(rw, x + rw.cellMin.x, y + rw.cellMin.y, coverage, aCount);
+}
+
+
 static void _sweep(RleWorker& rw)
 {
     if (rw.cellsCnt == 0) return;
@@ -390,6 +421,94 @@ static void _sweep(RleWorker& rw)
 }
 
 
+#ifdef THORVG_AVX_VECTOR_SUPPORT
+AVX_TARGET("sse2")
+static void _sse2PrefixSum(int32_t* p, int32_t len)
+{
+    auto carry = _mm_setzero_si128();
+    for (; len >= 4; len -= 4, p += 4) {
+        auto v = _mm_loadu_si128((__m128i*)p);
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, carry);
+        _mm_storeu_si128((__m128i*)p, v);
+        carry = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    auto sum = _mm_cvtsi128_si32(carry);
+    for (; len > 0; --len, ++p) *p = (sum += *p);
+}
+#endif
+
+
+//inclusive prefix sum, turns the cover deltas into the running covers
+static void _prefixSum(int32_t* p, int32_t len)
+{
+#ifdef THORVG_AVX_VECTOR_SUPPORT
+    if (rasterSimdLevel != SimdLevel::None) {
+        _sse2PrefixSum(p, len);
+        return;
+    }
+#endif
+    auto sum = 0;
+    for (; len > 0; --len, ++p) *p = (sum += *p);
+}
+
+
+//the same spans as _sweep(), but the coverage is resolved per pixel from the accumulation buffers
+static void _sweepDense(RleWorker& rw)
+{
+    for (int y = 0; y < rw.yCnt; ++y) {
+        auto range = rw.ranges + y * 2;
+        if (range[0] > range[1]) continue;
+
+        auto areas = rw.areas + y * rw.stride + 1;
+        auto covers = rw.covers + y * rw.stride + 1;
+        _prefixSum(covers + range[0], range[1] - range[0] + 1);
+
+        //run of the same coverage
+        auto begin = std::max(range[0], 0);
+        auto runX = begin, runLen = 0, runCov = 0;
+
+        for (auto x = begin; x <= range[1]; ++x) {
+            //no edge passes this pixel and the previous one, they are the same
+            if (x > begin && (areas[x] | areas[x - 1]) == 0 && covers[x] == covers[x - 1]) {
+                ++runLen;
+                continue;
+            }
+            auto coverage = _coverage(rw, int32_t(covers[x] * (ONE_PIXEL * 2) - areas[x]));
+            if (coverage == runCov) {
+                ++runLen;
+                continue;
+            }
+            if (runCov > 0) _span(rw, runX + rw.cellMin.x, y + rw.cellMin.y, runCov, runLen);
+            runX = x;
+            runLen = 1;
+            runCov = coverage;
+        }
+
+        //the cover goes on to the right end
+        auto x = range[1] + 1;
+        if (covers[range[1]] != 0 && x < rw.cellXCnt) {
+            auto coverage = _coverage(rw, covers[range[1]] * (ONE_PIXEL * 2));
+            if (coverage == runCov) runLen += rw.cellXCnt - x;
+            else {
+                if (runCov > 0) _span(rw, runX + rw.cellMin.x, y + rw.cellMin.y, runCov, runLen);
+                runX = x;
+                runLen = rw.cellXCnt - x;
+                runCov = coverage;
+            }
+        }
+        if (runCov > 0) _span(rw, runX + rw.cellMin.x, y + rw.cellMin.y, runCov, runLen);
+
+        //clean up the touched range only for the next strip
+        memset(areas + range[0], 0, sizeof(long) * (range[1] - range[0] + 1));
+        memset(covers + range[0], 0, sizeof(int32_t) * (range[1] - range[0] + 1));
+        range[0] = rw.cellXCnt;
+        range[1] = -2;
+    }
+}
+
+
 static SwCell* _findCell(RleWorker& rw)
 {
     auto x = rw.cellPos.x;
@@ -419,7 +538,15 @@ static SwCell* _findCell(RleWorker& rw)
 
 static bool _recordCell(RleWorker& rw)
 {
-    if (rw.area | rw.cover) {
+    if (rw.areas && (rw.area | rw.cover)) {
+        auto x = rw.cellPos.x;
+        auto idx = rw.cellPos.y * rw.stride + x + 1;
+        rw.areas[idx] += rw.area;
+        rw.covers[idx] += rw.cover;
+        auto range = rw.ranges + rw.cellPos.y * 2;
+        if (x < range[0]) range[0] = x;
+        if (x > range[1]) range[1] = x;
+    } else if (rw.area | rw.cover) {
         auto cell = _findCell(rw);
         if (!cell) return false;
         cell->area += rw.area;
@@ -739,14 +866,9 @@ static bool _genRle(RleWorker& rw)
 }
 
 
-/************************************************************************/
-/* External Class Implementation                                        */
-/************************************************************************/
-
-SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox, SwMpool* mpool, unsigned tid, bool antiAlias)
+//generate the spans of the outline within the bbox rows, they are appended to the rle in the y order.
+static bool _render(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox, SwMpool* mpool, unsigned tid, bool antiAlias)
 {
-    if (!outline) return nullptr;
-  
     RleWorker rw;
     auto cellPool = mpool->cell(tid);
     auto reqSize = uint32_t(std::max(bbox.w(), bbox.h()) * 0.75f) * sizeof(SwCell);  //experimental decision
@@ -755,13 +877,14 @@ SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox,
     if (reqSize > cellPool->size) {
         cellPool->size = ((reqSize + (reqSize >> 2)) / sizeof(SwCell)) * sizeof(SwCell);
         tvg::free(cellPool->buffer);
-        cellPool->buffer = tvg::malloc<SwCell>(cellPool->size);
+        cellPool->buffer = tvg::malloc<SwCell>(cellPool->size, AllocTag::Renderer);
     }
 
     //Init Cells
     rw.buffer = cellPool->buffer;
     rw.bufferSize = cellPool->size;
     rw.yCells = reinterpret_cast<SwCell**>(cellPool->buffer);
+    rw.areas = nullptr;
     rw.cells = nullptr;
     rw.maxCells = 0;
     rw.cellsCnt = 0;
@@ -777,9 +900,7 @@ SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox,
     rw.bandShoot = 0;
     rw.antiAlias = antiAlias;
 
-    if (!rle) rw.rle = new SwRle;
-    else rw.rle = rle;
-    rw.rle->spans.reserve(256);
+    rw.rle = rle;
 
     //Generate RLE
     constexpr auto BAND_SIZE = 40;
@@ -844,10 +965,7 @@ SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox,
 
             /* This is too complex for a single scanline; there must
                be some problems */
-            if (middle == bottom) {
-                rleFree(rw.rle);
-                return nullptr;
-            }
+            if (middle == bottom) return false;
 
             if (bottom - top >= rw.bandSize) ++rw.bandShoot;
 
@@ -861,7 +979,136 @@ SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox,
     if (rw.bandShoot > 8 && rw.bandSize > 16) {
         rw.bandSize = (rw.bandSize >> 1);
     }
-    return rw.rle;
+    return true;
+}
+
+
+//generate the same spans as _render() with the accumulation buffers, strip by strip of the bbox rows.
+static bool _renderDense(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox, SwMpool* mpool, unsigned tid, bool antiAlias)
+{
+    RleWorker rw;
+    rw.cellMin = {bbox.min.x, bbox.min.y};
+    rw.cellMax = {bbox.max.x, bbox.max.y};
+    rw.cellXCnt = rw.cellMax.x - rw.cellMin.x;
+    rw.cellYCnt = rw.cellMax.y - rw.cellMin.y;
+    if (rw.cellXCnt <= 0 || rw.cellYCnt <= 0) return true;
+
+    //the cells on the left of the clipping region are gathered at x = -1
+    rw.stride = rw.cellXCnt + 1;
+    auto rowSize = rw.stride * (sizeof(long) + sizeof(int32_t)) + sizeof(int32_t) * 2;
+    auto rows = std::min(std::max(int32_t(RLE_ACC_BUDGET / rowSize), RLE_ACC_MIN_ROWS), rw.cellYCnt);
+
+    //share the cell pool, the buffers are wiped out once and cleaned up by the sweep
+    auto cellPool = mpool->cell(tid);
+    auto reqSize = uint32_t(rows * rowSize);
+    if (reqSize > cellPool->size) {
+        cellPool->size = ((reqSize + sizeof(SwCell) - 1) / sizeof(SwCell)) * sizeof(SwCell);
+        tvg::free(cellPool->buffer);
+        cellPool->buffer = tvg::malloc<SwCell>(cellPool->size, AllocTag::Renderer);
+    }
+
+    rw.areas = reinterpret_cast<long*>(cellPool->buffer);
+    rw.covers = reinterpret_cast<int32_t*>(rw.areas + rows * rw.stride);
+    rw.ranges = rw.covers + rows * rw.stride;
+    memset(rw.areas, 0, rows * rw.stride * (sizeof(long) + sizeof(int32_t)));
+    for (int32_t y = 0; y < rows; ++y) {
+        rw.ranges[y * 2] = rw.cellXCnt;
+        rw.ranges[y * 2 + 1] = -2;
+    }
+
+    rw.cells = nullptr;
+    rw.outline = const_cast<SwOutline*>(outline);
+    rw.antiAlias = antiAlias;
+    rw.rle = rle;
+
+    for (auto min = bbox.min.y; min < bbox.max.y; min += rows) {
+        rw.cellMin.y = min;
+        rw.cellMax.y = std::min(min + rows, bbox.max.y);
+        rw.cellYCnt = rw.yCnt = rw.cellMax.y - rw.cellMin.y;
+        rw.area = 0;
+        rw.cover = 0;
+        rw.invalid = true;
+
+        //never overflows, every cell has its own slot
+        _genRle(rw);
+        _sweepDense(rw);
+    }
+    return true;
+}
+
+
+//a part of the rows of a big outline, rendered on a worker thread
+struct RleBandTask : Task
+{
+    SwRle* rle;
+    SwRle spans;  //the spans of this band, if it's not the first one
+    const SwOutline* outline;
+    RenderRegion bbox;
+    SwMpool* mpool;
+    bool antiAlias;
+    bool accumulate;
+    bool success;
+
+    void run(unsigned tid) override
+    {
+        success = accumulate ? _renderDense(rle, outline, bbox, mpool, tid, antiAlias) : _render(rle, outline, bbox, mpool, tid, antiAlias);
+    }
+};
+
+
+//split the rows of the big outline into the bands to be rendered in parallel
+static bool _renderBands(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox, SwMpool* mpool, unsigned tid, bool antiAlias, bool accumulate, uint32_t cnt)
+{
+    RleBandTask bands[RLE_BAND_TASK_MAX];
+    Array<Task*> tasks(cnt);
+
+    auto h = bbox.h();
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto band = bands + i;
+        band->rle = (i == 0) ? rle : &band->spans;
+        band->outline = outline;
+        band->bbox = {{bbox.min.x, bbox.min.y + int32_t(h * i / cnt)}, {bbox.max.x, bbox.min.y + int32_t(h * (i + 1) / cnt)}};
+        band->mpool = mpool;
+        band->antiAlias = antiAlias;
+        band->accumulate = accumulate;
+        tasks.push(band);
+    }
+
+    TaskScheduler::invoke(tasks, tid);
+
+    //concatenate the spans in the y order
+    for (uint32_t i = 0; i < cnt; ++i) {
+        if (!bands[i].success) return false;
+        if (i > 0) rle->spans.push(bands[i].spans.spans);
+    }
+    return true;
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox, SwMpool* mpool, unsigned tid, bool antiAlias, bool accumulate)
+{
+    if (!outline) return nullptr;
+
+    if (!rle) rle = new SwRle;
+    rle->spans.reserve(256);
+
+    //fan the giant shapes out to the worker threads
+    auto cnt = std::min(std::min(TaskScheduler::threads() + 1, uint32_t(bbox.h() / RLE_BAND_MIN_ROWS)), uint32_t(RLE_BAND_TASK_MAX));
+    auto big = (bbox.w() * bbox.h() >= RLE_BAND_MIN_AREA) || (outline->out.count >= RLE_BAND_MIN_POINTS);
+
+    bool success;
+    if (cnt > 1 && big) success = _renderBands(rle, outline, bbox, mpool, tid, antiAlias, accumulate, cnt);
+    else if (accumulate) success = _renderDense(rle, outline, bbox, mpool, tid, antiAlias);
+    else success = _render(rle, outline, bbox, mpool, tid, antiAlias);
+    if (!success) {
+        rleFree(rle);
+        return nullptr;
+    }
+    return rle;
 }
 
 
@@ -896,12 +1143,14 @@ void rleFree(SwRle* rle)
 }
 
 
-bool rleClip(SwRle* rle, const SwRle *clip)
+bool rleClip(SwRle* rle, const SwRle *clip, SwArena* arena)
 {
     if (rle->spans.empty() || clip->spans.empty()) return false;
 
-    Array<SwSpan> out;
-    out.reserve(std::max(rle->spans.count, clip->spans.count));
+    //the intersections of the two sorted span lists never outnumber the both
+    SwArenaScope scope(arena);
+    auto out = arena->alloc<SwSpan>(rle->spans.count + clip->spans.count);
+    auto data = out;
 
     const SwSpan *end;
     auto spans = rle->fetch(clip->spans.first().y, clip->spans.last().y, &end);
@@ -935,12 +1184,17 @@ bool rleClip(SwRle* rle, const SwRle *clip)
             //clip span region
             auto x = std::max(spans->x, temp->x);
             auto len = std::min((spans->x + spans->len), (temp->x + temp->len)) - x;
-            if (len > 0) out.next() = {x, temp->y, len, (uint8_t)(((spans->coverage * temp->coverage) + 0xff) >> 8)};
+            if (len > 0) *data++ = {x, temp->y, len, (uint8_t)(((spans->coverage * temp->coverage) + 0xff) >> 8)};
             ++temp;
         }
         ++spans;
     }
-    out.move(rle->spans);
+
+    //keep the span buffer of the rle over the frames
+    rle->spans.clear();
+    rle->spans.reserve(data - out);
+    memcpy(rle->spans.data, out, sizeof(SwSpan) * (data - out));
+    rle->spans.count = data - out;
     return true;
 }
 
@@ -953,9 +1207,8 @@ bool rleClip(SwRle *rle, const RenderRegion* clip)
     auto& min = clip->min;
     auto& max = clip->max;
 
-    Array<SwSpan> out;
-    out.reserve(rle->spans.count);
-    auto data = out.data;
+    //a span is clipped into one at most, compact them in place
+    auto data = rle->spans.data;
     const SwSpan* end;
     int32_t x, len;
 
@@ -972,10 +1225,9 @@ bool rleClip(SwRle *rle, const RenderRegion* clip)
         if (len > 0) {
             *data = {x, p->y, len, p->coverage};
             ++data;
-            ++out.count;
         }
     }
-    out.move(rle->spans);
+    rle->spans.count = data - rle->spans.data;
     return true;
 }
 
@@ -234,20 +234,17 @@ static void _dashMoveTo(SwDashStroke& dash, uint32_t offIdx, float offset, const
 
 static SwOutline* _genDashOutline(const RenderShape* rshape, SwMpool* mpool, unsigned tid, bool trimmed)
 {
-    PathCommand *cmds, *tcmds = nullptr;
-    Point *pts, *tpts = nullptr;
+    PathCommand* cmds;
+    Point* pts;
     uint32_t cmdCnt, ptsCnt;
 
     if (trimmed) {
-        RenderPath trimmed;
-        if (!rshape->stroke->trim.trim(rshape->path, trimmed)) return nullptr;
-        cmds = tcmds = trimmed.cmds.data;
-        cmdCnt = trimmed.cmds.count;
-        pts = tpts = trimmed.pts.data;
-        ptsCnt = trimmed.pts.count;
-
-        trimmed.cmds.data = nullptr;
-        trimmed.pts.data = nullptr;
+        auto path = mpool->path(tid);
+        if (!rshape->stroke->trim.trim(rshape->path, *path)) return nullptr;
+        cmds = path->cmds.data;
+        cmdCnt = path->cmds.count;
+        pts = path->pts.data;
+        ptsCnt = path->pts.count;
     } else {
         cmds = rshape->path.cmds.data;
         cmdCnt = rshape->path.cmds.count;
@@ -320,9 +317,6 @@ static SwOutline* _genDashOutline(const RenderShape* rshape, SwMpool* mpool, uns
 
     dash.outline->fillRule = rshape->rule;
 
-    tvg::free(tcmds);
-    tvg::free(tpts);
-
     return dash.outline;
 }
 
@@ -345,29 +339,8 @@ static bool _axisAlignedRect(const SwOutline* outline)
     return false;
 }
 
-static SwOutline* _genOutline(const RenderShape* rshape, SwMpool* mpool, unsigned tid, bool trimmed = false)
+static SwOutline* _genOutline(const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, uint32_t ptsCnt, FillRule rule, SwMpool* mpool, unsigned tid)
 {
-    PathCommand *cmds, *tcmds = nullptr;
-    Point *pts, *tpts = nullptr;
-    uint32_t cmdCnt, ptsCnt;
-
-    if (trimmed) {
-        RenderPath trimmed;
-        if (!rshape->stroke->trim.trim(rshape->path, trimmed)) return nullptr;
-        cmds = tcmds = trimmed.cmds.data;
-        cmdCnt = trimmed.cmds.count;
-        pts = tpts = trimmed.pts.data;
-        ptsCnt = trimmed.pts.count;
-
-        trimmed.cmds.data = nullptr;
-        trimmed.pts.data = nullptr;
-    } else {
-        cmds = rshape->path.cmds.data;
-        cmdCnt = rshape->path.cmds.count;
-        pts = rshape->path.pts.data;
-        ptsCnt = rshape->path.pts.count;
-    }
-
     // No actual shape data
     if (cmdCnt == 0 || ptsCnt == 0) return nullptr;
 
@@ -404,19 +377,26 @@ static SwOutline* _genOutline(const RenderShape* rshape, SwMpool* mpool, unsigne
 
     if (!closed) _outlineEnd(*outline);
 
-    outline->fillRule = rshape->rule;
-
-    tvg::free(tcmds);
-    tvg::free(tpts);
+    outline->fillRule = rule;
 
     return outline;
 }
 
+static SwOutline* _genOutline(const RenderShape* rshape, SwMpool* mpool, unsigned tid, bool trimmed = false)
+{
+    if (trimmed) {
+        auto path = mpool->path(tid);
+        if (!rshape->stroke->trim.trim(rshape->path, *path)) return nullptr;
+        return _genOutline(path->cmds.data, path->cmds.count, path->pts.data, path->pts.count, rshape->rule, mpool, tid);
+    }
+    return _genOutline(rshape->path.cmds.data, rshape->path.cmds.count, rshape->path.pts.data, rshape->path.pts.count, rshape->rule, mpool, tid);
+}
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
 
-bool shapeGenRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool composite, bool antiAlias)
+bool shapeGenRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool composite, bool antiAlias, bool accumulate)
 {
     auto outline = _genOutline(rshape, mpool, tid, rshape->trimpath());
     if (!outline || outline->in.empty()) {
@@ -435,10 +415,15 @@ bool shapeGenRle(SwShape& shape, const RenderShape* rshape, const Matrix& transf
 
     if (shape.fastTrack) return true;
 
-    shape.rle = rleRender(shape.rle, outline, renderBox, mpool, tid, antiAlias);
+    shape.rle = rleRender(shape.rle, outline, renderBox, mpool, tid, antiAlias, accumulate);
     return shape.rle ? true : false;
 }
 
+SwOutline* shapeGenOutline(const RenderPath& path, FillRule rule, SwMpool* mpool, unsigned tid)
+{
+    return _genOutline(path.cmds.data, path.cmds.count, path.pts.data, path.pts.count, rule, mpool, tid);
+}
+
 void shapeDelOutline(SwShape& shape)
 {
     shape.outline = nullptr;
@@ -487,7 +472,7 @@ void shapeResetStroke(SwShape& shape, const RenderShape* rshape, const Matrix& t
 }
 
 
-bool shapeGenStrokeRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool antiAlias)
+bool shapeGenStrokeRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool antiAlias, bool accumulate)
 {
     shapeResetStroke(shape, rshape, transform, mpool, tid);
 
@@ -506,7 +491,7 @@ bool shapeGenStrokeRle(SwShape& shape, const RenderShape* rshape, const Matrix&
     utilExport(outline, transform, bbox);
     if (!utilBBox(bbox, clipBox, renderBox, false)) return false;
 
-    shape.strokeRle = rleRender(shape.strokeRle, outline, renderBox, mpool, tid, antiAlias);
+    shape.strokeRle = rleRender(shape.strokeRle, outline, renderBox, mpool, tid, antiAlias, accumulate);
     return shape.strokeRle ? true : false;
 }
 
@@ -27,10 +27,13 @@
 #include "tvgGl.h"
 #include "tvgRender.h"
 #include "tvgMath.h"
+#include "tvgTaskScheduler.h"
+#include "tvgInlist.h"
 #include "tvgGpuCommon.h"
 
 struct GlStageBuffer;
 struct GlRenderTask;
+struct GlShape;
 
 constexpr float MIN_GL_STROKE_WIDTH = 1.0f;
 constexpr float MIN_GL_STROKE_ALPHA = 0.25f;
@@ -95,6 +98,7 @@ struct GlGeometry
     bool tesselateStroke(const RenderShape& rshape);
     bool tesselateThinFill(const RenderPath& path);
     void tesselateImage(const RenderSurface* image);
+    void reuse(const GlGeometry& src);
     bool drawable(RenderUpdateFlag flag) const
     {
         if (flag == RenderUpdateFlag::None) return false;
@@ -123,7 +127,26 @@ struct GlGeometry
 };
 
 
-struct GlShape
+//a tessellation shared by the shapes of the same path in the same transform class
+struct GlTessEntry
+{
+    INLIST_ITEM(GlTessEntry);
+    GlGeometry geometry;                //the fill in the world space of geometry.matrix, the stroke in the local space
+    GlShape* producer = nullptr;        //the shape tessellating it in the current update, null once it's stored
+    uint64_t key = 0;
+    float opacityMultiplier = 1.0f;
+    bool validFill = false;
+    bool validStroke = false;
+
+    size_t bytes() const
+    {
+        return (geometry.fill.vertex.count + geometry.stroke.vertex.count) * sizeof(float) + (geometry.fill.index.count + geometry.stroke.index.count) * sizeof(uint32_t);
+    }
+};
+
+
+//the shape tessellation runs on the task scheduler, the renderer joins it before uploading the geometry
+struct GlShape : Task
 {
   const RenderShape* rshape = nullptr;
   float viewWd;
@@ -137,9 +160,24 @@ struct GlShape
   ColorSpace texColorSpace = ColorSpace::ABGR8888;
   GlGeometry geometry;
   Array<RenderData> clips;
+  const GlTessEntry* source = nullptr;  //the cached tessellation to be reused by the pending task
+  uint64_t tessKey = 0;                 //the tessellation cache key of the current geometry, 0 if not cachable
+  float opacityMultiplier = 1.0f;       //the fill opacity of the tessellation
   uint16_t texStamp = 0;  // Tracks TextureMgr::stamp ownership of texId.
   bool validFill = false;
   bool validStroke = false;
+  //requested tessellation steps of the pending task
+  bool updatePath = false;
+  bool updateFill = false;
+  bool updateStroke = false;
+  bool pushed = false;    //pushed into the renderer's task list?
+  bool disposed = false;  //disposed while the task is pending?
+
+protected:
+  void run(unsigned tid) override;
+
+private:
+  void reuse(const GlGeometry& src, bool fill, bool stroke, float multiplier);
 };
 
 struct GlIntersector
@@ -267,6 +267,51 @@ void GlGeometry::tesselateImage(const RenderSurface* image)
     fillBounds = gpuTransformBounds(RenderRegion{{0, 0}, {int32_t(image->w), int32_t(image->h)}}, matrix);
 }
 
+
+void GlGeometry::reuse(const GlGeometry& src)
+{
+    fill.index = src.fill.index;
+    stroke = src.stroke;
+    strokeBounds = src.strokeBounds;
+    fillRule = src.fillRule;
+    fillWorld = src.fillWorld;
+    optPathThin = src.optPathThin;
+    optPathSkipFill = src.optPathSkipFill;
+    convex = src.convex;
+    optPath.clear();
+    optStrokePath.clear();  //the stroke-only updates will optimize the path again
+
+    // The stroke stays in the local space, only its quality scale follows the transform class.
+    strokeRenderWidth = (src.strokeRenderWidth > 0.0f) ? src.strokeRenderWidth * scaling(matrix) / scaling(src.matrix) : 0.0f;
+
+    // The fill is in the world space of the source transform, so it's mapped onto this one.
+    auto translated = (matrix.e11 == src.matrix.e11 && matrix.e12 == src.matrix.e12 && matrix.e21 == src.matrix.e21 && matrix.e22 == src.matrix.e22);
+    auto dx = matrix.e13 - src.matrix.e13;
+    auto dy = matrix.e23 - src.matrix.e23;
+    if (!fillWorld || (translated && dx == 0.0f && dy == 0.0f)) {
+        fill.vertex = src.fill.vertex;
+        fillBounds = src.fillBounds;
+        return;
+    }
+
+    Matrix inv, delta;
+    if (translated || !inverse(&src.matrix, &inv)) delta = {1.0f, 0.0f, dx, 0.0f, 1.0f, dy, 0.0f, 0.0f, 1.0f};
+    else delta = matrix * inv;
+
+    fill.vertex.reserve(src.fill.vertex.count);
+    fill.vertex.clear();
+    BBox bbox;
+    bbox.init();
+    for (uint32_t i = 0; i + 1 < src.fill.vertex.count; i += 2) {
+        auto pt = Point{src.fill.vertex[i], src.fill.vertex[i + 1]} * delta;
+        fill.vertex.push(pt.x);
+        fill.vertex.push(pt.y);
+        bbox = {min(bbox.min, pt), max(bbox.max, pt)};
+    }
+    fillBounds = fill.vertex.empty() ? RenderRegion{} : RenderRegion{{int32_t(floor(bbox.min.x)), int32_t(floor(bbox.min.y))}, {int32_t(ceil(bbox.max.x)), int32_t(ceil(bbox.max.y))}};
+}
+
+
 void GlGeometry::draw(GlRenderTask* task, GlStageBuffer* gpuBuffer, RenderUpdateFlag flag) const
 {
     auto buffer = ((flag & RenderUpdateFlag::Stroke) || (flag & RenderUpdateFlag::GradientStroke)) ? &stroke : &fill;
@@ -57,6 +57,47 @@ static bool _skipRender(const Array<RenderData>& clips)
     return false;
 }
 
+void GlShape::reuse(const GlGeometry& src, bool fill, bool stroke, float multiplier)
+{
+    geometry.reuse(src);
+    validFill = fill;
+    validStroke = stroke;
+    opacityMultiplier = multiplier;
+    opacity *= multiplier;
+}
+
+
+void GlShape::run(TVG_UNUSED unsigned tid)
+{
+    //the same path in the same transform class is tessellated already
+    if (source) {
+        if (auto producer = source->producer) reuse(producer->geometry, producer->validFill, producer->validStroke, producer->opacityMultiplier);
+        else reuse(source->geometry, source->validFill, source->validStroke, source->opacityMultiplier);
+        source = nullptr;
+        updatePath = updateFill = updateStroke = false;
+        return;
+    }
+
+    if (updatePath) geometry.prepare(*rshape);
+
+    if (updateFill) {
+        validFill = false;
+        opacityMultiplier = 1.0f;
+        if (geometry.tesselateShape(*rshape, &opacityMultiplier)) {
+            opacity *= opacityMultiplier;
+            validFill = true;
+        }
+    }
+
+    if (updateStroke) {
+        validStroke = false;
+        if (geometry.tesselateStroke(*rshape)) validStroke = true;
+    }
+
+    updatePath = updateFill = updateStroke = false;
+}
+
+
 void GlRenderer::disposeTexture(GLuint texId)
 {
     if (!texId) return;
@@ -79,6 +120,21 @@ void GlRenderer::clearDisposes()
 }
 
 
+void GlRenderer::join()
+{
+    ARRAY_FOREACH(p, mTasks) (*p)->done();
+
+    //the disposed producers are still alive here
+    mTessCache.store();
+
+    ARRAY_FOREACH(p, mTasks) {
+        if ((*p)->disposed) delete(*p);
+        else (*p)->pushed = false;
+    }
+    mTasks.clear();
+}
+
+
 void GlRenderer::flush()
 {
     clearDisposes();
@@ -121,6 +177,8 @@ GlRenderer::GlRenderer() : mEffect(GlEffect(&mGpuBuffer))
 
 GlRenderer::~GlRenderer()
 {
+    join();
+
     if (mContext) currentContext();
     flush();
     mTextures.clear();
@@ -965,6 +1023,12 @@ Result GlRenderer::target(void* display, void* surface, void* context, int32_t i
     return ret ? Result::Success : Result::InsufficientCondition;
 }
 
+void GlRenderer::tessellation(uint32_t* hits, uint32_t* misses)
+{
+    if (hits) *hits = mTessCache.frameHits;
+    if (misses) *misses = mTessCache.frameMisses;
+}
+
 
 bool GlRenderer::sync()
 {
@@ -973,6 +1037,10 @@ bool GlRenderer::sync()
     // ThorVG-tracked assumption.
     mStateCache.invalidate();
 
+    //join the tessellations if the rendering was not triggered.
+    join();
+    mTessCache.frame();
+
     //nothing to be done.
     if (mRenderPassStack.empty()) return true;
 
@@ -1024,6 +1092,7 @@ bool GlRenderer::bounds(RenderData data, Point* pt4, const Matrix& m)
     if (!data) return false;
 
     auto sdata = static_cast<GlShape*>(data);
+    sdata->done();
     if (!sdata->validStroke) return false;
 
     tvg::BBox bbox;
@@ -1047,12 +1116,16 @@ RenderRegion GlRenderer::region(RenderData data)
 {
     if (!data) return {};
     auto shape = reinterpret_cast<GlShape*>(data);
+    shape->done();
     return shape->geometry.getBounds();
 }
 
 
 bool GlRenderer::preRender()
 {
+    //the tessellated geometries must be ready before they are pushed to the stage buffer.
+    join();
+
     if (mRootTarget.invalid()) return false;
 
     currentContext();
@@ -1273,9 +1346,11 @@ void GlRenderer::dispose(RenderData data)
 {
     auto sdata = static_cast<GlShape*>(data);
     if (!sdata) return;
+    sdata->done();  //the tessellation may still refer to the shape
     auto ownsTexture = sdata->texId && (sdata->texStamp == mTextures.stamp);
     if (ownsTexture) disposeTexture(mTextures.release(sdata->texSource, sdata->texFilter, sdata->texId));
-    delete sdata;
+    if (sdata->pushed) sdata->disposed = true;
+    else delete sdata;
 }
 
 RenderData GlRenderer::prepare(RenderSurface* image, RenderData data, const Matrix& transform, const Array<RenderData>& clips, uint8_t opacity, FilterMethod filter, RenderUpdateFlag flags)
@@ -1331,7 +1406,8 @@ RenderData GlRenderer::prepare(RenderSurface* image, RenderData data, const Matr
 RenderData GlRenderer::prepare(const RenderShape& rshape, RenderData data, const Matrix& transform, const Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flags, bool clipper)
 {
     auto sdata = static_cast<GlShape*>(data);
-    if (!sdata) {
+    if (sdata) sdata->done();
+    else {
         sdata = new GlShape;
         sdata->rshape = &rshape;
         flags = RenderUpdateFlag::All;
@@ -1357,35 +1433,54 @@ RenderData GlRenderer::prepare(const RenderShape& rshape, RenderData data, const
     sdata->geometry.setMatrix(transform);
     sdata->geometry.viewport = vport;
     auto strokePathMissing = (flags & RenderUpdateFlag::Stroke) && rshape.stroke && std::isfinite(rshape.strokeWidth()) && !tvg::zero(rshape.strokeWidth()) && sdata->geometry.optStrokePath.empty();
-    if ((flags & (RenderUpdateFlag::Path | RenderUpdateFlag::Transform)) || strokePathMissing) sdata->geometry.prepare(rshape);
-
-    //TODO: Please precisely update tessellation not to update only if the color is changed.
-    if (flags & (RenderUpdateFlag::Color | RenderUpdateFlag::Gradient | RenderUpdateFlag::Transform | RenderUpdateFlag::Path)) {
-        sdata->validFill = false;
-        float opacityMultiplier = 1.0f;
-        if (sdata->geometry.tesselateShape(*(sdata->rshape), &opacityMultiplier)) {
-            sdata->opacity *= opacityMultiplier;
-            sdata->validFill = true;
+    sdata->updatePath = (flags & (RenderUpdateFlag::Path | RenderUpdateFlag::Transform)) || strokePathMissing;
+    sdata->updateFill = flags & (RenderUpdateFlag::Transform | RenderUpdateFlag::Path);
+    sdata->updateStroke = flags & (RenderUpdateFlag::Stroke | RenderUpdateFlag::Transform | RenderUpdateFlag::Path);
+
+    //the stroke flag comes with the stroke color changes too, the tessellation is kept if its key is same.
+    if (sdata->updateStroke) {
+        auto key = GlTessCache::key(rshape, transform);
+        if (key && key == sdata->tessKey && !sdata->updateFill) sdata->updatePath = sdata->updateStroke = false;
+        else if (key) {
+            sdata->source = mTessCache.find(key);
+            if (!sdata->source) mTessCache.request(key, sdata);
+            else if (sdata->source->producer == sdata) sdata->source = nullptr;
         }
+        sdata->tessKey = key;
     }
 
-    //TODO: Please precisely update tessellation not to update only if the color is changed.
-    if (flags & (RenderUpdateFlag::Color | RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke | RenderUpdateFlag::Transform | RenderUpdateFlag::Path)) {
-        sdata->validStroke = false;
-        if (sdata->geometry.tesselateStroke(*(sdata->rshape))) sdata->validStroke = true;
-    }
+    //the color and opacity changes don't tessellate again, the fill opacity is kept.
+    if (!sdata->updateFill && !sdata->source) sdata->opacity *= sdata->opacityMultiplier;
 
     if (flags & RenderUpdateFlag::Clip) {
         sdata->clips.clear();
         sdata->clips.push(clips);
     }
 
+    if (!sdata->updatePath && !sdata->updateFill && !sdata->updateStroke) return sdata;
+
+    //the tessellation only touches the shape's own buffers, it runs aside until preRender() joins it.
+    if (!sdata->pushed) {
+        sdata->pushed = true;
+        mTasks.push(sdata);
+    }
+
+    //the instances of a shape tessellated in this update wait for it.
+    if (sdata->source && sdata->source->producer) {
+        Array<Task*> deps(1);
+        deps.push(sdata->source->producer);
+        TaskScheduler::request(sdata, deps);
+    } else TaskScheduler::request(sdata);
+
     return sdata;
 }
 
 
 bool GlRenderer::preUpdate()
 {
+    //the previous update may not be rendered, a shape is prepared once in an update.
+    join();
+
     if (mRootTarget.invalid()) return false;
 
     currentContext();
@@ -1416,6 +1511,8 @@ bool GlRenderer::intersectsShape(RenderData data, TVG_UNUSED const RenderRegion&
 {
     if (!data) return false;
     auto shape = (GlShape*)data;
+    shape->done();
+    ARRAY_FOREACH(p, shape->clips) static_cast<GlShape*>(*p)->done();
     if (shape->opacity == 0) return false;
     const auto& bbox = shape->geometry.getBounds();
     if (region.intersected(bbox)) {
@@ -1431,6 +1528,8 @@ bool GlRenderer::intersectsImage(RenderData data, TVG_UNUSED const RenderRegion&
 {
     if (!data) return false;
     auto shape = (GlShape*)data;
+    shape->done();
+    ARRAY_FOREACH(p, shape->clips) static_cast<GlShape*>(*p)->done();
     if (shape->opacity == 0) return false;
     const auto& bbox = shape->geometry.getBounds();
     if (region.intersected(bbox)) {
@@ -28,6 +28,7 @@
 #include "tvgGlRenderTask.h"
 #include "tvgGlGpuBuffer.h"
 #include "tvgGlTextureMgr.h"
+#include "tvgGlTessCache.h"
 #include "tvgGlRenderPass.h"
 #include "tvgGlEffect.h"
 #include "tvgGlStateCache.h"
@@ -167,6 +168,7 @@ struct GlRenderer : RenderMethod
     bool intersectsShape(RenderData data, const RenderRegion& region) override;
     bool intersectsImage(RenderData data, const RenderRegion& region) override;
     Result target(void* display, void* surface, void* context, int32_t id, uint32_t w, uint32_t h, ColorSpace cs);
+    void tessellation(uint32_t* hits, uint32_t* misses);
 
     //composition
     RenderCompositor* target(const RenderRegion& region, ColorSpace cs, CompositionFlag flags) override;
@@ -212,6 +214,7 @@ private:
     void disposeTexture(GLuint texId);
 
     void flush();
+    void join();
     void clearDisposes();
     bool currentContext();
 
@@ -234,6 +237,8 @@ private:
     TextureMgr mTextures;
     GlSolidBatch mSolidBatch;
     GlStencilCoverBatch mStencilCoverBatch;
+    Array<GlShape*> mTasks;  //pending shape tessellations
+    GlTessCache mTessCache;
 
     //Disposed resources. They should be released on synced call.
     struct {
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "tvgGlTessCache.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#define GL_TESS_SCALE_STEPS 16     //scale buckets per octave
+#define GL_TESS_ROTATION_STEPS 64  //rotation buckets per turn
+
+
+//fnv-1a over the 32-bit words
+static uint64_t _hash(uint64_t h, const void* data, size_t size)
+{
+    auto p = static_cast<const uint8_t*>(data);
+    uint32_t word;
+    for (; size >= sizeof(word); size -= sizeof(word), p += sizeof(word)) {
+        memcpy(&word, p, sizeof(word));
+        h = (h ^ word) * 0x100000001b3ULL;
+    }
+    for (; size > 0; --size, ++p) h = (h ^ *p) * 0x100000001b3ULL;
+    return h;
+}
+
+
+template<typename T>
+static uint64_t _hash(uint64_t h, const T& v)
+{
+    return _hash(h, &v, sizeof(T));
+}
+
+
+//translation-only, or a uniform scale and rotation bucket. The skewed, mirrored and non-uniform ones are not shared.
+static uint64_t _transformClass(const Matrix& m)
+{
+    if (m.e11 == 1.0f && m.e22 == 1.0f && m.e12 == 0.0f && m.e21 == 0.0f) return 1;
+
+    auto scale = sqrtf(m.e11 * m.e11 + m.e21 * m.e21);
+    if (!std::isfinite(scale) || scale < FLOAT_EPSILON) return 0;
+    auto tolerance = scale * 1e-4f;
+    if (fabsf(m.e11 - m.e22) > tolerance || fabsf(m.e12 + m.e21) > tolerance) return 0;
+
+    auto scaleBucket = uint64_t(lroundf(log2f(scale) * GL_TESS_SCALE_STEPS) + 4096) & 0x1fff;
+    auto rotationBucket = uint64_t(lroundf(atan2f(m.e21, m.e11) / MATH_2PI * GL_TESS_ROTATION_STEPS) + GL_TESS_ROTATION_STEPS) % GL_TESS_ROTATION_STEPS;
+    return 2 + ((scaleBucket << 8) | rotationBucket);
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+GlTessCache::~GlTessCache()
+{
+    clear();
+}
+
+
+uint64_t GlTessCache::key(const RenderShape& rshape, const Matrix& transform)
+{
+    auto cls = _transformClass(transform);
+    if (cls == 0 || rshape.path.empty()) return 0;
+
+    auto h = _hash(0xcbf29ce484222325ULL, cls);
+    h = _hash(h, rshape.path.cmds.data, rshape.path.cmds.count * sizeof(PathCommand));
+    h = _hash(h, rshape.path.pts.data, rshape.path.pts.count * sizeof(Point));
+    h = _hash(h, rshape.rule);
+
+    if (auto stroke = rshape.stroke) {
+        h = _hash(h, stroke->width);
+        h = _hash(h, stroke->cap);
+        h = _hash(h, stroke->join);
+        h = _hash(h, stroke->miterlimit);
+        h = _hash(h, stroke->trim.begin);
+        h = _hash(h, stroke->trim.end);
+        h = _hash(h, stroke->trim.simultaneous);
+        h = _hash(h, stroke->dash.offset);
+        h = _hash(h, stroke->dash.pattern, stroke->dash.count * sizeof(float));
+    }
+    return h ? h : 1;
+}
+
+
+const GlTessEntry* GlTessCache::find(uint64_t key)
+{
+    auto entry = entries.find(key);
+    if (!entry) {
+        ++misses;
+        return nullptr;
+    }
+    ++hits;
+    lru.remove(*entry);
+    lru.back(*entry);
+    return *entry;
+}
+
+
+const GlTessEntry* GlTessCache::request(uint64_t key, GlShape* producer)
+{
+    auto entry = new GlTessEntry;
+    entry->key = key;
+    entry->producer = producer;
+    entries[key] = entry;
+    lru.back(entry);
+    pending.push(entry);
+    return entry;
+}
+
+
+void GlTessCache::store()
+{
+    ARRAY_FOREACH(p, pending) {
+        auto entry = *p;
+        auto producer = entry->producer;
+        entry->geometry.matrix = producer->geometry.matrix;
+        entry->geometry.reuse(producer->geometry);
+        entry->opacityMultiplier = producer->opacityMultiplier;
+        entry->validFill = producer->validFill;
+        entry->validStroke = producer->validStroke;
+        entry->producer = nullptr;
+        bytes += entry->bytes();
+    }
+    pending.clear();
+
+    //the least recently used ones over the budget
+    while (bytes > GL_TESS_CACHE_BUDGET) {
+        auto entry = lru.front();
+        if (!entry) break;
+        entries.remove(entry->key);
+        bytes -= entry->bytes();
+        delete(entry);
+    }
+}
+
+
+void GlTessCache::frame()
+{
+    frameHits = hits;
+    frameMisses = misses;
+    hits = misses = 0;
+}
+
+
+void GlTessCache::clear()
+{
+    lru.free();
+    entries.clear();
+    pending.clear();
+    bytes = 0;
+}
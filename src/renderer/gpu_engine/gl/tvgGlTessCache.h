@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_GL_TESS_CACHE_H_
+#define _TVG_GL_TESS_CACHE_H_
+
+#include "tvgGlCommon.h"
+#include "tvgMap.h"
+
+#define GL_TESS_CACHE_BUDGET (4 * 1024 * 1024)  //the memory cap of the cached tessellations in bytes
+
+// Tessellations keyed by the path content and the transform class, so the instanced or re-appearing shapes
+// reuse the vertex/index buffers. The entries are looked up on the update thread while the tasks only read
+// them, and they are stored and evicted in store() once all the tasks are joined.
+struct GlTessCache
+{
+    ~GlTessCache();
+
+    static uint64_t key(const RenderShape& rshape, const Matrix& transform);  //0 if the shape can't be cached
+    const GlTessEntry* find(uint64_t key);
+    const GlTessEntry* request(uint64_t key, GlShape* producer);
+    void store();
+    void frame();  //roll over the hit stats of the frame
+    void clear();
+
+    Map<uint64_t, GlTessEntry*> entries;
+    Inlist<GlTessEntry> lru;        //the least recently used at the head
+    Array<GlTessEntry*> pending;    //requested in the current update, their producers are tessellating them
+    size_t bytes = 0;
+    uint32_t hits = 0;         //in the current frame
+    uint32_t misses = 0;
+    uint32_t frameHits = 0;    //in the last frame, see GlCanvas::tessellation()
+    uint32_t frameMisses = 0;
+};
+
+#endif /* _TVG_GL_TESS_CACHE_H_ */
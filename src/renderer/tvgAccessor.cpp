@@ -32,7 +32,7 @@
 
 Accessor::Accessor() = default;
 
-struct AccessorImpl : Accessor
+struct AccessorImpl : Accessor, Allocated
 {
     Paint* paint;
     AccessorCallback cb;
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include "tvgBvh.h"
+
+#define BVH_LEAF_SIZE 4
+#define BVH_MAX_DEPTH 64
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+static inline float _center(const BBox& box, int axis)
+{
+    return axis == 0 ? (box.min.x + box.max.x) * 0.5f : (box.min.y + box.max.y) * 0.5f;
+}
+
+
+void Bvh::split(uint32_t begin, uint32_t end)
+{
+    auto idx = nodes.count;
+    nodes.push(Node{});
+
+    if (end - begin <= BVH_LEAF_SIZE) {
+        auto& node = nodes[idx];
+        node.first = begin;
+        node.count = end - begin;
+        node.box.init();
+        for (auto i = begin; i < end; ++i) merge(node.box, boxes[order[i]]);
+        return;
+    }
+
+    //split at the median of the centers along the longer axis
+    BBox centers;
+    centers.init();
+    for (auto i = begin; i < end; ++i) {
+        auto& box = boxes[order[i]];
+        merge(centers, {{_center(box, 0), _center(box, 1)}, {_center(box, 0), _center(box, 1)}});
+    }
+    auto axis = (centers.w() >= centers.h()) ? 0 : 1;
+    auto mid = begin + (end - begin) / 2;
+    std::nth_element(order.data + begin, order.data + mid, order.data + end, [&](uint32_t a, uint32_t b) {
+        return _center(boxes[a], axis) < _center(boxes[b], axis);
+    });
+
+    split(begin, mid);
+    auto right = nodes.count;
+    split(mid, end);
+
+    auto& node = nodes[idx];
+    node.first = right;
+    node.count = 0;
+    node.box = nodes[idx + 1].box;
+    merge(node.box, nodes[right].box);
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+BBox tvg::operator*(const BBox& box, const Matrix& m)
+{
+    if (unbounded(box) || box.min.x > box.max.x) return box;
+
+    Point pts[4] = {box.min, {box.max.x, box.min.y}, box.max, {box.min.x, box.max.y}};
+    BBox ret;
+    ret.init();
+    for (int i = 0; i < 4; ++i) {
+        auto pt = pts[i] * m;
+        merge(ret, {pt, pt});
+    }
+    return ret;
+}
+
+
+void Bvh::build()
+{
+    nodes.clear();
+    order.clear();
+    if (boxes.empty()) return;
+
+    order.reserve(boxes.count);
+    for (uint32_t i = 0; i < boxes.count; ++i) order.push(i);
+
+    split(0, boxes.count);
+}
+
+
+void Bvh::refit()
+{
+    //the children always follow their parent
+    for (auto i = int32_t(nodes.count) - 1; i >= 0; --i) {
+        auto& node = nodes[i];
+        if (node.count > 0) {
+            node.box.init();
+            for (auto j = node.first; j < node.first + node.count; ++j) merge(node.box, boxes[order[j]]);
+        } else {
+            node.box = nodes[i + 1].box;
+            merge(node.box, nodes[node.first].box);
+        }
+    }
+}
+
+
+void Bvh::query(const BBox& region, Array<uint32_t>& out) const
+{
+    if (nodes.empty()) return;
+
+    uint32_t stack[BVH_MAX_DEPTH];
+    uint32_t top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        auto& node = nodes[stack[--top]];
+        if (!intersected(node.box, region)) continue;
+        if (node.count > 0) {
+            for (auto j = node.first; j < node.first + node.count; ++j) {
+                if (intersected(boxes[order[j]], region)) out.push(order[j]);
+            }
+        } else {
+            stack[top++] = node.first;
+            stack[top++] = uint32_t(&node - nodes.data) + 1;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_BVH_H_
+#define _TVG_BVH_H_
+
+#include "tvgCommon.h"
+#include "tvgArray.h"
+#include "tvgMath.h"
+
+namespace tvg
+{
+
+//an unbounded box, it intersects everything
+static inline void infinite(BBox& box)
+{
+    box.min = {-FLT_MAX, -FLT_MAX};
+    box.max = {FLT_MAX, FLT_MAX};
+}
+
+static inline bool unbounded(const BBox& box)
+{
+    return box.min.x == -FLT_MAX;
+}
+
+static inline void merge(BBox& box, const BBox& rhs)
+{
+    if (rhs.min.x < box.min.x) box.min.x = rhs.min.x;
+    if (rhs.min.y < box.min.y) box.min.y = rhs.min.y;
+    if (rhs.max.x > box.max.x) box.max.x = rhs.max.x;
+    if (rhs.max.y > box.max.y) box.max.y = rhs.max.y;
+}
+
+static inline bool intersected(const BBox& lhs, const BBox& rhs)
+{
+    return (lhs.min.x <= rhs.max.x && lhs.max.x >= rhs.min.x && lhs.min.y <= rhs.max.y && lhs.max.y >= rhs.min.y);
+}
+
+//the axis aligned bounds of the transformed box, an infinite box stays infinite
+BBox operator*(const BBox& box, const Matrix& m);
+
+//bounding volume hierarchy over the item boxes. The items are identified by their indices in the boxes.
+struct Bvh
+{
+    struct Node
+    {
+        BBox box;
+        uint32_t first;  //leaf: the first item in the order, internal: the right child node
+        uint32_t count;  //leaf: the number of items, internal: 0. The left child node follows the internal node.
+    };
+
+    Array<BBox> boxes;      //item boxes, an empty box (min > max) never hits
+    Array<uint32_t> order;  //item indices grouped by the leaves
+    Array<Node> nodes;      //depth first order, nodes[0] is the root
+
+    //rebuilds the hierarchy of the current boxes
+    void build();
+
+    //updates the node boxes bottom-up after the item boxes changed, the hierarchy is kept
+    void refit();
+
+    //appends the indices of the items whose boxes intersect the region, in no particular order
+    void query(const BBox& region, Array<uint32_t>& out) const;
+
+    const BBox* root() const
+    {
+        return nodes.empty() ? nullptr : &nodes[0].box;
+    }
+
+private:
+    void split(uint32_t begin, uint32_t end);
+};
+
+}
+
+#endif //_TVG_BVH_H_
@@ -189,12 +189,23 @@ Result GlCanvas::target(void* display, void* surface, void* context, int32_t id,
 }
 
 
+Result GlCanvas::tessellation(uint32_t* hits, uint32_t* misses) const noexcept
+{
+#ifdef THORVG_GL_ENGINE_SUPPORT
+    static_cast<GlRenderer*>(pImpl->renderer)->tessellation(hits, misses);
+    return Result::Success;
+#endif
+    return Result::NonSupport;
+}
+
+
 GlCanvas* GlCanvas::gen(EngineOption op) noexcept
 {
 #ifdef THORVG_GL_ENGINE_SUPPORT
     if (engineInit > 0) {
         if (op & EngineOption::SmartRender) TVGLOG("RENDERER", "GlCanvas doesn't support Smart Rendering");
         if (op & EngineOption::Aliased) TVGLOG("RENDERER", "GlCanvas doesn't support Aliased");
+        if (op & EngineOption::Tiled) TVGLOG("RENDERER", "GlCanvas doesn't support Tiled Rendering");
         auto renderer = GlRenderer::gen(TaskScheduler::threads(), op);
         if (!renderer) return nullptr;
         renderer->ref();
@@ -254,6 +265,7 @@ WgCanvas* WgCanvas::gen(EngineOption op) noexcept
     if (engineInit > 0) {
         if (op & EngineOption::SmartRender) TVGLOG("RENDERER", "WgCanvas doesn't support Smart Rendering");
         if (op & EngineOption::Aliased) TVGLOG("RENDERER", "WgCanvas doesn't support Aliased");
+        if (op & EngineOption::Tiled) TVGLOG("RENDERER", "WgCanvas doesn't support Tiled Rendering");
         auto renderer = new WgRenderer(TaskScheduler::threads(), op);
         renderer->ref();
         auto ret = new WgCanvas;
@@ -78,7 +78,7 @@ struct Fill::Impl
 };
 
 
-struct RadialGradientImpl : RadialGradient
+struct RadialGradientImpl : RadialGradient, Allocated
 {
     Fill::Impl impl;
     Point center{}, focal{};
@@ -155,7 +155,7 @@ struct RadialGradientImpl : RadialGradient
 };
 
 
-struct LinearGradientImpl :  LinearGradient
+struct LinearGradientImpl : LinearGradient, Allocated
 {
     Fill::Impl impl;
     Point p1{}, p2{};
@@ -23,6 +23,7 @@
 #include "tvgCommon.h"
 #include "tvgTaskScheduler.h"
 #include "tvgLoaderMgr.h"
+#include "tvgRender.h"
 
 #ifdef THORVG_CPU_ENGINE_SUPPORT
     #include "tvgSwRenderer.h"
@@ -43,6 +44,7 @@
 
 namespace tvg {
     int engineInit = 0;
+    Allocator allocator = {};
 }
 
 static uint16_t _version = 0;
@@ -90,10 +92,25 @@ Result Initializer::init(uint32_t threads) noexcept
 
     TaskScheduler::init(threads);
 
+#ifdef THORVG_CPU_ENGINE_SUPPORT
+    SwRenderer::init();
+#endif
+
     return Result::Success;
 }
 
 
+Result Initializer::init(uint32_t threads, const Allocator& allocator) noexcept
+{
+    if (!allocator.malloc || !allocator.calloc || !allocator.realloc || !allocator.free) return Result::InvalidArguments;
+    if (engineInit > 0) return Result::InsufficientCondition;
+
+    tvg::allocator = allocator;
+
+    return init(threads);
+}
+
+
 Result Initializer::term() noexcept
 {
     if (engineInit == 0) return Result::InsufficientCondition;
@@ -116,6 +133,12 @@ Result Initializer::term() noexcept
 
     if (!LoaderMgr::term()) return Result::Unknown;
 
+    //nothing of the user allocator may be left behind in the global storages
+    RenderPath::term();
+
+    //back to the system heap, the user allocator may not outlive the engine
+    tvg::allocator = {};
+
     return Result::Success;
 }
 
@@ -127,31 +150,64 @@ const char* Initializer::version(uint32_t* major, uint32_t* minor, uint32_t* mic
 }
 
 
+Result Initializer::simd(SimdLevel level) noexcept
+{
+    if (engineInit == 0) return Result::InsufficientCondition;
+#ifdef THORVG_CPU_ENGINE_SUPPORT
+    if (SwRenderer::simd(level)) return Result::Success;
+#endif
+    return Result::NonSupport;
+}
+
+
+SimdLevel Initializer::simd() noexcept
+{
+#ifdef THORVG_CPU_ENGINE_SUPPORT
+    return SwRenderer::simd();
+#else
+    return SimdLevel::None;
+#endif
+}
+
+
+Result Initializer::glyphCache(size_t bytes) noexcept
+{
+    if (engineInit == 0) return Result::InsufficientCondition;
+#ifdef THORVG_CPU_ENGINE_SUPPORT
+    SwRenderer::glyphCache(bytes);
+    return Result::Success;
+#else
+    return Result::NonSupport;
+#endif
+}
+
+
 uint16_t THORVG_VERSION_NUMBER()
 {
     return _version;
 }
 
 
+//the global operators serve the whole process, they stay on the system heap. The engine types derive tvg::Allocated instead.
 void* operator new(std::size_t size)
 {
-    return tvg::malloc(size);
+    return std::malloc(size);
 }
 
 
 void operator delete(void* ptr) noexcept
 {
-    tvg::free(ptr);
+    std::free(ptr);
 }
 
 
 void* operator new[](std::size_t size)
 {
-    return tvg::malloc(size);
+    return std::malloc(size);
 }
 
 
 void operator delete[](void* ptr) noexcept
 {
-    tvg::free(ptr);
-}
\ No newline at end of file
+    std::free(ptr);
+}
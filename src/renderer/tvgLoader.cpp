@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgLoader.h"
+
+#ifdef THORVG_FILE_IO_SUPPORT
+    #if defined(__linux__) || defined(__APPLE__)
+        #include <fcntl.h>
+        #include <unistd.h>
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+    #endif
+#endif
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#ifdef THORVG_FILE_IO_SUPPORT
+
+#if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+
+static char* _map(const char* path, uint32_t& size)
+{
+    //don't lock the file against the other users while the view lives, like the posix mapping
+    auto file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    DWORD high;
+    auto low = GetFileSize(file, &high);
+
+    //nothing to map, or too large for the 32-bit sizes
+    if (low == INVALID_FILE_SIZE || low == 0 || high > 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    auto mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) return nullptr;
+
+    //the view keeps the mapping alive
+    auto data = (char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data) size = (uint32_t)low;
+
+    return data;
+}
+
+
+static void _unmap(char* data, TVG_UNUSED uint32_t size)
+{
+    UnmapViewOfFile(data);
+}
+
+#elif defined(__linux__) || defined(__APPLE__)
+
+static char* _map(const char* path, uint32_t& size)
+{
+    auto fd = open(path, O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    //nothing to map, or too large for the 32-bit sizes
+    struct stat info;
+    if (fstat(fd, &info) < 0 || info.st_size <= 0 || (uint64_t)info.st_size > UINT32_MAX) {
+        close(fd);
+        return nullptr;
+    }
+
+    auto data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  //the mapping holds the file
+    if (data == MAP_FAILED) return nullptr;
+
+    //the decoders go through the content once from the front, page it in ahead of them
+    madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+    madvise(data, (size_t)info.st_size, MADV_WILLNEED);
+
+    size = (uint32_t)info.st_size;
+
+    return (char*)data;
+}
+
+
+static void _unmap(char* data, uint32_t size)
+{
+    munmap(data, size);
+}
+
+#else
+
+static char* _map(TVG_UNUSED const char* path, TVG_UNUSED uint32_t& size)
+{
+    return nullptr;
+}
+
+
+static void _unmap(TVG_UNUSED char* data, TVG_UNUSED uint32_t size)
+{
+}
+
+#endif
+
+#endif //THORVG_FILE_IO_SUPPORT
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+char* Loader::open(const char* path, uint32_t& size, bool text)
+{
+#ifdef THORVG_FILE_IO_SUPPORT
+    auto f = fopen(path, text ? "r" : "rb");
+    if (!f) return nullptr;
+
+    fseek(f, 0, SEEK_END);
+
+    size = ftell(f);
+    if (size == 0) {
+        fclose(f);
+        return nullptr;
+    }
+
+    auto content = tvg::malloc<char>(sizeof(char) * (text ? size + 1 : size), AllocTag::Loader);
+    fseek(f, 0, SEEK_SET);
+    size = fread(content, sizeof(char), size, f);
+    if (text) content[size] = '\0';
+
+    fclose(f);
+
+    return content;
+#endif
+    return nullptr;
+}
+
+
+char* Loader::map(const char* path, uint32_t& size)
+{
+#ifdef THORVG_FILE_IO_SUPPORT
+    if (auto data = _map(path, size)) {
+        mapped = true;
+        return data;
+    }
+    //not mappable here, take a copy instead
+    mapped = false;
+    return open(path, size);
+#endif
+    return nullptr;
+}
+
+
+void Loader::unmap(char* data, TVG_UNUSED uint32_t size)
+{
+    if (!data) return;
+#ifdef THORVG_FILE_IO_SUPPORT
+    if (mapped) {
+        _unmap(data, size);
+        mapped = false;
+        return;
+    }
+#endif
+    tvg::free(data);
+}
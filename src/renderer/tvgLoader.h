@@ -63,7 +63,7 @@ struct PictureOps : LoaderOps
         LoaderOps{Type::Picture, owner}, resolver(resolver), rpath(rpath), accessible(accessible) {}
 };
 
-struct Loader
+struct Loader : Allocated
 {
     INLIST_ITEM(Loader);
 
@@ -76,6 +76,7 @@ struct Loader
     Ownership owner = Ownership::Borrow;
     bool readied = false;        // read done already
     bool cached = false;         // cached for sharing
+    bool mapped = false;         // the file content is mapped by map()
 
     Loader(FileType type) : type(type) {}
 
@@ -129,31 +130,12 @@ struct Loader
         return false;
     }
 
-    char* open(const char* path, uint32_t& size, bool text = false)
-    {
-#ifdef THORVG_FILE_IO_SUPPORT
-        auto f = fopen(path, text ? "r" : "rb");
-        if (!f) return nullptr;
-
-        fseek(f, 0, SEEK_END);
-
-        size = ftell(f);
-        if (size == 0) {
-            fclose(f);
-            return nullptr;
-        }
-
-        auto content = tvg::malloc<char>(sizeof(char) * (text ? size + 1 : size));
-        fseek(f, 0, SEEK_SET);
-        size = fread(content, sizeof(char), size, f);
-        if (text) content[size] = '\0';
+    // read the whole file into a writable buffer, null-terminated for the text parsers. Free it with tvg::free()
+    char* open(const char* path, uint32_t& size, bool text = false);
 
-        fclose(f);
-
-        return content;
-#endif
-        return nullptr;
-    }
+    // read-only view of the whole file, mapped without a copy if the platform supports it. Release it with unmap()
+    char* map(const char* path, uint32_t& size);
+    void unmap(char* data, uint32_t size);
 };
 
 struct ImageLoader : Loader
@@ -226,12 +208,18 @@ struct FontLoader : Loader
     static constexpr const float DPI = 96.0f / 72.0f;  // dpi base?
 
     char* name = nullptr;
+    uint32_t id;  //unique over the font loaders, the key of the glyph caches
 
-    FontLoader(FileType type) : Loader(type) {}
+    FontLoader(FileType type) : Loader(type)
+    {
+        static std::atomic<uint32_t> ids{0};
+        id = ++ids;
+    }
 
     using Loader::read;
 
-    virtual bool get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out) = 0;
+    //the glyphs of the path are laid out in the run if it's given
+    virtual bool get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out, RenderGlyphRun* run) = 0;
     virtual void transform(Paint* paint, FontMetrics& fm, float italicShear) = 0;
     virtual void release(FontMetrics& fm) = 0;
     virtual void metrics(const FontMetrics& fm, TextMetrics& out) = 0;
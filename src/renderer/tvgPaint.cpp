@@ -134,6 +134,38 @@ RenderRegion Paint::Impl::bounds()
     return ret;
 }
 
+//conservative bounds in the local space without the rendering, infinite if they can't be determined
+BBox Paint::Impl::lbounds()
+{
+    BBox ret;
+
+    //the masking may extend the region beyond the paint
+    if (maskData) {
+        infinite(ret);
+        return ret;
+    }
+
+    PAINT_METHOD(ret, lbounds());
+    return ret;
+}
+
+
+//conservative test with the local bounds, the paint might be invisible even if it's not outside.
+bool Paint::Impl::outside(RenderMethod* renderer, const Matrix& m)
+{
+    //the containers would gather the bounds over their subtrees, their children are tested by themselves.
+    if (paint->type() == Type::Scene || (paint->type() == Type::Picture && !to<PictureImpl>(paint)->bitmap)) return false;
+
+    auto box = lbounds();
+    if (unbounded(box)) return false;
+    box = box * m;
+
+    //one pixel margin for the anti-aliasing
+    auto vport = renderer->viewport();
+    return (box.max.x < vport.min.x - 1 || box.min.x > vport.max.x + 1 || box.max.y < vport.min.y - 1 || box.min.y > vport.max.y + 1);
+}
+
+
 AccessorIterator* Paint::Impl::iterator()
 {
     AccessorIterator* ret;
@@ -163,7 +195,7 @@ Paint* Paint::Impl::duplicate(Paint* ret)
 
 bool Paint::Impl::render(RenderMethod* renderer, CompositionFlag flag)
 {
-    if (hidden || opacity == 0) return true;
+    if (hidden || culled || opacity == 0) return true;
 
     RenderCompositor* cmp = nullptr;
 
@@ -212,6 +244,14 @@ RenderData Paint::Impl::update(RenderMethod* renderer, const Matrix& pm, Array<R
 
     if (renderFlag & RenderUpdateFlag::Transform) tr.update();
 
+    /* 0. Viewport Culling: the clippers must be prepared regardless, they are referred by the owner. */
+    if (!clipper && outside(renderer, pm * tr.m)) {
+        mark(flag);
+        cull();
+        return rd;
+    }
+    culled = false;
+
     /* 1. Composition Pre Processing */
     RenderData trd = nullptr;                 //composite target render data
     RenderRegion viewport;
@@ -281,7 +321,7 @@ bool Paint::Impl::bounds(Point* pt4, const Matrix* pm, bool obb)
 
 bool Paint::Impl::intersects(const RenderRegion& region, bool visibleOnly)
 {
-    if (visibleOnly && hidden) return false;
+    if ((visibleOnly && hidden) || culled) return false;
     if (renderer) {
         bool ret;
         PAINT_METHOD(ret, intersects(region, visibleOnly));
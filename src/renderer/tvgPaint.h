@@ -26,6 +26,7 @@
 #include "tvgCommon.h"
 #include "tvgRender.h"
 #include "tvgMath.h"
+#include "tvgBvh.h"
 
 #define PAINT(A) ((Paint::Impl*)A->pImpl)
 
@@ -77,11 +78,17 @@ struct Paint::Impl
     uint8_t ctxFlag;           //See enum ContextFlag
     uint8_t opacity;
     bool hidden : 1;
+    bool culled : 1;           //out of the viewport, it skips the update and rendering
+    bool lcached : 1;          //the cached local bounds are valid
+    bool indexed : 1;          //the bounds in the parent index are valid
 
     Impl(Paint* pnt) : paint(pnt)
     {
         pnt->pImpl = this;
         hidden = false;
+        culled = false;
+        lcached = false;
+        indexed = false;
         reset();
     }
 
@@ -151,6 +158,15 @@ struct Paint::Impl
     void mark(RenderUpdateFlag flag)
     {
         renderFlag |= flag;
+        if (flag & (RenderUpdateFlag::Path | RenderUpdateFlag::Stroke)) lcached = indexed = false;
+        else if (flag & RenderUpdateFlag::Transform) indexed = false;
+    }
+
+    //out of the viewport, the changes must be kept to be applied when it comes back
+    void cull()
+    {
+        if (!culled && rd) damage();  //clear the last drawn region
+        culled = true;
     }
 
     bool transform(const Matrix& m)
@@ -196,6 +212,8 @@ struct Paint::Impl
     {
         if (target && PAINT(target)->parent) return Result::InsufficientCondition;
 
+        indexed = false;  //the masking changes the bounds
+
         if (maskData) {
             PAINT(maskData->target)->unref(maskData->target != target);
             tvg::free(maskData);
@@ -301,6 +319,8 @@ struct Paint::Impl
     bool intersects(const RenderRegion& region, bool visibleOnly);
     RenderRegion bounds();
     bool bounds(Point* pt4, const Matrix* pm, bool obb);
+    BBox lbounds();
+    bool outside(RenderMethod* renderer, const Matrix& m);
     AccessorIterator* iterator();
     RenderData update(RenderMethod* renderer, const Matrix& pm, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag pFlag, bool clipper = false);
     bool render(RenderMethod* renderer, CompositionFlag flag = CompositionFlag::Invalid);
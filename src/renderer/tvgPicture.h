@@ -31,7 +31,7 @@
 namespace tvg
 {
 
-struct PictureImpl : Picture
+struct PictureImpl : Picture, Allocated
 {
     Paint::Impl impl;
     ImageLoader* loader = nullptr;
@@ -289,6 +289,26 @@ struct PictureImpl : Picture
         return ret;
     }
 
+    //the bitmap is fitted in the picture size, the vector contents are bounded by themselves.
+    //unbounded until the contents are loaded and resized by the update.
+    BBox lbounds()
+    {
+        BBox box;
+        auto pivot = Point{-origin.x * float(w), -origin.y * float(h)};
+
+        if (bitmap && !tvg::zero(loader->w) && !tvg::zero(loader->h)) {
+            auto sx = w / loader->w;
+            auto sy = h / loader->h;
+            auto scale = sx < sy ? sx : sy;
+            box = {pivot, {pivot.x + loader->w * scale, pivot.y + loader->h * scale}};
+        } else if (vector && !resizing) {
+            box = PAINT(vector)->lbounds();
+            if (!unbounded(box)) box = box * (Matrix{1, 0, pivot.x, 0, 1, pivot.y, 0, 0, 1} * PAINT(vector)->transform());
+        } else infinite(box);
+
+        return box;
+    }
+
     RenderRegion bounds()
     {
         if (vector) return vector->pImpl->bounds();
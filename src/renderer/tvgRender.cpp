@@ -58,14 +58,25 @@ bool RenderMethod::viewport(const RenderRegion& vp)
 /* RenderPath Class Implementation                                      */
 /************************************************************************/
 
+static thread_local RenderPath _scratches[3];  // tripple-buffering
+static thread_local int _scratchIdx = 0;
+
 // used as a temporary buffer
 RenderPath& RenderPath::scratch()
 {
-    static thread_local RenderPath dbuffers[3];  // tripple-buffering
-    static thread_local int idx = 0;
-    if (++idx > 2) idx = 0;
-    dbuffers[(idx)].clear();
-    return dbuffers[(int)idx];
+    if (++_scratchIdx > 2) _scratchIdx = 0;
+    _scratches[_scratchIdx].clear();
+    return _scratches[_scratchIdx];
+}
+
+
+// the worker threads release theirs on exit
+void RenderPath::term()
+{
+    for (auto& p : _scratches) {
+        p.cmds.reset();
+        p.pts.reset();
+    }
 }
 
 void RenderPath::addCircle(float cx, float cy, float rx, float ry, bool cw)
@@ -101,7 +101,7 @@ struct RenderSurface
     }
 };
 
-struct RenderCompositor
+struct RenderCompositor : Allocated
 {
     MaskMethod method;
     uint8_t opacity;
@@ -337,6 +337,7 @@ struct RenderPath
     void addRect(float x, float y, float w, float h, float rx, float ry, bool cw);
 
     static RenderPath& scratch();
+    static void term();  //releases the scratch buffers of this thread
 };
 
 struct RenderTrimPath
@@ -401,12 +402,28 @@ struct RenderStroke
     }
 };
 
+struct RenderGlyph
+{
+    const RenderPath* path;  //the outline in the font units
+    Point pos;               //the origin in the text space
+    uint32_t idx;            //the glyph index in the font
+};
+
+//the glyph layout of a text. The engines may draw the glyphs with their cached images instead of the path.
+struct RenderGlyphRun
+{
+    Array<RenderGlyph> glyphs;
+    uint32_t font = 0;       //unique font id
+    float em = 0.0f;         //font units per em
+};
+
 struct RenderShape
 {
     RenderPath path;
     Fill *fill = nullptr;
     RenderColor color{};
     RenderStroke *stroke = nullptr;
+    const RenderGlyphRun* glyphs = nullptr;  //the glyphs of the path if it's a text
     FillRule rule = FillRule::NonZero;
 
     ~RenderShape()
@@ -479,7 +496,7 @@ struct RenderShape
     }
 };
 
-struct RenderEffect
+struct RenderEffect : Allocated
 {
     RenderData rd = nullptr;
     RenderRegion extend{};
@@ -594,7 +611,7 @@ struct RenderEffectTritone : RenderEffect
     }
 };
 
-struct RenderMethod
+struct RenderMethod : Allocated
 {
 private:
     uint32_t refCnt = 0;
@@ -57,6 +57,14 @@ const list<Paint*>& Scene::paints() const noexcept
 }
 
 
+Result Scene::query(int32_t x, int32_t y, int32_t w, int32_t h, list<Paint*>& paints, bool visibleOnly) noexcept
+{
+    if (w <= 0 || h <= 0) return Result::InvalidArguments;
+    to<SceneImpl>(this)->query({{x, y}, {x + w, y + h}}, visibleOnly, paints);
+    return Result::Success;
+}
+
+
 Result Scene::add(SceneEffect effect, ...) noexcept
 {
     va_list args;
@@ -28,12 +28,28 @@
 #include "tvgPaint.h"
 #include "tvgAccessor.h"
 
-struct SceneImpl : Scene
+#define SCENE_INDEX_THRESHOLD 32   //the number of the children worth the bvh
+
+//the bounding volume hierarchy of the children in the scene space
+struct SceneIndex
+{
+    Bvh bvh;
+    Array<Paint*> paints;     //the children in the order, the bvh items
+    Array<uint32_t> hits;     //query results
+    Array<uint32_t> active;   //the children in the viewport of the last update, in the order
+    Array<uint8_t> visible;   //per-child visibility of the last update
+    Array<RenderUpdateFlag> pending;  //the updates the culled children missed
+    Matrix transform;         //the scene transform of the last update
+    bool dirty = true;        //the children list changed
+};
+
+struct SceneImpl : Scene, Allocated
 {
     Paint::Impl impl;
     list<Paint*> paints;     //children list
     RenderRegion vport = {};
     Array<RenderEffect*>* effects = nullptr;
+    SceneIndex* index = nullptr;
     Point fsize;          //fixed scene size
     bool fixed = false;   //true: fixed scene size, false: dynamic size
     bool vdirty = false;
@@ -47,6 +63,7 @@ struct SceneImpl : Scene
     {
         clearPaints();
         resetEffects(false);
+        delete(index);
     }
 
     void size(const Point& size)
@@ -83,6 +100,131 @@ struct SceneImpl : Scene
         return false;
     }
 
+    //the children list is changing, hands over the missed updates while the children are alive
+    void invalidate()
+    {
+        if (!index || index->dirty) return;
+        for (uint32_t i = 0; i < index->pending.count; ++i) {
+            if (index->pending[i] != RenderUpdateFlag::None) PAINT(index->paints[i])->mark(index->pending[i]);
+        }
+        index->pending.clear();
+        index->dirty = true;
+    }
+
+    //rebuilds or refits the bvh with the current children
+    void reindex()
+    {
+        auto& bvh = index->bvh;
+
+        if (index->dirty) {
+            index->paints.clear();
+            bvh.boxes.clear();
+            for (auto paint : paints) {
+                PAINT(paint)->indexed = true;
+                index->pending.push(RenderUpdateFlag::None);
+                index->paints.push(paint);
+                bvh.boxes.push(PAINT(paint)->lbounds() * PAINT(paint)->transform());
+            }
+            bvh.build();
+            index->dirty = false;
+            return;
+        }
+
+        uint32_t changed = 0;
+        for (uint32_t i = 0; i < index->paints.count; ++i) {
+            auto paint = index->paints[i];
+            //the nested scenes, the pictures and the texts don't know their contents changes
+            if (PAINT(paint)->indexed && paint->type() == Type::Shape) continue;
+            PAINT(paint)->indexed = true;
+            auto box = PAINT(paint)->lbounds() * PAINT(paint)->transform();
+            if (memcmp(&box, &bvh.boxes[i], sizeof(BBox))) {
+                bvh.boxes[i] = box;
+                ++changed;
+            }
+        }
+
+        if (changed == 0) return;
+
+        //a refit loosens the hierarchy as the children move
+        if (changed > index->paints.count / 2) bvh.build();
+        else bvh.refit();
+    }
+
+    //collects the children whose bounds intersect the region in the device space
+    void candidates(const RenderRegion& region, const Matrix& transform)
+    {
+        index->hits.clear();
+
+        Matrix inv;
+        if (!inverse(&transform, &inv)) {
+            for (uint32_t i = 0; i < index->paints.count; ++i) index->hits.push(i);
+            return;
+        }
+
+        //one pixel margin for the anti-aliasing
+        BBox box = {{float(region.min.x - 1), float(region.min.y - 1)}, {float(region.max.x + 1), float(region.max.y + 1)}};
+        index->bvh.query(box * inv, index->hits);
+    }
+
+    //culls the children out of the viewport at once, the others are tested by themselves in their updates.
+    void cull(RenderMethod* renderer, const Matrix& transform, RenderUpdateFlag flag)
+    {
+        if (paints.size() < SCENE_INDEX_THRESHOLD) {
+            if (index) {
+                delete(index);
+                index = nullptr;
+            }
+            return;
+        }
+
+        if (!index) index = new SceneIndex;
+
+        //a new hierarchy has no history, assume all the children were visible
+        auto& visible = index->visible;
+        if (index->dirty) {
+            reindex();
+            visible.reserve(index->paints.count);
+            visible.count = index->paints.count;
+            memset(visible.data, 1, visible.count);
+        } else reindex();
+
+        index->transform = transform;
+        candidates(renderer->viewport(), transform);
+        std::swap(index->active, index->hits);
+        std::sort(index->active.begin(), index->active.end());
+
+        //the children which went out of the viewport must clear their last drawn regions
+        ARRAY_FOREACH(p, index->active) visible[*p] |= 2;
+        for (uint32_t i = 0; i < visible.count; ++i) {
+            if (visible[i] == 1) PAINT(index->paints[i])->cull();
+            if (!(visible[i] & 2)) index->pending[i] |= flag;
+            visible[i] >>= 1;
+        }
+    }
+
+    BBox lbounds()
+    {
+        BBox box;
+
+        //the post effects may extend the region
+        if (effects) {
+            infinite(box);
+            return box;
+        }
+
+        if (index && !index->dirty) {
+            reindex();
+            if (auto root = index->bvh.root()) return *root;
+        }
+
+        box.init();
+        for (auto paint : paints) {
+            merge(box, PAINT(paint)->lbounds() * PAINT(paint)->transform());
+            if (unbounded(box)) break;
+        }
+        return box;
+    }
+
     bool update(RenderMethod* renderer, const Matrix& transform, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flag, TVG_UNUSED bool clipper)
     {
         if (paints.empty()) return true;
@@ -97,8 +239,18 @@ struct SceneImpl : Scene
         //allow partial rendering?
         auto recover = fixed ? renderer->partial(true) : false;
 
-        for (auto paint : paints) {
-            PAINT(paint)->update(renderer, transform, clips, opacity, flag, false);
+        cull(renderer, transform, flag);
+
+        if (index) {
+            ARRAY_FOREACH(p, index->active) {
+                auto& pending = index->pending[*p];
+                PAINT(index->paints[*p])->update(renderer, transform, clips, opacity, flag | pending, false);
+                pending = RenderUpdateFlag::None;
+            }
+        } else {
+            for (auto paint : paints) {
+                PAINT(paint)->update(renderer, transform, clips, opacity, flag, false);
+            }
         }
 
         //recover the condition
@@ -143,8 +295,13 @@ struct SceneImpl : Scene
             renderer->beginComposite(cmp, MaskMethod::None, opacity);
         }
 
-        for (auto paint : paints) {
-            ret &= paint->pImpl->render(renderer, impl.cmpFlag);
+        //the culled children are skipped at once
+        if (index && !index->dirty) {
+            ARRAY_FOREACH(p, index->active) ret &= PAINT(index->paints[*p])->render(renderer, impl.cmpFlag);
+        } else {
+            for (auto paint : paints) {
+                ret &= paint->pImpl->render(renderer, impl.cmpFlag);
+            }
         }
 
         if (cmp) {
@@ -171,6 +328,7 @@ struct SceneImpl : Scene
         //Merge regions
         RenderRegion pRegion = {{INT32_MAX, INT32_MAX}, {0, 0}};
         for (auto paint : paints) {
+            if (PAINT(paint)->culled) continue;
             auto region = paint->pImpl->bounds();
             if (region.min.x < pRegion.min.x) pRegion.min.x = region.min.x;
             if (pRegion.max.x < region.max.x) pRegion.max.x = region.max.x;
@@ -235,15 +393,43 @@ struct SceneImpl : Scene
     {
         if (!impl.renderer) return false;
 
-        if (this->bounds().intersected(region)) {
-            for (auto paint : paints) {
-                if (PAINT(paint)->intersects(region, visibleOnly)) return true;
+        if (!this->bounds().intersected(region)) return false;
+
+        if (index && !index->dirty) {
+            candidates(region, index->transform);
+            ARRAY_FOREACH(p, index->hits) {
+                if (PAINT(index->paints[*p])->intersects(region, visibleOnly)) return true;
             }
+            return false;
+        }
+
+        for (auto paint : paints) {
+            if (PAINT(paint)->intersects(region, visibleOnly)) return true;
         }
 
         return false;
     }
 
+    void query(const RenderRegion& region, bool visibleOnly, list<Paint*>& out)
+    {
+        if (!impl.renderer || (visibleOnly && impl.hidden) || impl.culled) return;
+        if (!this->bounds().intersected(region)) return;
+
+        auto collect = [&](Paint* paint) {
+            if (paint->type() == Type::Scene) to<SceneImpl>(paint)->query(region, visibleOnly, out);
+            else if (PAINT(paint)->intersects(region, visibleOnly)) out.push_back(paint);
+        };
+
+        if (index && !index->dirty) {
+            candidates(region, index->transform);
+            std::sort(index->hits.begin(), index->hits.end());
+            ARRAY_FOREACH(p, index->hits) collect(index->paints[*p]);
+            return;
+        }
+
+        for (auto paint : paints) collect(paint);
+    }
+
     Paint* duplicate(Paint* ret)
     {
         if (ret) TVGERR("RENDERER", "TODO: duplicate()");
@@ -306,11 +492,14 @@ struct SceneImpl : Scene
         auto recover = (fixed && impl.renderer) ? impl.renderer->partial(true) : false;
         auto partialDmg = !(effects || fixed || recover);
 
+        invalidate();
+
         auto itr = paints.begin();
         while (itr != paints.end()) {
             auto paint = PAINT((*itr));
             //when the paint is destroyed damage will be triggered
             if (paint->refCnt > 1 && partialDmg) paint->damage();
+            paint->culled = false;
             paint->unref();
             paints.erase(itr++);
         }
@@ -323,8 +512,10 @@ struct SceneImpl : Scene
     Result remove(Paint* paint)
     {
         if (PAINT(paint)->parent != this) return Result::InsufficientCondition;
+        invalidate();
         //when the paint is destroyed damage will be triggered
         if (PAINT(paint)->refCnt > 1) PAINT(paint)->damage();
+        PAINT(paint)->culled = false;
         PAINT(paint)->unref();
         paints.remove(paint);
         return Result::Success;
@@ -354,6 +545,8 @@ struct SceneImpl : Scene
             paints.insert(itr, target);
         }
         timpl->parent = this;
+        timpl->culled = false;
+        invalidate();
         if (timpl->clipper) PAINT(timpl->clipper)->parent = this;
         if (timpl->maskData) PAINT(timpl->maskData->target)->parent = this;
         return Result::Success;
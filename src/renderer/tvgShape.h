@@ -30,11 +30,12 @@
 namespace tvg
 {
 
-struct ShapeImpl : Shape
+struct ShapeImpl : Shape, Allocated
 {
     Paint::Impl impl;
     RenderShape rs;
-    uint8_t opacity;    //for composition
+    BBox lbox;            //cached lbounds()
+    uint8_t opacity;      //for composition
 
     ShapeImpl() : impl(Paint::Impl(this))
     {
@@ -117,6 +118,23 @@ struct ShapeImpl : Shape
         return impl.renderer->region(impl.rd);
     }
 
+    BBox lbounds()
+    {
+        if (!impl.lcached) {
+            if (!rs.path.bounds(nullptr, lbox)) lbox.init();
+            else if (rs.stroke && rs.stroke->width > 0.0f) {
+                //the miter joins and the square caps reach the farthest
+                auto pad = rs.stroke->width * 0.5f * std::max(rs.stroke->miterlimit, 1.4143f);
+                lbox.min.x -= pad;
+                lbox.min.y -= pad;
+                lbox.max.x += pad;
+                lbox.max.y += pad;
+            }
+            impl.lcached = true;
+        }
+        return lbox;
+    }
+
     bool bounds(Point* pt4, const Matrix& m, bool obb)
     {
         auto fallback = true;  //TODO: remove this when all backend engines support bounds()
@@ -33,61 +33,104 @@ namespace tvg {
 
 #ifdef THORVG_THREAD_SUPPORT
 
-struct TaskQueue {
-    Inlist<Task>             taskDeque;
-    mutex                    mtx;
-    condition_variable       ready;
-    bool                     done = false;
+#define SPIN_CNT 64
 
-    bool tryPop(Task** task)
-    {
-        unique_lock<mutex> lock{mtx, try_to_lock};
-        if (!lock || taskDeque.empty()) return false;
-        *task = taskDeque.front();
-        return true;
-    }
+static thread_local int32_t _worker = -1;   //deque index of the current worker thread
 
-    bool tryPush(Task* task)
+//Chase-Lev work-stealing deque. The owner thread pushes and pops at the bottom, the others steal from the top.
+struct TaskDeque
+{
+    struct Buffer
     {
+        atomic<Task*>* slots;
+        int64_t mask;
+
+        Buffer(int64_t size) : slots(new atomic<Task*>[size]), mask(size - 1) {}
+        ~Buffer() { delete[] slots; }
+
+        Task* get(int64_t i)
         {
-            unique_lock<mutex> lock{mtx, try_to_lock};
-            if (!lock) return false;
-            taskDeque.back(task);
+            return slots[i & mask].load(memory_order_relaxed);
         }
-        ready.notify_one();
-        return true;
-    }
 
-    void complete()
-    {
+        void put(int64_t i, Task* task)
         {
-            lock_guard<mutex> lock{mtx};
-            done = true;
+            slots[i & mask].store(task, memory_order_relaxed);
         }
-        ready.notify_all();
+    };
+
+    atomic<int64_t>          top{0};
+    atomic<int64_t>          bottom{0};
+    atomic<Buffer*>          buffer;
+    Array<Buffer*>           retired;   //the thieves could still read the previous buffers
+
+    TaskDeque()
+    {
+        buffer.store(new Buffer(64), memory_order_relaxed);
     }
 
-    bool pop(Task** task)
+    ~TaskDeque()
     {
-        unique_lock<mutex> lock{mtx};
+        delete(buffer.load(memory_order_relaxed));
+        ARRAY_FOREACH(p, retired) delete(*p);
+    }
 
-        while (taskDeque.empty() && !done) {
-            ready.wait(lock);
+    Buffer* grow(Buffer* cur, int64_t b, int64_t t)
+    {
+        auto buf = new Buffer((cur->mask + 1) * 2);
+        for (auto i = t; i < b; ++i) buf->put(i, cur->get(i));
+        retired.push(cur);
+        buffer.store(buf, memory_order_release);
+        return buf;
+    }
+
+    //owner only
+    void push(Task* task)
+    {
+        auto b = bottom.load(memory_order_relaxed);
+        auto t = top.load(memory_order_acquire);
+        auto buf = buffer.load(memory_order_relaxed);
+        if (b - t > buf->mask) buf = grow(buf, b, t);
+        buf->put(b, task);
+        atomic_thread_fence(memory_order_release);
+        bottom.store(b + 1, memory_order_relaxed);
+    }
+
+    //owner only
+    Task* pop()
+    {
+        auto b = bottom.load(memory_order_relaxed) - 1;
+        auto buf = buffer.load(memory_order_relaxed);
+        bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        auto t = top.load(memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, memory_order_relaxed);
+            return nullptr;
         }
 
-        if (taskDeque.empty()) return false;
+        auto task = buf->get(b);
 
-        *task = taskDeque.front();
-        return true;
+        //the last one, race against the thieves
+        if (t == b) {
+            if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) task = nullptr;
+            bottom.store(b + 1, memory_order_relaxed);
+        }
+        return task;
     }
 
-    void push(Task* task)
+    Task* steal()
     {
-        {
-            lock_guard<mutex> lock{mtx};
-            taskDeque.back(task);
-        }
-        ready.notify_one();
+        auto t = top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        auto b = bottom.load(memory_order_acquire);
+
+        if (t >= b) return nullptr;
+
+        auto task = buffer.load(memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) return nullptr;
+        return task;
     }
 };
 
@@ -95,66 +138,246 @@ struct TaskQueue {
 struct TaskSchedulerImpl
 {
     Array<thread*>                 threads;
-    Array<TaskQueue*>              taskQueues;
-    atomic<uint32_t>               idx{0};
-
-    TaskSchedulerImpl(uint32_t threadCnt)
+    Array<TaskDeque*>              deques;      //[0]: the dominant thread, [1 ~ n]: workers
+    ThreadID                       owner;       //the dominant thread
+
+    //tasks requested by the other threads
+    Inlist<Task>                   inbox;
+    mutex                          inboxMtx;
+    atomic<uint32_t>               inboxCnt{0};
+
+    atomic<int32_t>                queued{0};   //requested but not taken yet
+    atomic<uint32_t>               idles{0};
+    atomic<uint32_t>               waiters{0};
+    mutex                          mtx;
+    condition_variable             idle;        //sleeping workers
+    condition_variable             wait;        //sleeping waiters of the tasks
+    bool                           exit = false;
+
+    TaskSchedulerImpl(uint32_t threadCnt) : owner(this_thread::get_id())
     {
         threads.reserve(threadCnt);
-        taskQueues.reserve(threadCnt);
+        deques.reserve(threadCnt + 1);
 
-        for (uint32_t i = 0; i < threadCnt; ++i) {
-            taskQueues.push(new TaskQueue);
-            threads.push(new thread);
+        for (uint32_t i = 0; i <= threadCnt; ++i) {
+            deques.push(new TaskDeque);
         }
         for (uint32_t i = 0; i < threadCnt; ++i) {
-            *threads.data[i] = thread([&, i] { run(i); });
+            threads.push(new thread([&, i] { run(i + 1); }));
         }
     }
 
     ~TaskSchedulerImpl()
     {
-        ARRAY_FOREACH(p, taskQueues) {
-            (*p)->complete();
+        {
+            lock_guard<mutex> lock{mtx};
+            exit = true;
         }
+        idle.notify_all();
+
         ARRAY_FOREACH(p, threads) {
             (*p)->join();
             delete(*p);
         }
-        ARRAY_FOREACH(p, taskQueues) {
+        ARRAY_FOREACH(p, deques) {
             delete(*p);
         }
     }
 
-    void run(unsigned i)
+    int32_t index()
+    {
+        if (_worker > 0) return _worker;
+        if (this_thread::get_id() == owner) return 0;
+        return -1;
+    }
+
+    Task* fetch(int32_t i)
+    {
+        Task* task = nullptr;
+
+        if (i >= 0) task = deques[i]->pop();
+
+        //steal the others
+        if (!task) {
+            auto start = (i >= 0) ? i : 0;
+            for (uint32_t n = 1; n <= deques.count && !task; ++n) {
+                task = deques[(start + n) % deques.count]->steal();
+            }
+        }
+
+        if (!task && inboxCnt.load(memory_order_relaxed) > 0) {
+            lock_guard<mutex> lock{inboxMtx};
+            if ((task = inbox.front())) --inboxCnt;
+        }
+
+        if (task) --queued;
+        return task;
+    }
+
+    void execute(Task* task, unsigned tid)
     {
-        Task* task;
+        task->run(tid);
+
+        auto edge = task->successors.exchange(Task::closed(), memory_order_acq_rel);
+        task->ready.store(true, memory_order_seq_cst);
+
+        //don't touch the task anymore, it could be released by the waiter.
+        if (waiters.load(memory_order_seq_cst) > 0) {
+            lock_guard<mutex> lock{mtx};
+            wait.notify_all();
+        }
+
+        //release the successors
+        while (edge) {
+            auto next = edge->next;
+            if (edge->task->deps.fetch_sub(1, memory_order_acq_rel) == 1) push(edge->task);
+            tvg::free(edge);
+            edge = next;
+        }
+    }
+
+    void run(int32_t i)
+    {
+        _worker = i;
 
         //Thread Loop
         while (true) {
-            auto success = false;
-            for (uint32_t x = 0; x < threads.count * 2; ++x) {
-                if (taskQueues[(i + x) % threads.count]->tryPop(&task)) {
-                    success = true;
+            if (auto task = fetch(i)) {
+                execute(task, i);
+                continue;
+            }
+
+            //spin, then sleep until a new task is requested
+            auto found = false;
+            for (uint32_t n = 0; n < SPIN_CNT; ++n) {
+                if (queued.load(memory_order_relaxed) > 0) {
+                    found = true;
+                    break;
+                }
+                this_thread::yield();
+            }
+            if (found) continue;
+
+            unique_lock<mutex> lock{mtx};
+            ++idles;
+            while (queued.load(memory_order_seq_cst) <= 0 && !exit) idle.wait(lock);
+            --idles;
+            if (exit && queued.load() <= 0) break;
+        }
+    }
+
+    //help the scheduler by running the pending tasks until the target is completed.
+    void help(Task* target, bool others = true)
+    {
+        auto i = index();
+        auto helpable = (others && i >= 0 && TaskScheduler::locks() == 0);
+
+        for (uint32_t n = 0; !target->ready.load(memory_order_acquire);) {
+            if (helpable) {
+                if (auto task = fetch(i)) {
+                    execute(task, i);
+                    n = 0;
+                    continue;
+                }
+            }
+            if (++n < SPIN_CNT) {
+                this_thread::yield();
+                continue;
+            }
+            //the target is running on the other thread
+            unique_lock<mutex> lock{mtx};
+            ++waiters;
+            while (!target->ready.load(memory_order_seq_cst)) wait.wait(lock);
+            --waiters;
+        }
+    }
+
+    void push(Task* task)
+    {
+        ++queued;
+
+        auto i = index();
+        if (i >= 0) deques[i]->push(task);
+        else {
+            lock_guard<mutex> lock{inboxMtx};
+            inbox.back(task);
+            ++inboxCnt;
+        }
+
+        if (idles.load(memory_order_seq_cst) > 0) {
+            lock_guard<mutex> lock{mtx};
+            idle.notify_one();
+        }
+    }
+
+    //fork-join. the caller runs the first task and takes back the others not stolen yet.
+    //it doesn't run any other tasks while joining, since the caller could be in the middle of a task.
+    void invoke(const Array<Task*>& tasks, unsigned tid)
+    {
+        auto i = index();
+
+        if (threads.count == 0 || i < 0) {
+            ARRAY_FOREACH(p, tasks) (*p)->run(tid);
+            return;
+        }
+
+        for (auto p = tasks.end() - 1; p > tasks.begin(); --p) {
+            (*p)->prepare();
+            push(*p);
+        }
+
+        tasks.first()->run(tid);
+
+        //the requested ones are on the bottom of the deque
+        while (auto task = deques[i]->pop()) {
+            auto mine = false;
+            ARRAY_FOREACH(p, tasks) {
+                if (*p == task) {
+                    mine = true;
                     break;
                 }
             }
+            if (!mine) {
+                deques[i]->push(task);
+                break;
+            }
+            --queued;
+            execute(task, tid);
+        }
 
-            if (!success && !taskQueues[i]->pop(&task)) break;
-            (*task)(i + 1);
+        //the others are running the stolen ones
+        for (auto p = tasks.begin() + 1; p < tasks.end(); ++p) {
+            help(*p, false);
+            (*p)->pending = false;
         }
     }
 
-    void request(Task* task)
+    void request(Task* task, const Array<Task*>* deps = nullptr)
     {
         //Async
         if (threads.count > 0) {
             task->prepare();
-            auto i = idx++;
-            for (uint32_t n = 0; n < threads.count; ++n) {
-                if (taskQueues[(i + n) % threads.count]->tryPush(task)) return;
+            if (!deps || deps->empty()) {
+                push(task);
+                return;
+            }
+            //an extra count prevents the task from running during the registration
+            task->deps.store(deps->count + 1, memory_order_relaxed);
+            ARRAY_FOREACH(p, *deps) {
+                auto edge = tvg::malloc<Task::Edge>(sizeof(Task::Edge));
+                edge->task = task;
+                auto head = (*p)->successors.load(memory_order_acquire);
+                do {
+                    //already completed
+                    if (head == Task::closed()) {
+                        tvg::free(edge);
+                        task->deps.fetch_sub(1, memory_order_relaxed);
+                        break;
+                    }
+                    edge->next = head;
+                } while (!(*p)->successors.compare_exchange_weak(head, edge, memory_order_acq_rel, memory_order_acquire));
             }
-            taskQueues[i % threads.count]->push(task);
+            if (task->deps.fetch_sub(1, memory_order_acq_rel) == 1) push(task);
         //Sync
         } else {
             task->run(0);
@@ -172,7 +395,8 @@ struct TaskSchedulerImpl
 struct TaskSchedulerImpl
 {
     TaskSchedulerImpl(TVG_UNUSED uint32_t threadCnt) {}
-    void request(Task* task) { task->run(0); }
+    void request(Task* task, TVG_UNUSED const Array<Task*>* deps = nullptr) { task->run(0); }
+    void invoke(const Array<Task*>& tasks, unsigned tid) { ARRAY_FOREACH(p, tasks) (*p)->run(tid); }
     uint32_t threadCnt() { return 0; }
 };
 
@@ -209,6 +433,18 @@ void TaskScheduler::request(Task* task)
 }
 
 
+void TaskScheduler::request(Task* task, const Array<Task*>& deps)
+{
+    if (_inst) _inst->request(task, &deps);
+}
+
+
+void TaskScheduler::invoke(const Array<Task*>& tasks, unsigned tid)
+{
+    if (_inst) _inst->invoke(tasks, tid);
+}
+
+
 uint32_t TaskScheduler::threads()
 {
     return _inst ? _inst->threadCnt() : 0;
@@ -228,4 +464,15 @@ ThreadID TaskScheduler::tid()
 #else
     return 0;
 #endif
-}
\ No newline at end of file
+}
+
+
+#ifdef THORVG_THREAD_SUPPORT
+
+void Task::wait()
+{
+    if (_inst) _inst->help(this);
+    else while (!ready.load(memory_order_acquire)) this_thread::yield();
+}
+
+#endif
@@ -24,6 +24,7 @@
 #define _TVG_TASK_SCHEDULER_H_
 
 #include "tvgCommon.h"
+#include "tvgArray.h"
 #include "tvgInlist.h"
 
 #ifdef THORVG_THREAD_SUPPORT
@@ -40,14 +41,28 @@ namespace tvg {
 
 using ThreadID = std::thread::id;
 
-struct Task
+struct Task : Allocated
 {
 private:
-    mutex                   mtx;
-    condition_variable      cv;
-    bool                    ready = true;
+    //a dependency to the successor task
+    struct Edge
+    {
+        Task* task;
+        Edge* next;
+    };
+
+    atomic<bool>            ready{true};
+    atomic<Edge*>           successors{closed()};  //tasks waiting for this
+    atomic<uint32_t>        deps{0};               //unfinished predecessors
     bool                    pending = false;
 
+    //successors of the completed task
+    static Edge* closed()
+    {
+        static Edge edge{};
+        return &edge;
+    }
+
 public:
     INLIST_ITEM(Task);
 
@@ -56,9 +71,7 @@ public:
     void done()
     {
         if (!pending) return;
-
-        unique_lock<mutex> lock(mtx);
-        while (!ready) cv.wait(lock);
+        if (!ready.load(memory_order_acquire)) wait();
         pending = false;
     }
 
@@ -66,18 +79,12 @@ protected:
     virtual void run(unsigned tid) = 0;
 
 private:
-    void operator()(unsigned tid)
-    {
-        run(tid);
-
-        lock_guard<mutex> lock(mtx);
-        ready = true;
-        cv.notify_one();
-    }
+    void wait();
 
     void prepare()
     {
-        ready = false;
+        ready.store(false, memory_order_relaxed);
+        successors.store(nullptr, memory_order_relaxed);
         pending = true;
     }
 
@@ -88,7 +95,7 @@ private:
 
 using ThreadID = uint8_t;
 
-struct Task
+struct Task : Allocated
 {
 public:
     INLIST_ITEM(Task);
@@ -112,8 +119,19 @@ struct TaskScheduler
     static void init(uint32_t threads);
     static void term();
     static void request(Task* task);
+    static void request(Task* task, const Array<Task*>& deps);  //the task runs after the deps are completed
+    static void invoke(const Array<Task*>& tasks, unsigned tid);  //runs the tasks in parallel along with the caller(tid) and joins them
     static bool onthread();  //figure out whether on worker thread or not
     static ThreadID tid();
+
+#ifdef THORVG_THREAD_SUPPORT
+    //the number of the locks held by the current thread. it doesn't run the other tasks while waiting with a lock.
+    static uint32_t& locks()
+    {
+        static thread_local uint32_t cnt = 0;
+        return cnt;
+    }
+#endif
 };
 
 }  //namespace
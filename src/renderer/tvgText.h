@@ -32,11 +32,12 @@
 namespace tvg
 {
 
-struct TextImpl : Text
+struct TextImpl : Text, Allocated
 {
     Paint::Impl impl;
     Shape* shape;   //text shape
     FontLoader* loader = nullptr;
+    RenderGlyphRun run;  //the glyphs of the text shape
     FontMetrics fm;
     char* utf8 = nullptr;
     uint32_t utf8len = 0;
@@ -48,6 +49,7 @@ struct TextImpl : Text
     {
         PAINT(shape)->parent = this;
         shape->strokeJoin(StrokeJoin::Round);
+        to<ShapeImpl>(shape)->rs.glyphs = &run;
     }
 
     ~TextImpl()
@@ -101,6 +103,24 @@ struct TextImpl : Text
         return Result::InvalidArguments;
     }
 
+    //the laid out glyph outlines, the outline width is applied later in the update
+    BBox lbounds()
+    {
+        BBox box;
+        if (!load() || !to<ShapeImpl>(shape)->rs.path.bounds(nullptr, box)) {
+            box.init();
+            return box;
+        }
+        if (outlineWidth > 0.0f) {
+            auto pad = outlineWidth * fm.scale;
+            box.min.x -= pad;
+            box.min.y -= pad;
+            box.max.x += pad;
+            box.max.y += pad;
+        }
+        return box * PAINT(shape)->transform();
+    }
+
     RenderRegion bounds()
     {
         if (!load()) return {};
@@ -118,7 +138,7 @@ struct TextImpl : Text
     {
         if (!loader) return false;
         if (updated) {
-            if (loader->get(fm, utf8, utf8len, to<ShapeImpl>(shape)->rs.path)) {
+            if (loader->get(fm, utf8, utf8len, to<ShapeImpl>(shape)->rs.path, &run)) {
                 loader->transform(shape, fm, italicShear);
             }
             updated = false;
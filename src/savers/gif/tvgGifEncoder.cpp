@@ -41,11 +41,12 @@
 //
 // USAGE:
 // Create a GifWriter struct. Pass it to GifBegin() to initialize and write the header.
-// Pass subsequent frames to GifWriteFrame().
+// Pass subsequent frames to GifQuantize() and GifWriteImage().
 // Finally, call GifEnd() to close the file handle and free memory.
 //
 
 #include "tvgMath.h"
+#include "tvgTaskScheduler.h"
 #include "tvgGifEncoder.h"
 
 
@@ -54,13 +55,15 @@
 #define BIT_DEPTH 8
 #define LEAF_NODE 0xff
 #define MAX_PAL_COLORS ((1 << BIT_DEPTH) - 1)
+#define BAND_MIN_ROWS 32   // the smallest row band of the parallel thresholding
+#define BAND_MAX 16
 
 // Simple structure to write out the LZW-compressed portion of the image
-// one bit at a time
+// the codes are packed from the least significant bit
 typedef struct
 {
-    uint8_t bitIndex;  // how many bits in the partial byte written so far
-    uint8_t byte;      // current partial byte
+    uint32_t bits;      // the pending bits not written to the chunk yet
+    uint32_t bitCount;  // how many bits are pending, less than 8 between the codes
 
     uint32_t chunkIndex;
     uint8_t chunk[256];   // bytes are written in here until we have 256 of them, then written to the file
@@ -93,7 +96,7 @@ typedef struct
 // Takes as in/out parameters the current best color and its error -
 // only changes them if it finds a better color in its subtree.
 // this is the major hotspot in the code at the moment.
-static void _getClosestPaletteColor( GifPalette* pPal, int r, int g, int b, int* bestInd, int* bestDiff, int treeRoot )
+static void _getClosestPaletteColor(const GifPalette* pPal, int r, int g, int b, int* bestInd, int* bestDiff, int treeRoot )
 {
     // base case, reached a leaf or a node that holds a single color
     if (treeRoot > (1 << BIT_DEPTH) - 1 || pPal->treeSplitElt[treeRoot] == LEAF_NODE) {
@@ -343,15 +346,13 @@ static void _buildSearchTree(GifPalette* pal, uint8_t* colors, int count, int fi
 
 // Quantizes the pixels into up to MAX_PAL_COLORS colors by cutting them into boxes in RGB space and averaging each box.
 // A k-d tree is then built over those colors, which is what fills in the palette entries.
-static void _makePalette(GifWriter* writer, const uint8_t* lastFrame, const uint8_t* nextFrame, uint32_t width, uint32_t height, bool transparent)
+static void _makePalette(GifPalette* pal, uint8_t* tmpImage, const uint8_t* lastFrame, const uint8_t* nextFrame, uint32_t width, uint32_t height, bool transparent)
 {
-    auto& pal = writer->pal;
-
     size_t imageSize = (size_t)(width * height * 4 * sizeof(uint8_t));
-    memcpy(writer->tmpImage, nextFrame, imageSize);
+    memcpy(tmpImage, nextFrame, imageSize);
 
     int numPixels = (int)(width * height);
-    numPixels = _pickChangedPixels(lastFrame, writer->tmpImage, numPixels, transparent);
+    numPixels = _pickChangedPixels(lastFrame, tmpImage, numPixels, transparent);
 
     if (numPixels == 0) return;
 
@@ -359,7 +360,7 @@ static void _makePalette(GifWriter* writer, const uint8_t* lastFrame, const uint
     GifBoxes boxes;
     boxes.start[0] = 0;
     boxes.len[0] = numPixels;
-    _computeBoxStats(writer->tmpImage, &boxes, 0);
+    _computeBoxStats(tmpImage, &boxes, 0);
 
     int numBoxes = 1;
 
@@ -378,15 +379,15 @@ static void _makePalette(GifWriter* writer, const uint8_t* lastFrame, const uint
         // If every box holds a single color
         if (target < 0) break;
 
-        _splitBox(writer->tmpImage, &boxes, target, numBoxes);
+        _splitBox(tmpImage, &boxes, target, numBoxes);
         ++numBoxes;
     }
 
-    _buildSearchTree(&pal, boxes.avg, numBoxes, 1, 1 << BIT_DEPTH, 1);
+    _buildSearchTree(pal, boxes.avg, numBoxes, 1, 1 << BIT_DEPTH, 1);
 }
 
 
-void _palettizePixel(const uint8_t* nextFrame, uint8_t* outFrame, GifPalette* pPal)
+static void _palettizePixel(const uint8_t* nextFrame, uint8_t* outFrame, const GifPalette* pPal)
 {
     int32_t bestDiff = 1000000;
     int32_t bestInd = 1;
@@ -400,12 +401,10 @@ void _palettizePixel(const uint8_t* nextFrame, uint8_t* outFrame, GifPalette* pP
 }
 
 
-// Picks palette colors for the image using simple threshholding, no dithering
-static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const uint8_t* nextFrame,  uint32_t width, uint32_t height, bool transparent)
+// Picks palette colors for the pixels using simple threshholding, no dithering.
+// The pixels are independent of each other, the outFrame may be the lastFrame.
+static void _thresholdImage(const GifPalette* pal, const uint8_t* lastFrame, const uint8_t* nextFrame, uint8_t* outFrame, uint32_t numPixels, bool transparent)
 {
-    auto outFrame = writer->oldImage;
-    uint32_t numPixels = width*height;
-
     if (transparent) {
         for (uint32_t ii = 0; ii < numPixels; ++ii) {
             if (nextFrame[3] < TRANSPARENT_THRESHOLD) {
@@ -414,7 +413,7 @@ static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const u
                 outFrame[2] = 0;
                 outFrame[3] = TRANSPARENT_IDX;
             } else {
-                _palettizePixel(nextFrame, outFrame, &writer->pal);
+                _palettizePixel(nextFrame, outFrame, pal);
             }
             if (lastFrame) lastFrame += 4;
             outFrame += 4;
@@ -430,7 +429,7 @@ static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const u
                 outFrame[2] = lastFrame[2];
                 outFrame[3] = TRANSPARENT_IDX;
             } else {
-                _palettizePixel(nextFrame, outFrame, &writer->pal);
+                _palettizePixel(nextFrame, outFrame, pal);
             }
             if (lastFrame) lastFrame += 4;
             outFrame += 4;
@@ -440,22 +439,21 @@ static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const u
 }
 
 
-// insert a single bit
-static void _writeBit(GifBitStatus* stat, uint32_t bit)
+// a row band of the thresholding
+struct GifBandTask : tvg::Task
 {
-    bit = bit & 1;
-    bit = bit << stat->bitIndex;
-    stat->byte |= bit;
-
-    ++stat->bitIndex;
-    if (stat->bitIndex > 7) {
-        // move the newly-finished byte to the chunk buffer
-        stat->chunk[stat->chunkIndex++] = stat->byte;
-        // and start a new byte
-        stat->bitIndex = 0;
-        stat->byte = 0;
+    const GifPalette* pal;
+    const uint8_t* lastFrame;
+    const uint8_t* nextFrame;
+    uint8_t* outFrame;
+    uint32_t numPixels;
+    bool transparent;
+
+    void run(TVG_UNUSED unsigned tid) override
+    {
+        _thresholdImage(pal, lastFrame, nextFrame, outFrame, numPixels, transparent);
     }
-}
+};
 
 
 // write all bytes so far to the file
@@ -464,17 +462,20 @@ static void _writeChunk(FILE* f, GifBitStatus* stat)
     fputc((int)stat->chunkIndex, f);
     fwrite(stat->chunk, 1, stat->chunkIndex, f);
 
-    stat->bitIndex = 0;
-    stat->byte = 0;
     stat->chunkIndex = 0;
 }
 
 
 static void _writeCode(FILE* f, GifBitStatus* stat, uint32_t code, uint32_t length)
 {
-    for (uint32_t ii = 0; ii < length; ++ii) {
-        _writeBit(stat, code);
-        code = code >> 1;
+    stat->bits |= code << stat->bitCount;
+    stat->bitCount += length;
+
+    // move the finished bytes to the chunk buffer
+    while (stat->bitCount >= 8) {
+        stat->chunk[stat->chunkIndex++] = (uint8_t)stat->bits;
+        stat->bits >>= 8;
+        stat->bitCount -= 8;
         if (stat->chunkIndex == 255) _writeChunk(f, stat);
     }
 }
@@ -496,11 +497,8 @@ static void _writePalette(const GifPalette* pPal, FILE* f)
 
 
 // write the image header, LZW-compress and write out the image
-static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
+static void _writeLzwImage(FILE* f, const uint8_t* image, const GifPalette* pal, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
 {
-    auto f = writer->f;
-    auto image = writer->oldImage;
-
     // graphics control extension
     fputc(0x21, f);
     fputc(0xf9, f);
@@ -528,7 +526,7 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
     //fputc(0x80, f); // no local color table, but transparency
 
     fputc(0x80 + BIT_DEPTH - 1, f); // local color table present, 2 ^ bitDepth entries
-    _writePalette(&writer->pal, f);
+    _writePalette(pal, f);
 
     const int minCodeSize = BIT_DEPTH;
     const uint32_t clearCode = 1 << BIT_DEPTH;
@@ -536,15 +534,18 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
     fputc(minCodeSize, f); // min code size 8 bits
 
     GifLzwNode* codetree = tvg::malloc<GifLzwNode>(sizeof(GifLzwNode)*4096);
-
     memset(codetree, 0, sizeof(GifLzwNode)*4096);
+
+    // the entries in the dictionary, cleared one by one rather than the whole tree
+    uint16_t* entries[4096];
+    uint32_t entryCnt = 0;
     int32_t curCode = -1;
     uint32_t codeSize = (uint32_t)minCodeSize + 1;
     uint32_t maxCode = clearCode+1;
 
     GifBitStatus stat;
-    stat.byte = 0;
-    stat.bitIndex = 0;
+    stat.bits = 0;
+    stat.bitCount = 0;
     stat.chunkIndex = 0;
 
     _writeCode(f, &stat, clearCode, codeSize);  // start with a fresh LZW dictionary
@@ -570,6 +571,7 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
 
                 // insert the new run into the dictionary
                 codetree[curCode].m_next[nextValue] = (uint16_t)++maxCode;
+                entries[entryCnt++] = &codetree[curCode].m_next[nextValue];
 
                 if (maxCode >= (1ul << codeSize)) {
                     // dictionary entry count has broken a size barrier,
@@ -580,7 +582,7 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
                     // the dictionary is full, clear it out and begin anew
                     _writeCode(f, &stat, clearCode, codeSize); // clear tree
 
-                    memset(codetree, 0, sizeof(GifLzwNode)*4096);
+                    while (entryCnt > 0) *entries[--entryCnt] = 0;
                     codeSize = (uint32_t)(minCodeSize + 1);
                     maxCode = clearCode+1;
                 }
@@ -596,7 +598,7 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
     _writeCode(f, &stat, clearCode + 1, (uint32_t)minCodeSize + 1);
 
     // write out the last partial chunk
-    while (stat.bitIndex) _writeBit(&stat, 0);
+    if (stat.bitCount) stat.chunk[stat.chunkIndex++] = (uint8_t)stat.bits;
     if (stat.chunkIndex) _writeChunk(f, &stat);
 
     fputc(0, f); // image block terminator
@@ -620,10 +622,7 @@ bool gifBegin(GifWriter* writer, const char* filename, uint32_t width, uint32_t
 #endif
     if (!writer->f) return false;
 
-    writer->firstFrame = true;
-
     // allocate
-    writer->oldImage = tvg::malloc<uint8_t>(width*height*4);
     writer->tmpImage = tvg::malloc<uint8_t>(width*height*4);
 
     fputs("GIF89a", writer->f);
@@ -663,22 +662,45 @@ bool gifBegin(GifWriter* writer, const char* filename, uint32_t width, uint32_t
         fputc(0, writer->f); // block terminator
     }
 
-    memset(&writer->pal, 0, sizeof(GifPalette));
-
     return true;
 }
 
 
-bool gifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
+void gifQuantize(GifPalette* pal, uint8_t* tmpImage, const uint8_t* lastFrame, const uint8_t* image, uint8_t* outImage, uint32_t width, uint32_t height, bool transparent, unsigned tid)
 {
-    if (!writer->f) return false;
+    _makePalette(pal, tmpImage, lastFrame, image, width, height, transparent);
 
-    const uint8_t* oldImage = writer->firstFrame? NULL : writer->oldImage;
-    writer->firstFrame = false;
+    // the palette is fixed, threshold the row bands in parallel
+    auto cnt = std::min(std::min(tvg::TaskScheduler::threads() + 1, height / BAND_MIN_ROWS), uint32_t(BAND_MAX));
+    if (cnt < 2) {
+        _thresholdImage(pal, lastFrame, image, outImage, width * height, transparent);
+        return;
+    }
+
+    GifBandTask bands[BAND_MAX];
+    tvg::Array<tvg::Task*> tasks(cnt);
+
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto begin = (height * i / cnt) * width * 4;
+        auto end = (height * (i + 1) / cnt) * width * 4;
+        auto& band = bands[i];
+        band.pal = pal;
+        band.lastFrame = lastFrame ? lastFrame + begin : NULL;
+        band.nextFrame = image + begin;
+        band.outFrame = outImage + begin;
+        band.numPixels = (end - begin) / 4;
+        band.transparent = transparent;
+        tasks.push(&band);
+    }
+    tvg::TaskScheduler::invoke(tasks, tid);
+}
+
+
+bool gifWriteImage(GifWriter* writer, const uint8_t* image, const GifPalette* pal, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
+{
+    if (!writer->f) return false;
 
-    _makePalette(writer, oldImage, image, width, height, transparent);
-    _thresholdImage(writer, oldImage, image, width, height, transparent);
-    _writeLzwImage(writer, width, height, delay, transparent);
+    _writeLzwImage(writer->f, image, pal, width, height, delay, transparent);
 
     return true;
 }
@@ -690,11 +712,10 @@ bool gifEnd(GifWriter* writer)
 
     fputc(0x3b, writer->f); // end of file
     fclose(writer->f);
-    tvg::free(writer->oldImage);
     tvg::free(writer->tmpImage);
 
     writer->f = NULL;
-    writer->oldImage = NULL;
+    writer->tmpImage = NULL;
 
     return true;
 }
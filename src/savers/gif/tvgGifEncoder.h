@@ -40,10 +40,7 @@ struct GifPalette
 struct GifWriter
 {
     FILE* f;
-    uint8_t* oldImage;
-    uint8_t* tmpImage;
-    GifPalette pal;
-    bool firstFrame;
+    uint8_t* tmpImage;  // the scratch of the quantization
 };
 
 // Creates a gif file.
@@ -51,11 +48,15 @@ struct GifWriter
 // The delay value is the time between frames in hundredths of a second - note that not all viewers pay much attention to this value.
 bool gifBegin(GifWriter* writer, const char* filename, uint32_t width, uint32_t height, uint32_t delay);
 
-// Writes out a new frame to a GIF in progress.
-// The GIFWriter should have been created by GIFBegin.
-// AFAIK, it is legal to use different bit depths for different frames of an image -
-// this may be handy to save bits in animations that don't change much.
-bool gifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width, uint32_t height, uint32_t delay, bool transparent);
+// Quantizes a frame into the palette colors, the palette indices are stored in the alpha channel of the outImage.
+// lastFrame is the quantized previous frame, or NULL for the first one. Only the changed pixels are taken into
+// the palette, which is kept as is if nothing has changed. The tmpImage is a scratch of the frame size and
+// the outImage may be the lastFrame. The thresholding runs in parallel on the task scheduler along with the caller(tid).
+void gifQuantize(GifPalette* pal, uint8_t* tmpImage, const uint8_t* lastFrame, const uint8_t* image, uint8_t* outImage, uint32_t width, uint32_t height, bool transparent, unsigned tid);
+
+// LZW-compresses and writes out a frame quantized by gifQuantize().
+// The frames must be written in order.
+bool gifWriteImage(GifWriter* writer, const uint8_t* image, const GifPalette* pal, uint32_t width, uint32_t height, uint32_t delay, bool transparent);
 
 // Writes the EOF code, closes the file handle, and frees temp memory used by a GIF.
 // Many if not most viewers will still display a GIF properly if the EOF code is missing,
@@ -31,6 +31,54 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+#define GIF_PIPELINE_DEPTH 3   //the frames in flight
+
+//a frame in flight. The frames are rendered ahead, quantized one after another since a frame is encoded
+//by its difference from the previous one, and written in order while the next ones are being quantized.
+struct GifFrame
+{
+    struct Quantizer : Task
+    {
+        GifFrame* frame;
+        void run(unsigned tid) override { frame->quantize(tid); }
+    } quantizer;
+
+    struct Writer : Task
+    {
+        GifFrame* frame;
+        void run(TVG_UNUSED unsigned tid) override { frame->write(); }
+    } writer;
+
+    GifWriter* gif;
+    const GifFrame* prev = nullptr;   //the previous frame, null for the first one
+    uint8_t* image = nullptr;         //the rendered pixels
+    uint8_t* out = nullptr;           //the quantized pixels
+    GifPalette pal;
+    uint32_t w, h, delay;
+    bool transparent;
+    bool failed = false;
+
+    GifFrame()
+    {
+        quantizer.frame = this;
+        writer.frame = this;
+    }
+
+    void quantize(unsigned tid)
+    {
+        //the palette is kept if nothing has changed
+        if (!prev) memset(&pal, 0, sizeof(GifPalette));
+        else if (prev != this) memcpy(&pal, &prev->pal, sizeof(GifPalette));
+        gifQuantize(&pal, gif->tmpImage, prev ? prev->out : nullptr, image, out, w, h, transparent, tid);
+    }
+
+    void write()
+    {
+        if (!gifWriteImage(gif, out, &pal, w, h, delay, transparent)) failed = true;
+    }
+};
+
+
 void GifSaver::run(unsigned tid)
 {
     auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
@@ -59,7 +107,26 @@ void GifSaver::run(unsigned tid)
         return;
     }
 
+    //the tasks run in place without the threads, one frame is enough and it's encoded right from the canvas
+    auto depth = TaskScheduler::threads() > 0 ? GIF_PIPELINE_DEPTH : 1;
+    auto target = reinterpret_cast<uint8_t*>(buffer);
+    GifFrame frames[GIF_PIPELINE_DEPTH];
+
+    for (auto i = 0; i < depth; ++i) {
+        auto& frame = frames[i];
+        frame.gif = &writer;
+        frame.image = (depth > 1) ? tvg::malloc<uint8_t>(w * h * 4) : target;
+        frame.out = tvg::malloc<uint8_t>(w * h * 4);
+        frame.w = w;
+        frame.h = h;
+        frame.delay = uint32_t(delay * 100.0f);
+        frame.transparent = transparent;
+    }
+
     auto duration = animation->duration();
+    GifFrame* prev = nullptr;
+    uint32_t idx = 0;
+    Array<Task*> deps(2);
 
     for (auto p = 0.0f; p < duration; p += delay) {
         auto frameNo = animation->totalFrame() * (p / duration);
@@ -68,12 +135,37 @@ void GifSaver::run(unsigned tid)
         if (canvas->draw(true) == tvg::Result::Success) {
             canvas->sync();
         }
-        if (!gifWriteFrame(&writer, reinterpret_cast<uint8_t*>(buffer), w, h, uint32_t(delay * 100.0f), transparent)) {
-            TVGERR("GIF_SAVER", "Failed gif encoding");
-            break;
-        }
+
+        //reuse the slot once its frame is written
+        auto& frame = frames[idx++ % depth];
+        frame.writer.done();
+        frame.quantizer.done();
+        if (frame.failed) break;
+        if (frame.image != target) memcpy(frame.image, target, w * h * 4);
+        frame.prev = prev;
+
+        deps.clear();
+        if (prev) deps.push(&prev->quantizer);
+        TaskScheduler::request(&frame.quantizer, deps);
+
+        deps.clear();
+        deps.push(&frame.quantizer);
+        if (prev) deps.push(&prev->writer);
+        TaskScheduler::request(&frame.writer, deps);
+
+        prev = &frame;
+    }
+
+    auto failed = false;
+    for (auto i = 0; i < depth; ++i) {
+        frames[i].writer.done();
+        frames[i].quantizer.done();
+        failed |= frames[i].failed;
+        if (frames[i].image != target) tvg::free(frames[i].image);
+        tvg::free(frames[i].out);
     }
 
+    if (failed) TVGERR("GIF_SAVER", "Failed gif encoding");
     if (!gifEnd(&writer)) TVGERR("GIF_SAVER", "Failed gif encoding");
 
     if (bg) {
@@ -488,6 +488,66 @@ TEST_CASE("GL Solid Batch", "[tvgGlEngine]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("GL Shared Tessellation", "[tvgGlEngine]")
+{
+    TestGLEngine engine;
+
+    REQUIRE(Initializer::init(2) == Result::Success);
+    {
+        auto canvas = std::unique_ptr<GlCanvas>(GlCanvas::gen());
+        REQUIRE(canvas);
+        engine.target(canvas.get());
+
+        //the instances of a path share the tessellation in the same transform class
+        Shape* shapes[4];
+        for (uint32_t i = 0; i < 4; ++i) {
+            shapes[i] = Shape::gen();
+            shapes[i]->appendRect(0, 0, 20, 10);
+            shapes[i]->fill(255, 0, 0);
+            shapes[i]->strokeFill(0, 0, 255);
+            shapes[i]->strokeWidth(2);
+            shapes[i]->translate(i * 25.0f, i * 20.0f);
+            canvas->add(shapes[i]);
+        }
+        REQUIRE(canvas->update() == Result::Success);
+
+        for (uint32_t i = 0; i < 4; ++i) {
+            REQUIRE(shapes[i]->intersects(i * 25 + 5, i * 20 + 3, 2, 2));
+            REQUIRE(!shapes[i]->intersects(i * 25 + 5, i * 20 + 14, 2, 2));
+        }
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        uint32_t hits, misses;
+        REQUIRE(canvas->tessellation(&hits, &misses) == Result::Success);
+        REQUIRE(hits == 3);
+        REQUIRE(misses == 1);
+
+        //color and transform changes of the same class
+        shapes[0]->fill(0, 255, 0);
+        shapes[1]->strokeFill(255, 255, 0);
+        shapes[2]->translate(10, 70);
+        shapes[3]->rotate(90);
+        REQUIRE(canvas->update() == Result::Success);
+
+        REQUIRE(shapes[0]->intersects(5, 3, 2, 2));
+        REQUIRE(shapes[1]->intersects(30, 23, 2, 2));
+        REQUIRE(shapes[2]->intersects(15, 73, 2, 2));
+        REQUIRE(!shapes[2]->intersects(55, 43, 2, 2));
+        REQUIRE(shapes[3]->intersects(68, 70, 2, 2));
+        REQUIRE(!shapes[3]->intersects(85, 63, 2, 2));
+
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //the translated one is reused, the rotated one is in a new transform class
+        REQUIRE(canvas->tessellation(&hits, &misses) == Result::Success);
+        REQUIRE(hits == 1);
+        REQUIRE(misses == 1);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 TEST_CASE("GL Intersection", "[tvgGlEngine]")
 {
     TestGLEngine engine;
@@ -24,8 +24,10 @@
 #include "config.h"
 #include "catch.hpp"
 #include <cstring>
+#include <memory>
 
 using namespace tvg;
+using namespace std;
 
 
 TEST_CASE("Basic initialization", "[tvgInitializer]")
@@ -58,4 +60,106 @@ TEST_CASE("Version", "[tvgInitializer]")
 TEST_CASE("Negative termination", "[tvgInitializer]")
 {
     REQUIRE(Initializer::term() == Result::InsufficientCondition);
-}
\ No newline at end of file
+}
+
+static size_t allocs[4];
+static size_t frees;
+static size_t lives;  //the blocks not freed yet
+
+static void* _malloc(size_t size, AllocTag tag, void* data)
+{
+    ++allocs[(int)tag];
+    ++lives;
+    return malloc(size);
+}
+
+static void* _calloc(size_t nmem, size_t size, AllocTag tag, void* data)
+{
+    ++allocs[(int)tag];
+    ++lives;
+    return calloc(nmem, size);
+}
+
+static void* _realloc(void* ptr, size_t size, AllocTag tag, void* data)
+{
+    ++allocs[(int)tag];
+    if (!ptr) ++lives;
+    return realloc(ptr, size);
+}
+
+static void _free(void* ptr, void* data)
+{
+    if (ptr) {
+        ++frees;
+        --lives;
+    }
+    free(ptr);
+}
+
+TEST_CASE("Custom allocator", "[tvgInitializer]")
+{
+    Allocator allocator = {_malloc, _calloc, _realloc, _free, nullptr};
+
+    Allocator invalid = allocator;
+    invalid.free = nullptr;
+    REQUIRE(Initializer::init(0, invalid) == Result::InvalidArguments);
+
+    REQUIRE(Initializer::init(0, allocator) == Result::Success);
+    REQUIRE(Initializer::init(0, allocator) == Result::InsufficientCondition);
+
+    //the engine objects are allocated by the allocator as well
+    auto cnt = allocs[(int)AllocTag::Default];
+    auto released = frees;
+    Paint::rel(Shape::gen());
+    REQUIRE(allocs[(int)AllocTag::Default] > cnt);
+    REQUIRE(frees > released);
+
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto shape = Shape::gen();
+        REQUIRE(shape->appendCircle(50, 50, 40, 40) == Result::Success);
+        REQUIRE(shape->fill(255, 0, 0, 255) == Result::Success);
+        REQUIRE(canvas->add(shape) == Result::Success);
+
+    #ifdef THORVG_SVG_LOADER_SUPPORT
+        auto picture = Picture::gen();
+        REQUIRE(picture->load(TEST_DIR"/test2.svg") == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+    #endif
+
+    #ifdef THORVG_LOTTIE_LOADER_SUPPORT
+        //the modifiers work on the scratch paths of the thread
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        REQUIRE(animation->picture()->load(TEST_DIR"/test6.lot") == Result::Success);
+        REQUIRE(canvas->add(animation->picture()) == Result::Success);
+        REQUIRE(animation->frame(animation->totalFrame() * 0.5f) == Result::Success);
+    #endif
+
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+    }
+
+    REQUIRE(Initializer::term() == Result::Success);
+
+    REQUIRE(allocs[(int)AllocTag::Default] > 0);
+    REQUIRE(allocs[(int)AllocTag::Renderer] > 0);
+#ifdef THORVG_SVG_LOADER_SUPPORT
+    REQUIRE(allocs[(int)AllocTag::Loader] > 0);
+#endif
+    REQUIRE(frees > 0);
+
+    //nothing of the allocator is left behind
+    REQUIRE(lives == 0);
+
+    //the last termination restores the system heap
+    cnt = allocs[(int)AllocTag::Default];
+    REQUIRE(Initializer::init(0) == Result::Success);
+    Paint::rel(Shape::gen());
+    REQUIRE(Initializer::term() == Result::Success);
+    REQUIRE(allocs[(int)AllocTag::Default] == cnt);
+}
@@ -454,4 +454,283 @@ TEST_CASE("Lottie Embedded Fonts Share", "[tvgLottie]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Lottie Shared Composition", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(2) == Result::Success);
+    {
+        const uint32_t size = 100;
+        const char* slotJson = R"({"gradient_fill":{"p":{"p":2,"k":{"a":0,"k":[0,0.1,0.1,0.2,1,1,0.1,0.2,0.1,1]}}}})";
+
+        struct Instance {
+            unique_ptr<LottieAnimation> animation;
+            unique_ptr<SwCanvas> canvas;
+            uint32_t buffer[size * size];
+        } instances[3];
+
+        for (auto& instance : instances) {
+            instance.animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+            instance.canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            auto picture = instance.animation->picture();
+            REQUIRE(picture->load(TEST_DIR"/slot.lot") == Result::Success);
+            REQUIRE(picture->size(size, size) == Result::Success);
+            REQUIRE(instance.canvas->target(instance.buffer, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(instance.canvas->add(picture) == Result::Success);
+        }
+
+        auto draw = [&](Instance& instance, float frameNo) {
+            instance.animation->frame(frameNo);
+            REQUIRE(instance.canvas->update() == Result::Success);
+            REQUIRE(instance.canvas->draw(true) == Result::Success);
+            REQUIRE(instance.canvas->sync() == Result::Success);
+        };
+
+        //The shared model is updated by the instances at once.
+        for (int i = 0; i < 3; ++i) REQUIRE(instances[i].animation->frame(15.0f) == Result::Success);
+        for (int i = 0; i < 3; ++i) REQUIRE(instances[i].canvas->update() == Result::Success);
+        for (int i = 0; i < 3; ++i) REQUIRE(instances[i].canvas->draw(true) == Result::Success);
+        for (int i = 0; i < 3; ++i) REQUIRE(instances[i].canvas->sync() == Result::Success);
+        REQUIRE(memcmp(instances[0].buffer, instances[1].buffer, sizeof(instances[0].buffer)) == 0);
+        REQUIRE(memcmp(instances[0].buffer, instances[2].buffer, sizeof(instances[0].buffer)) == 0);
+
+        //The instances of the same content must result in the same frame.
+        draw(instances[0], 10.0f);
+        draw(instances[1], 0.0f);
+        draw(instances[2], 5.0f);
+        draw(instances[1], 10.0f);
+        REQUIRE(memcmp(instances[0].buffer, instances[1].buffer, sizeof(instances[0].buffer)) == 0);
+
+        //The slot overriding must not affect the other instances.
+        auto id = instances[2].animation->gen(slotJson);
+        REQUIRE(id > 0);
+        REQUIRE(instances[2].animation->apply(id) == Result::Success);
+        draw(instances[2], 10.0f);
+        draw(instances[0], 11.0f);
+        draw(instances[0], 10.0f);
+        REQUIRE(memcmp(instances[0].buffer, instances[1].buffer, sizeof(instances[0].buffer)) == 0);
+
+        REQUIRE(memcmp(instances[0].buffer, instances[2].buffer, sizeof(instances[0].buffer)) != 0);
+
+        //The released instance must not affect the others.
+        uint32_t expected[size * size];
+        memcpy(expected, instances[0].buffer, sizeof(expected));
+        instances[0].canvas.reset();
+        instances[0].animation.reset();
+        draw(instances[1], 20.0f);
+        draw(instances[1], 10.0f);
+        REQUIRE(memcmp(expected, instances[1].buffer, sizeof(expected)) == 0);
+
+        //The last instance takes over the shared model.
+        id = instances[1].animation->gen(slotJson);
+        REQUIRE(id > 0);
+        REQUIRE(instances[1].animation->apply(id) == Result::Success);
+        draw(instances[1], 10.0f);
+        REQUIRE(memcmp(instances[1].buffer, instances[2].buffer, sizeof(expected)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Retained Layers", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init(2) == Result::Success);
+    {
+        const uint32_t size = 100;
+        uint32_t played[size * size];
+        uint32_t expected[size * size];
+
+        //The static layers are kept and the dynamic ones are updated in place over the frames,
+        //they must result in the same as the fresh ones.
+        const char* files[] = {TEST_DIR"/test.lot", TEST_DIR"/test2.lot", TEST_DIR"/test10.lot", TEST_DIR"/test13.lot"};
+
+        for (auto file : files) {
+            auto animation = unique_ptr<Animation>(Animation::gen());
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            auto picture = animation->picture();
+            REQUIRE(picture->load(file) == Result::Success);
+            REQUIRE(picture->size(size, size) == Result::Success);
+            REQUIRE(canvas->target(played, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas->add(picture) == Result::Success);
+
+            auto total = animation->totalFrame();
+            for (auto frameNo = 0.0f; frameNo < total; frameNo += 3.0f) {
+                animation->frame(frameNo);
+                REQUIRE(canvas->update() == Result::Success);
+                REQUIRE(canvas->draw(true) == Result::Success);
+                REQUIRE(canvas->sync() == Result::Success);
+
+                if (int(frameNo) % 15 != 0) continue;
+
+                auto animation2 = unique_ptr<Animation>(Animation::gen());
+                auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+                auto picture2 = animation2->picture();
+                REQUIRE(picture2->load(file) == Result::Success);
+                REQUIRE(picture2->size(size, size) == Result::Success);
+                REQUIRE(canvas2->target(expected, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+                REQUIRE(canvas2->add(picture2) == Result::Success);
+                animation2->frame(frameNo);
+                REQUIRE(canvas2->draw(true) == Result::Success);
+                REQUIRE(canvas2->sync() == Result::Success);
+
+                REQUIRE(memcmp(played, expected, sizeof(played)) == 0);
+            }
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Keyframe Seeking", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        const uint32_t size = 100;
+        uint32_t played[size * size];
+        uint32_t expected[size * size];
+
+        auto animation = unique_ptr<LottieAnimation>(LottieAnimation::gen());
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/test.lot") == Result::Success);
+        REQUIRE(picture->size(size, size) == Result::Success);
+        REQUIRE(canvas->target(played, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+
+        auto render = [&](float frameNo, uint32_t* buffer) {
+            auto animation2 = unique_ptr<Animation>(Animation::gen());
+            auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+            auto picture2 = animation2->picture();
+            REQUIRE(picture2->load(TEST_DIR"/test.lot") == Result::Success);
+            REQUIRE(picture2->size(size, size) == Result::Success);
+            REQUIRE(canvas2->target(buffer, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas2->add(picture2) == Result::Success);
+            animation2->frame(frameNo);
+            REQUIRE(canvas2->draw(true) == Result::Success);
+            REQUIRE(canvas2->sync() == Result::Success);
+        };
+
+        auto play = [&](float frameNo) {
+            animation->frame(frameNo);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        //The keyframe lookups continue from the last segments, any seeking order must result in the same.
+        auto total = animation->totalFrame();
+        float frames[] = {1.5f, 2.5f, 3.5f, total * 0.75f, total * 0.75f - 1.0f, total * 0.25f, total - 1.0f, 0.0f};
+        for (auto frameNo : frames) {
+            play(frameNo);
+            render(frameNo, expected);
+            REQUIRE(memcmp(played, expected, sizeof(played)) == 0);
+        }
+
+        //The dense easings are applied below the default quality only, they must stay close to the exact curves.
+        auto distance = [&]() {
+            uint8_t max = 0;
+            auto p = reinterpret_cast<uint8_t*>(played);
+            auto e = reinterpret_cast<uint8_t*>(expected);
+            for (uint32_t i = 0; i < sizeof(played); ++i) {
+                auto d = (p[i] > e[i]) ? (p[i] - e[i]) : (e[i] - p[i]);
+                if (d > max) max = d;
+            }
+            return max;
+        };
+
+        REQUIRE(animation->quality(0) == Result::Success);
+        for (auto frameNo = 0.0f; frameNo < total; frameNo += 7.5f) {
+            play(frameNo);
+            render(frameNo, expected);
+            REQUIRE(distance() <= 8);
+        }
+
+        REQUIRE(animation->quality(50) == Result::Success);
+        play(total * 0.5f + 0.5f);
+        render(total * 0.5f + 0.5f, expected);
+        REQUIRE(memcmp(played, expected, sizeof(played)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Lottie Parallel Update", "[tvgLottie]")
+{
+    const uint32_t size = 100;
+    const uint32_t frames = 8;
+    static uint32_t expected[frames][size * size];
+    uint32_t played[size * size];
+
+    auto play = [&](uint32_t* buffer, uint32_t frame) {
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/test7.lot") == Result::Success);
+        REQUIRE(picture->size(size, size) == Result::Success);
+        REQUIRE(canvas->target(buffer, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+        animation->frame(animation->totalFrame() * frame / frames);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+    };
+
+    //sequential
+    REQUIRE(Initializer::init(0) == Result::Success);
+    for (uint32_t i = 0; i < frames; ++i) play(expected[i], i);
+    REQUIRE(Initializer::term() == Result::Success);
+
+    //the sibling layers are updated on the worker threads, they must result in the same.
+    REQUIRE(Initializer::init(3) == Result::Success);
+    for (uint32_t i = 0; i < frames; ++i) {
+        play(played, i);
+        REQUIRE(memcmp(played, expected[i], sizeof(played)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+
+TEST_CASE("Lottie Expressions", "[tvgLottie]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        //time dependent, constant, property referring and broken expressions
+        const char* data = R"({"v":"5.7.4","fr":30,"ip":0,"op":60,"w":100,"h":100,"layers":[)"
+            R"({"ty":4,"ind":1,"ip":0,"op":60,"st":0,"ks":{"o":{"a":0,"k":100},"a":{"a":0,"k":[0,0]},)"
+            R"("p":{"a":0,"k":[50,50],"x":"var $bm_rt = add(value, [Math.sin(time * 6) * 20, 0]);"},)"
+            R"("r":{"a":0,"k":0,"x":"var $bm_rt = time * 90;"},"s":{"a":0,"k":[100,100],"x":"var a = 60, b = [a, a + 20];\n$bm_rt = b;"}},)"
+            R"("shapes":[{"ty":"rc","d":1,"s":{"a":0,"k":[40,40]},"p":{"a":0,"k":[0,0]},"r":{"a":0,"k":0}},)"
+            R"({"ty":"fl","c":{"a":0,"k":[1,0,0,1]},"o":{"a":0,"k":100,"x":"var $bm_rt = thisLayer.transform.rotation > 60 ? 50 : 100;"},"r":1},)"
+            R"({"ty":"st","c":{"a":0,"k":[0,0,1,1]},"o":{"a":0,"k":100},"w":{"a":0,"k":2,"x":"var $bm_rt = ((;"}}]}]})";
+
+        const uint32_t size = 100;
+        uint32_t buffer[size * size];
+        uint32_t first[size * size];
+        uint32_t second[size * size];
+
+        auto animation = unique_ptr<Animation>(Animation::gen());
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        auto picture = animation->picture();
+        REQUIRE(picture->load(data, strlen(data), "lottie", nullptr, true) == Result::Success);
+        REQUIRE(canvas->target(buffer, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+
+        auto play = [&](float frameNo, uint32_t* out) {
+            animation->frame(frameNo);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+            memcpy(out, buffer, sizeof(buffer));
+        };
+
+        //The compiled codes and their results are reused, the revisited frames must result in the same.
+        play(10.0f, first);
+        play(40.0f, second);
+        REQUIRE(memcmp(first, second, sizeof(first)) != 0);
+
+        play(10.0f, second);
+        REQUIRE(memcmp(first, second, sizeof(first)) == 0);
+
+        play(5.5f, second);
+        play(59.0f, second);
+        play(10.0f, second);
+        REQUIRE(memcmp(first, second, sizeof(first)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #endif
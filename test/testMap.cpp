@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "config.h"
+#include "catch.hpp"
+#include "src/common/tvgMap.h"
+
+using namespace tvg;
+
+#ifndef TVG_STATIC
+//the engine allocator is hidden in the shared library, the map runs on the system heap here
+namespace tvg { Allocator allocator = {}; }
+#endif
+
+TEST_CASE("Map Insertion", "[tvgMap]")
+{
+    Map<uint32_t, uint32_t> map;
+
+    //no memory until the first insertion
+    REQUIRE(map.capacity == 0);
+    REQUIRE(map.find(1u) == nullptr);
+    REQUIRE(!map.remove(1u));
+    map.clear();
+
+    for (uint32_t i = 0; i < 1000; ++i) map[i * 7] = i;
+    REQUIRE(map.count == 1000);
+    REQUIRE(map.capacity * 3 >= map.count * 4);
+
+    for (uint32_t i = 0; i < 1000; ++i) {
+        auto val = map.find(i * 7);
+        REQUIRE(val);
+        REQUIRE(*val == i);
+    }
+    REQUIRE(map.find(1u) == nullptr);
+    REQUIRE(map.find(7001u) == nullptr);
+
+    //an existing key is not inserted again
+    map[7] = 100;
+    REQUIRE(map.count == 1000);
+    REQUIRE(*map.find(7u) == 100);
+
+    uint32_t visited = 0;
+    map.foreach([&](const uint32_t& key, uint32_t& val) {
+        if (key != 7) REQUIRE(key == val * 7);
+        ++visited;
+    });
+    REQUIRE(visited == 1000);
+}
+
+TEST_CASE("Map Removal", "[tvgMap]")
+{
+    Map<uint64_t, uint64_t> map(16);
+    REQUIRE(map.capacity > 0);
+
+    //a dense table makes long probing clusters, the removals shift them back
+    for (uint64_t i = 0; i < 3000; ++i) map[i] = i + 1;
+    for (uint64_t i = 0; i < 3000; i += 2) REQUIRE(map.remove(i));
+    REQUIRE(!map.remove(0u));
+    REQUIRE(map.count == 1500);
+
+    for (uint64_t i = 0; i < 3000; ++i) {
+        auto val = map.find(i);
+        if (i % 2) {
+            REQUIRE(val);
+            REQUIRE(*val == i + 1);
+        } else REQUIRE(val == nullptr);
+    }
+
+    //the released items are reused
+    auto capacity = map.capacity;
+    for (uint64_t i = 0; i < 3000; i += 2) map[i] = i + 1;
+    REQUIRE(map.count == 3000);
+    REQUIRE(map.capacity == capacity);
+    for (uint64_t i = 0; i < 3000; ++i) REQUIRE(*map.find(i) == i + 1);
+
+    //all gone
+    for (uint64_t i = 0; i < 3000; ++i) REQUIRE(map.remove(i));
+    REQUIRE(map.count == 0);
+    for (uint64_t i = 0; i < 3000; ++i) REQUIRE(map.find(i) == nullptr);
+}
+
+TEST_CASE("Map Rehash", "[tvgMap]")
+{
+    Map<uint32_t, uint32_t> map;
+
+    auto first = &map[1];
+    *first = 10;
+    auto capacity = map.capacity;
+
+    //the values keep their addresses over the rehashes
+    uint32_t* vals[500];
+    for (uint32_t i = 0; i < 500; ++i) {
+        vals[i] = &map[i + 100];
+        *vals[i] = i;
+    }
+    REQUIRE(map.capacity > capacity);
+
+    REQUIRE(map.find(1u) == first);
+    REQUIRE(*first == 10);
+    for (uint32_t i = 0; i < 500; ++i) {
+        REQUIRE(map.find(i + 100) == vals[i]);
+        REQUIRE(*vals[i] == i);
+    }
+}
+
+TEST_CASE("Map Clear", "[tvgMap]")
+{
+    struct Counter
+    {
+        int* alive = nullptr;
+        ~Counter() { if (alive) --(*alive); }
+    };
+
+    int alive = 0;
+    Map<uint32_t, Counter> map;
+    for (uint32_t i = 0; i < 100; ++i) {
+        map[i].alive = &alive;
+        ++alive;
+    }
+    map.remove(50u);
+    REQUIRE(alive == 99);
+
+    //the memory is kept for the reuse
+    auto capacity = map.capacity;
+    map.clear();
+    REQUIRE(alive == 0);
+    REQUIRE(map.count == 0);
+    REQUIRE(map.capacity == capacity);
+    for (uint32_t i = 0; i < 100; ++i) REQUIRE(map.find(i) == nullptr);
+
+    for (uint32_t i = 200; i < 300; ++i) {
+        REQUIRE(map[i].alive == nullptr);
+        map[i].alive = &alive;
+        ++alive;
+    }
+    REQUIRE(map.count == 100);
+    REQUIRE(map.capacity == capacity);
+    for (uint32_t i = 200; i < 300; ++i) REQUIRE(map.find(i)->alive == &alive);
+}
+
+TEST_CASE("Map Pointer Keys", "[tvgMap]")
+{
+    int objs[256];
+    Map<const int*, int> map;
+
+    for (int i = 0; i < 256; ++i) map[&objs[i]] = i;
+    REQUIRE(map.count == 256);
+
+    for (int i = 0; i < 256; ++i) {
+        auto val = map.find(&objs[i]);
+        REQUIRE(val);
+        REQUIRE(*val == i);
+    }
+
+    int other;
+    REQUIRE(map.find(&other) == nullptr);
+
+    for (int i = 0; i < 256; i += 3) REQUIRE(map.remove(&objs[i]));
+    for (int i = 0; i < 256; ++i) REQUIRE((map.find(&objs[i]) == nullptr) == (i % 3 == 0));
+}
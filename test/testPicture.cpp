@@ -476,3 +476,82 @@ TEST_CASE("Filter Method", "[tvgPicture]")
 }
 
 #endif
+
+//decodes the image file from the path and from the memory, both must give the same pixels
+static void _compare(const char* path, const char* mimeType)
+{
+    ifstream file(path, ios::in | ios::binary);
+    REQUIRE(file.is_open());
+    file.seekg(0, ios::end);
+    auto size = (uint32_t)file.tellg();
+    auto data = (char*)malloc(size);
+    file.seekg(0, ios::beg);
+    file.read(data, size);
+    file.close();
+
+    uint32_t buffer[2][100*100] = {};
+
+    for (int i = 0; i < 2; ++i) {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer[i], 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto picture = Picture::gen();
+        if (i == 0) REQUIRE(picture->load(path) == Result::Success);
+        else REQUIRE(picture->load(data, size, mimeType, "", true) == Result::Success);
+
+        float w, h;
+        REQUIRE(picture->size(&w, &h) == Result::Success);
+        REQUIRE(w == 512);
+        REQUIRE(h == 512);
+
+        REQUIRE(picture->size(100, 100) == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+    }
+    free(data);
+
+    auto drawn = 0;
+    for (auto pixel : buffer[0]) if (pixel) ++drawn;
+    REQUIRE(drawn > 0);
+    REQUIRE(memcmp(buffer[0], buffer[1], sizeof(buffer[0])) == 0);
+}
+
+TEST_CASE("Load image files and data identically", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+#ifdef THORVG_PNG_LOADER_SUPPORT
+        _compare(TEST_DIR"/test.png", "png");
+#endif
+#ifdef THORVG_JPG_LOADER_SUPPORT
+        _compare(TEST_DIR"/test.jpg", "jpg");
+#endif
+#ifdef THORVG_WEBP_LOADER_SUPPORT
+        _compare(TEST_DIR"/test.webp", "webp");
+#endif
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Load empty image files", "[tvgPicture]")
+{
+    const char* paths[] = {TEST_DIR"/empty.png", TEST_DIR"/empty.jpg", TEST_DIR"/empty.webp"};
+
+    for (auto path : paths) {
+        auto picture = Picture::gen();
+        REQUIRE(picture);
+
+        //missing
+        remove(path);
+        REQUIRE(picture->load(path) != Result::Success);
+
+        //zero-length
+        ofstream file(path, ios::out | ios::binary);
+        file.close();
+        REQUIRE(picture->load(path) != Result::Success);
+        remove(path);
+
+        Paint::rel(picture);
+    }
+}
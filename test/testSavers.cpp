@@ -22,6 +22,7 @@
 
 #include <thorvg.h>
 #include <fstream>
+#include <iterator>
 #include "config.h"
 #include "catch.hpp"
 
@@ -57,4 +58,37 @@ TEST_CASE("Save a lottie into gif", "[tvgSavers]") {
     }
     REQUIRE(Initializer::term() == Result::Success);
 }
+
+TEST_CASE("Save a lottie into gif with threads", "[tvgSavers]") {
+    //the pipelined encoding must produce the same file as the serial one
+    const char* files[] = {TEST_DIR"/test_serial.gif", TEST_DIR"/test_threads.gif"};
+    uint32_t threads[] = {0, 3};
+
+    for (int i = 0; i < 2; ++i) {
+        REQUIRE(Initializer::init(threads[i]) == Result::Success);
+        {
+            auto animation = Animation::gen();
+            auto picture = animation->picture();
+            REQUIRE(picture->load(TEST_DIR"/test.lot") == Result::Success);
+            REQUIRE(picture->size(120, 120) == Result::Success);
+
+            auto saver =  unique_ptr<Saver>(Saver::gen());
+            REQUIRE(saver);
+
+            REQUIRE(saver->save(animation, files[i]) == Result::Success);
+            REQUIRE(saver->sync() == Result::Success);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+
+    ifstream serial(files[0], ios::binary);
+    ifstream pipelined(files[1], ios::binary);
+    REQUIRE(serial.is_open());
+    REQUIRE(pipelined.is_open());
+
+    string lhs((istreambuf_iterator<char>(serial)), istreambuf_iterator<char>());
+    string rhs((istreambuf_iterator<char>(pipelined)), istreambuf_iterator<char>());
+    REQUIRE(lhs.size() > 0);
+    REQUIRE(lhs == rhs);
+}
 #endif
\ No newline at end of file
@@ -21,6 +21,7 @@
  */
 
 #include <thorvg.h>
+#include <cstring>
 #include "config.h"
 #include "catch.hpp"
 
@@ -189,4 +190,223 @@ TEST_CASE("Scene Effects", "[tvgScene]")
         REQUIRE(canvas->sync() == Result::Success);
     }
     REQUIRE(Initializer::term() == Result::Success);
-}
\ No newline at end of file
+}
+static Scene* grid(uint32_t n, float size)
+{
+    auto scene = Scene::gen();
+    for (uint32_t y = 0; y < n; ++y) {
+        for (uint32_t x = 0; x < n; ++x) {
+            auto shape = Shape::gen();
+            shape->appendRect(x * size, y * size, size * 0.5f, size * 0.5f);
+            shape->fill(uint8_t(x * 30), uint8_t(y * 30), 255, 255);
+            scene->add(shape);
+        }
+    }
+    return scene;
+}
+
+TEST_CASE("Scene Query", "[tvgScene]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        //8x8 grid of 10x10 rects, larger than the viewport
+        auto scene = grid(8, 20.0f);
+        REQUIRE(canvas->add(scene) == Result::Success);
+
+        list<Paint*> paints;
+        REQUIRE(scene->query(0, 0, 0, 10, paints) == Result::InvalidArguments);
+        //not updated yet
+        REQUIRE(scene->query(0, 0, 10, 10, paints) == Result::Success);
+        REQUIRE(paints.empty());
+
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //hits the first two rects of the first row
+        REQUIRE(scene->query(5, 5, 20, 2, paints) == Result::Success);
+        REQUIRE(paints.size() == 2);
+        REQUIRE(paints.front() != paints.back());
+
+        //in the gaps
+        paints.clear();
+        REQUIRE(scene->query(12, 12, 6, 6, paints) == Result::Success);
+        REQUIRE(paints.empty());
+        REQUIRE(!scene->intersects(12, 12, 6, 6));
+        REQUIRE(scene->intersects(0, 0, 2, 2));
+
+        //off the viewport
+        REQUIRE(scene->query(140, 140, 5, 5, paints) == Result::Success);
+        REQUIRE(paints.empty());
+
+        //pan the off-screen rects into the viewport
+        REQUIRE(scene->translate(-60, -60) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //the same grid under the index threshold
+        uint32_t reference[100*100];
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(reference, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        auto root = Scene::gen();
+        for (uint32_t y = 0; y < 8; ++y) {
+            auto row = Scene::gen();
+            for (uint32_t x = 0; x < 8; ++x) {
+                auto shape = Shape::gen();
+                shape->appendRect(x * 20.0f, y * 20.0f, 10.0f, 10.0f);
+                shape->fill(uint8_t(x * 30), uint8_t(y * 30), 255, 255);
+                row->add(shape);
+            }
+            root->add(row);
+        }
+        root->translate(-60, -60);
+        REQUIRE(canvas2->add(root) == Result::Success);
+        REQUIRE(canvas2->draw(true) == Result::Success);
+        REQUIRE(canvas2->sync() == Result::Success);
+
+        REQUIRE(memcmp(buffer, reference, sizeof(buffer)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Scene Culling", "[tvgScene]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen(EngineOption::SmartRender));
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto scene = Scene::gen();
+        Shape* shapes[4];
+        for (int i = 0; i < 4; ++i) {
+            shapes[i] = Shape::gen();
+            shapes[i]->appendRect(i * 25.0f, i * 25.0f, 20.0f, 20.0f);
+            shapes[i]->fill(255, 0, 0, 255);
+            REQUIRE(scene->add(shapes[i]) == Result::Success);
+        }
+        REQUIRE(canvas->add(scene) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //out of the viewport
+        REQUIRE(scene->translate(500, 500) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        auto drawn = 0;
+        for (auto pixel : buffer) if (pixel) ++drawn;
+        REQUIRE(drawn == 0);
+
+        //the changes while culled must be applied when it comes back
+        REQUIRE(shapes[1]->fill(0, 255, 0, 255) == Result::Success);
+        REQUIRE(shapes[2]->strokeWidth(4) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(scene->translate(10, 10) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //a fresh rendering of the same state
+        uint32_t reference[100*100];
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(reference, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas2->add(scene->duplicate()) == Result::Success);
+        REQUIRE(canvas2->draw(true) == Result::Success);
+        REQUIRE(canvas2->sync() == Result::Success);
+
+        REQUIRE(memcmp(buffer, reference, sizeof(buffer)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Scene Culling Contents", "[tvgScene]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen(EngineOption::SmartRender));
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        //enough children for the bvh
+        auto scene = Scene::gen();
+        for (int i = 0; i < 40; ++i) {
+            auto shape = Shape::gen();
+            shape->appendRect((i % 8) * 12.0f, 80.0f + (i / 8) * 4.0f, 6.0f, 2.0f);
+            shape->fill(0, 0, 255, 255);
+            REQUIRE(scene->add(shape) == Result::Success);
+        }
+
+        uint32_t image[20*20];
+        for (auto& pixel : image) pixel = 0xffff0000;
+        auto bitmap = Picture::gen();
+        REQUIRE(bitmap->load(image, 20, 20, ColorSpace::ARGB8888, true) == Result::Success);
+        REQUIRE(bitmap->size(30, 30) == Result::Success);
+        REQUIRE(scene->add(bitmap) == Result::Success);
+
+#ifdef THORVG_SVG_LOADER_SUPPORT
+        auto vector = Picture::gen();
+        REQUIRE(vector->load(TEST_DIR"/test1.svg") == Result::Success);
+        REQUIRE(vector->size(40, 40) == Result::Success);
+        REQUIRE(vector->translate(50, 0) == Result::Success);
+        REQUIRE(scene->add(vector) == Result::Success);
+#endif
+
+#ifdef THORVG_TTF_LOADER_SUPPORT
+        REQUIRE(Text::load(TEST_DIR"/PublicSans-Regular.ttf") == Result::Success);
+        auto text = Text::gen();
+        REQUIRE(text->font("PublicSans-Regular") == Result::Success);
+        REQUIRE(text->size(16) == Result::Success);
+        REQUIRE(text->text("ThorVG") == Result::Success);
+        REQUIRE(text->fill(0, 255, 0) == Result::Success);
+        REQUIRE(text->translate(0, 40) == Result::Success);
+        REQUIRE(scene->add(text) == Result::Success);
+#endif
+
+        REQUIRE(canvas->add(scene) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        auto drawn = 0;
+        for (auto pixel : buffer) if (pixel) ++drawn;
+        REQUIRE(drawn > 0);
+
+        //out of the viewport
+        REQUIRE(scene->translate(500, 500) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        drawn = 0;
+        for (auto pixel : buffer) if (pixel) ++drawn;
+        REQUIRE(drawn == 0);
+
+        //the contents at the edges must not be culled
+        REQUIRE(scene->translate(-15, -15) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        uint32_t reference[100*100];
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas2->target(reference, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas2->add(scene->duplicate()) == Result::Success);
+        REQUIRE(canvas2->draw(true) == Result::Success);
+        REQUIRE(canvas2->sync() == Result::Success);
+
+        REQUIRE(memcmp(buffer, reference, sizeof(buffer)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
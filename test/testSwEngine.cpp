@@ -22,6 +22,7 @@
 
 #include <thorvg.h>
 #include <fstream>
+#include <cstring>
 #include "config.h"
 #include "catch.hpp"
 
@@ -407,4 +408,383 @@ TEST_CASE("Intersection", "[tvgSwEngine]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Tiled Draw", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init(4) == Result::Success);
+    {
+        const uint32_t w = 600;
+        const uint32_t h = 500;
+
+        auto draw = [&](EngineOption op, vector<uint32_t>& buffer) {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen(op));
+            REQUIRE(canvas);
+            REQUIRE(canvas->target(buffer.data(), w, w, h, ColorSpace::ARGB8888) == Result::Success);
+
+            //Solid, translucent and stroked shapes across the tile borders
+            for (int i = 0; i < 20; ++i) {
+                auto shape = Shape::gen();
+                shape->appendRect(float(i * 25), float(i * 20), 200, 150, 10, 10);
+                shape->appendCircle(float(500 - i * 20), float(i * 22), 60, 40);
+                shape->fill(i * 12, 255 - i * 12, 128, 100 + i * 7);
+                shape->strokeWidth(float(i % 4));
+                shape->strokeFill(0, 0, 255, 200);
+                REQUIRE(canvas->add(shape) == Result::Success);
+            }
+
+            //Gradient shape
+            auto fill = LinearGradient::gen();
+            fill->linear(0, 0, float(w), float(h));
+            Fill::ColorStop stops[2] = {{0.0f, 255, 0, 0, 127}, {1.0f, 0, 255, 255, 255}};
+            fill->colorStops(stops, 2);
+            auto shape = Shape::gen();
+            shape->appendCircle(300, 250, 280, 200);
+            shape->fill(fill);
+            REQUIRE(canvas->add(shape) == Result::Success);
+
+            //Blending & Masking
+            auto blended = Shape::gen();
+            blended->appendRect(100, 100, 400, 300);
+            blended->fill(255, 255, 0, 200);
+            blended->blend(BlendMethod::Multiply);
+            REQUIRE(canvas->add(blended) == Result::Success);
+
+            auto mask = Shape::gen();
+            mask->appendCircle(300, 250, 150, 150);
+            mask->fill(255, 255, 255);
+            auto masked = Shape::gen();
+            masked->appendRect(0, 0, float(w), float(h));
+            masked->fill(0, 128, 255, 150);
+            masked->mask(mask, MaskMethod::Alpha);
+            REQUIRE(canvas->add(masked) == Result::Success);
+
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        vector<uint32_t> buffer1(w * h);
+        vector<uint32_t> buffer2(w * h);
+
+        draw(EngineOption::Default, buffer1);
+        draw(EngineOption::Tiled, buffer2);
+
+        REQUIRE(memcmp(buffer1.data(), buffer2.data(), w * h * sizeof(uint32_t)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Banded Draw", "[tvgSwEngine]")
+{
+    const uint32_t w = 1000;
+    const uint32_t h = 1000;
+
+    auto draw = [&](vector<uint32_t>& buffer) {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+        REQUIRE(canvas->target(buffer.data(), w, w, h, ColorSpace::ARGB8888) == Result::Success);
+
+        //Giant shapes, their rows are split into the bands on the worker threads
+        auto shape = Shape::gen();
+        shape->appendCircle(500, 500, 480, 450);
+        shape->fill(255, 0, 0, 200);
+        shape->strokeWidth(15);
+        shape->strokeFill(0, 0, 255, 150);
+        REQUIRE(canvas->add(shape) == Result::Success);
+
+        auto star = Shape::gen();
+        const int points = 1500;
+        for (int i = 0; i < points; ++i) {
+            auto r = (i % 2) ? 490.0f : 150.0f;
+            auto a = float(i) * 6.2831853f / float(points);
+            auto x = 500.0f + r * cosf(a);
+            auto y = 500.0f + r * sinf(a);
+            if (i == 0) star->moveTo(x, y);
+            else star->lineTo(x, y);
+        }
+        star->close();
+        star->fill(0, 255, 0, 127);
+        star->fillRule(FillRule::EvenOdd);
+        REQUIRE(canvas->add(star) == Result::Success);
+
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+    };
+
+    vector<uint32_t> buffer1(w * h);
+    vector<uint32_t> buffer2(w * h);
+
+    REQUIRE(Initializer::init(0) == Result::Success);
+    draw(buffer1);
+    REQUIRE(Initializer::term() == Result::Success);
+
+    REQUIRE(Initializer::init(4) == Result::Success);
+    draw(buffer2);
+    REQUIRE(Initializer::term() == Result::Success);
+
+    REQUIRE(buffer1 == buffer2);
+}
+
+TEST_CASE("Accumulated Draw", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        const uint32_t w = 400;
+        const uint32_t h = 300;
+
+        auto draw = [&](EngineOption op, vector<uint32_t>& buffer) {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen(op));
+            REQUIRE(canvas);
+            REQUIRE(canvas->target(buffer.data(), w, w, h, ColorSpace::ARGB8888) == Result::Success);
+
+            //Hatching, crossing over the canvas boundaries
+            auto hatch = Shape::gen();
+            for (int i = -20; i < 60; ++i) {
+                hatch->moveTo(i * 9.3f, -10);
+                hatch->lineTo(i * 9.3f - 150.0f, 310);
+            }
+            hatch->strokeWidth(1.7f);
+            hatch->strokeFill(0, 0, 255, 200);
+            REQUIRE(canvas->add(hatch) == Result::Success);
+
+            //Star with the even-odd rule
+            auto star = Shape::gen();
+            const int points = 301;
+            for (int i = 0; i < points; ++i) {
+                auto r = (i % 2) ? 190.0f : 40.0f;
+                auto a = float(i * 3) * 6.2831853f / float(points);
+                auto x = 120.0f + r * cosf(a);
+                auto y = 150.0f + r * sinf(a);
+                if (i == 0) star->moveTo(x, y);
+                else star->lineTo(x, y);
+            }
+            star->close();
+            star->fill(0, 255, 0, 127);
+            star->fillRule(FillRule::EvenOdd);
+            REQUIRE(canvas->add(star) == Result::Success);
+
+            //Dashed curves
+            auto circle = Shape::gen();
+            circle->appendCircle(300, 150, 110, 130);
+            circle->fill(255, 0, 0, 100);
+            circle->strokeWidth(3);
+            float dash[] = {7.5f, 3.3f};
+            circle->strokeDash(dash, 2);
+            circle->strokeFill(255, 255, 0, 255);
+            REQUIRE(canvas->add(circle) == Result::Success);
+
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        vector<uint32_t> buffer1(w * h);
+        vector<uint32_t> buffer2(w * h);
+
+        //Both rasterizers produce the identical spans
+        draw(EngineOption::Default, buffer1);
+        draw(EngineOption(uint8_t(EngineOption::SmartRender) | uint8_t(EngineOption::Accumulated)), buffer2);
+        REQUIRE(buffer1 == buffer2);
+
+        draw(EngineOption::Aliased, buffer1);
+        draw(EngineOption(uint8_t(EngineOption::Aliased) | uint8_t(EngineOption::Accumulated)), buffer2);
+        REQUIRE(buffer1 == buffer2);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Clipped Frames", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init(2) == Result::Success);
+    {
+        const uint32_t w = 300;
+        const uint32_t h = 300;
+
+        //The transient clip and trim data are reused over the frames
+        auto build = [&](SwCanvas* canvas, int frame) {
+            auto shape = Shape::gen();
+            shape->appendRect(20, 20, 260, 260, 30, 30);
+            shape->fill(255, 0, 0, 200);
+            shape->strokeWidth(12);
+            shape->strokeFill(0, 0, 255, 255);
+            shape->trimpath(0.1f * frame, 0.5f + 0.1f * frame, true);
+
+            auto clipper = Shape::gen();
+            clipper->appendCircle(60.0f + 25.0f * frame, 150, 90, 110);
+            clipper->strokeWidth(5);
+            shape->clip(clipper);
+            REQUIRE(canvas->add(shape) == Result::Success);
+
+            auto rect = Shape::gen();
+            rect->appendRect(0, 0, w, h);
+            rect->fill(0, 255, 0, 100);
+            auto clipper2 = Shape::gen();
+            clipper2->appendRect(10.0f * frame, 10, 100, 280);
+            rect->clip(clipper2);
+            REQUIRE(canvas->add(rect) == Result::Success);
+        };
+
+        vector<uint32_t> buffer1(w * h);
+        vector<uint32_t> buffer2(w * h);
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer1.data(), w, w, h, ColorSpace::ARGB8888) == Result::Success);
+
+        for (int frame = 0; frame < 5; ++frame) {
+            REQUIRE(canvas->remove() == Result::Success);
+            build(canvas.get(), frame);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            auto fresh = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(fresh->target(buffer2.data(), w, w, h, ColorSpace::ARGB8888) == Result::Success);
+            build(fresh.get(), frame);
+            REQUIRE(fresh->draw(true) == Result::Success);
+            REQUIRE(fresh->sync() == Result::Success);
+
+            REQUIRE(buffer1 == buffer2);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Simd Level", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::simd(SimdLevel::None) == Result::InsufficientCondition);
+
+    REQUIRE(Initializer::init() == Result::Success);
+
+    auto level = Initializer::simd();
+    REQUIRE(Initializer::simd(SimdLevel::None) == Result::Success);
+    REQUIRE(Initializer::simd() == SimdLevel::None);
+
+    //the override is kept over the re-initialization
+    REQUIRE(Initializer::term() == Result::Success);
+    REQUIRE(Initializer::init() == Result::Success);
+    REQUIRE(Initializer::simd() == SimdLevel::None);
+
+    REQUIRE(Initializer::simd(level) == Result::Success);
+    REQUIRE(Initializer::simd() == level);
+
+    if (level != SimdLevel::AVX512) REQUIRE(Initializer::simd(SimdLevel::AVX512) == Result::NonSupport);
+    if (level != SimdLevel::NEON) REQUIRE(Initializer::simd(SimdLevel::NEON) == Result::NonSupport);
+
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Simd Draw", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        const uint32_t w = 333;
+        const uint32_t h = 257;
+
+        uint32_t image[64 * 64];
+        for (uint32_t i = 0; i < 64 * 64; ++i) image[i] = ((i * 7) % 256) << 24 | ((i * 5) % 256) << 8;
+
+        auto draw = [&](vector<uint32_t>& buffer) {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer.data(), w, w, h, ColorSpace::ARGB8888) == Result::Success);
+
+            //Translucent rect & rle
+            auto rect = Shape::gen();
+            rect->appendRect(3, 5, 301, 203);
+            rect->fill(200, 100, 50, 130);
+            canvas->add(rect);
+
+            auto circle = Shape::gen();
+            circle->appendCircle(160, 128, 120, 90);
+            circle->fill(0, 150, 250, 77);
+            canvas->add(circle);
+
+            //Gradients with all the spreads
+            for (int i = 0; i < 3; ++i) {
+                Fill::ColorStop stops[3] = {{0.0f, 255, 0, 0, 255}, {0.4f, 0, 255, 0, 120}, {1.0f, 0, 0, 255, 200}};
+                auto linear = LinearGradient::gen();
+                linear->linear(10, 20, 60, 50);
+                linear->colorStops(stops, 3);
+                linear->spread(FillSpread(i));
+                auto shape = Shape::gen();
+                shape->appendRect(float(i * 100), 10, 97, 117, 10, 10);
+                shape->fill(linear);
+                shape->opacity(200);
+                canvas->add(shape);
+
+                auto radial = RadialGradient::gen();
+                radial->radial(float(i * 100 + 50), 180, 30, float(i * 100 + 40), 170, 5);
+                radial->colorStops(stops, 3);
+                radial->spread(FillSpread(i));
+                auto shape2 = Shape::gen();
+                shape2->appendCircle(float(i * 100 + 50), 180, 48, 60);
+                shape2->fill(radial);
+                shape2->rotate(float(i * 10));
+
+                auto mask = Shape::gen();
+                mask->appendCircle(float(i * 100 + 40), 170, 40, 40);
+                mask->fill(255, 255, 255, 180);
+                shape2->mask(mask, MaskMethod::Alpha);
+                canvas->add(shape2);
+            }
+
+            //Translucent image
+            auto picture = Picture::gen();
+            REQUIRE(picture->load(image, 64, 64, ColorSpace::ARGB8888, true) == Result::Success);
+            picture->translate(250, 180);
+            picture->opacity(150);
+            canvas->add(picture);
+
+            //Scaled images: up, down, nearest and clipped
+            auto up = Picture::gen();
+            REQUIRE(up->load(image, 64, 64, ColorSpace::ARGB8888, true) == Result::Success);
+            up->translate(-20, 30);
+            up->scale(2.7f);
+            up->opacity(220);
+            canvas->add(up);
+
+            auto down = Picture::gen();
+            REQUIRE(down->load(image, 64, 64, ColorSpace::ARGB8888, true) == Result::Success);
+            down->translate(200, 7);
+            down->scale(0.27f);
+            canvas->add(down);
+
+            auto nearest = Picture::gen();
+            REQUIRE(nearest->load(image, 64, 64, ColorSpace::ARGB8888, true) == Result::Success);
+            nearest->filter(FilterMethod::Nearest);
+            nearest->translate(230, 90);
+            nearest->scale(1.7f);
+            canvas->add(nearest);
+
+            auto clipped = Picture::gen();
+            REQUIRE(clipped->load(image, 64, 64, ColorSpace::ARGB8888, true) == Result::Success);
+            clipped->translate(120, 60);
+            clipped->scale(2.2f);
+            auto clipper = Shape::gen();
+            clipper->appendCircle(190, 130, 65, 55);
+            clipped->clip(clipper);
+            canvas->add(clipped);
+
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        auto level = Initializer::simd();
+
+        //The vector kernels must give the exact result of the scalar ones
+        vector<uint32_t> expected(w * h, 0xff202020);
+        REQUIRE(Initializer::simd(SimdLevel::None) == Result::Success);
+        draw(expected);
+
+        for (auto l : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512, SimdLevel::NEON}) {
+            if (Initializer::simd(l) != Result::Success) continue;
+            vector<uint32_t> buffer(w * h, 0xff202020);
+            draw(buffer);
+            auto mismatch = 0;
+            for (uint32_t i = 0; i < w * h; ++i) {
+                if (buffer[i] != expected[i]) ++mismatch;
+            }
+            REQUIRE(mismatch == 0);
+        }
+
+        REQUIRE(Initializer::simd(level) == Result::Success);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 #endif
\ No newline at end of file
@@ -308,6 +308,78 @@ TEST_CASE("Text Spacing", "[tvgText]")
     Initializer::term();
 }
 
+TEST_CASE("Text Glyph Cache", "[tvgText]")
+{
+    REQUIRE(Initializer::glyphCache(0) == Result::InsufficientCondition);
+
+    Initializer::init();
+    {
+        REQUIRE(Text::load(TEST_DIR"/PublicSans-Regular.ttf") == Result::Success);
+
+        //draw the same texts with and without the cached glyphs
+        uint32_t buffer[2][200*100];
+        uint32_t alpha[2] = {};
+
+        for (int i = 0; i < 2; ++i) {
+            REQUIRE(Initializer::glyphCache(i == 0 ? 0 : 1024 * 1024) == Result::Success);
+
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            memset(buffer[i], 0, sizeof(buffer[i]));
+            REQUIRE(canvas->target(buffer[i], 200, 200, 100, ColorSpace::ARGB8888) == Result::Success);
+
+            auto text = Text::gen();
+            REQUIRE(text->font("PublicSans-Regular") == Result::Success);
+            REQUIRE(text->size(12) == Result::Success);
+            REQUIRE(text->text("ThorVG Text Atlas") == Result::Success);
+            REQUIRE(text->fill(255, 255, 255) == Result::Success);
+            REQUIRE(text->translate(10.3f, 10.6f) == Result::Success);
+            REQUIRE(canvas->add(text) == Result::Success);
+
+            //outlines for the rotated and the large texts
+            auto text2 = text->duplicate();
+            REQUIRE(text2->rotate(15) == Result::Success);
+            REQUIRE(canvas->add(text2) == Result::Success);
+
+            auto text3 = static_cast<Text*>(text->duplicate());
+            REQUIRE(text3->size(60) == Result::Success);
+            REQUIRE(text3->translate(10, 40) == Result::Success);
+            REQUIRE(canvas->add(text3) == Result::Success);
+
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            //the cached glyphs are reused on the next frame
+            REQUIRE(text->translate(10.5f, 10.5f) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            for (int j = 0; j < 200*100; ++j) alpha[i] += buffer[i][j] >> 24;
+        }
+        REQUIRE(alpha[0] > 0);
+
+        //the glyphs are placed at the quarter pixels, the coverages slightly differ
+        auto diff = alpha[0] > alpha[1] ? alpha[0] - alpha[1] : alpha[1] - alpha[0];
+        REQUIRE(diff * 50 < alpha[0]);
+
+        //a tiny budget keeps the rendering working
+        REQUIRE(Initializer::glyphCache(16) == Result::Success);
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer[0], 200, 200, 100, ColorSpace::ARGB8888) == Result::Success);
+        auto text = Text::gen();
+        REQUIRE(text->font("PublicSans-Regular") == Result::Success);
+        REQUIRE(text->size(10) == Result::Success);
+        REQUIRE(text->text("ThorVG") == Result::Success);
+        REQUIRE(text->fill(255, 255, 255) == Result::Success);
+        REQUIRE(canvas->add(text) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(Initializer::glyphCache(1024 * 1024) == Result::Success);
+    }
+    Initializer::term();
+}
+
 #endif
 
 #ifdef THORVG_OTF_LOADER_SUPPORT
@@ -20,25 +20,51 @@
  * SOFTWARE.
  */
 
+#include <atomic>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <stdlib.h>
 #include <string.h>
+#include <thread>
 #include <vector>
 #include <memory>
 #include <thorvg.h>
 #ifdef _WIN32
     #define WIN32_LEAN_AND_MEAN
     #include <windows.h>
+    #include <psapi.h>
 #else
     #include <dirent.h>
     #include <unistd.h>
     #include <sys/stat.h>
+    #include <sys/resource.h>
 #endif
 
 using namespace std;
 using namespace tvg;
 
 
+//the peak resident memory of the process in bytes
+static size_t peakMemory()
+{
+#ifdef _WIN32
+   PROCESS_MEMORY_COUNTERS pmc;
+   if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+   return pmc.PeakWorkingSetSize;
+#else
+   struct rusage usage;
+   if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+   #ifdef __APPLE__
+      return usage.ru_maxrss;
+   #else
+      return usage.ru_maxrss * 1024;
+   #endif
+#endif
+}
+
+
 struct App
 {
 public:
@@ -49,12 +75,14 @@ private:
    uint32_t fps = 30;
    uint32_t width = 600;
    uint32_t height = 600;
+   uint32_t jobs = 0;      //worker count of the batch mode
    uint8_t r, g, b;        //background color
    bool background = false;
+   vector<string> files;   //the lottie files of the batch mode
 
    void helpMsg()
    {
-      cout << "Usage: \n   tvg-lottie2gif [Lottie file] or [Lottie folder] [-r resolution] [-f fps] [-b background color]\n\nExamples: \n    $ tvg-lottie2gif input.json\n    $ tvg-lottie2gif input.json -r 600x600\n    $ tvg-lottie2gif input.json -f 30\n    $ tvg-lottie2gif input.json -r 600x600 -f 30\n    $ tvg-lottie2gif lottiefolder\n    $ tvg-lottie2gif lottiefolder -r 600x600 -f 30 -b fa7410\n\n";
+      cout << "Usage: \n   tvg-lottie2gif [Lottie file] or [Lottie folder] [-r resolution] [-f fps] [-b background color] [-j workers]\n\nFlags: \n    -j convert the files concurrently on the given number of workers (0: the number of cores), report the time of each file along with the peak memory of the process and exit with a summary. The exit code is non-zero if any file failed.\n\nExamples: \n    $ tvg-lottie2gif input.json\n    $ tvg-lottie2gif input.json -r 600x600\n    $ tvg-lottie2gif input.json -f 30\n    $ tvg-lottie2gif input.json -r 600x600 -f 30\n    $ tvg-lottie2gif lottiefolder\n    $ tvg-lottie2gif lottiefolder -r 600x600 -f 30 -b fa7410\n    $ tvg-lottie2gif lottiefolder -r 600x600 -j 0\n\n";
    }
 
    bool validate(string& lottieName)
@@ -68,47 +96,94 @@ private:
       return true;
    }
 
-   bool convert(string& in, string& out)
+   bool convert(const string& in, const string& out)
    {
-      if (Initializer::init() != Result::Success) return false;
-      {
-         auto animation = Animation::gen();
-         auto picture = animation->picture();
-         if (picture->load(in.c_str()) != Result::Success) return false;
-
-         float width, height;
-         picture->size(&width, &height);
-         float scale =  static_cast<float>(this->width) / width;
-         picture->size(width * scale, height * scale);
-
-         auto saver = unique_ptr<Saver>(Saver::gen());
-
-         //set a background color
-         if (background) {
-            auto bg = Shape::gen();
-            bg->fill(r, g, b);
-            bg->appendRect(0, 0, width * scale, height * scale);
-            saver->background(bg);
-         }
-         if (saver->save(animation, out.c_str(), 100, fps) != Result::Success) return false;
-         if (saver->sync() != Result::Success) return false;
+      auto animation = Animation::gen();
+      auto picture = animation->picture();
+      if (picture->load(in.c_str()) != Result::Success) {
+         delete(animation);
+         return false;
+      }
+
+      float width, height;
+      picture->size(&width, &height);
+      float scale =  static_cast<float>(this->width) / width;
+      picture->size(width * scale, height * scale);
+
+      auto saver = unique_ptr<Saver>(Saver::gen());
+
+      //set a background color
+      if (background) {
+         auto bg = Shape::gen();
+         bg->fill(r, g, b);
+         bg->appendRect(0, 0, width * scale, height * scale);
+         saver->background(bg);
       }
-      return Initializer::term() == Result::Success;
+      if (saver->save(animation, out.c_str(), 100, fps) != Result::Success) return false;
+      return saver->sync() == Result::Success;
    }
 
-   void convert(string& lottieName)
+   string gifName(const string& lottieName)
    {
-      //Get gif file
       auto gifName = lottieName;
       gifName.replace(gifName.length() - 4, 4, "gif");
+      return gifName;
+   }
+
+   void convert(string& lottieName)
+   {
+      //the batch mode converts them at once
+      if (jobs > 0) {
+         files.push_back(lottieName);
+         return;
+      }
 
-      if (convert(lottieName, gifName)) {
-         cout << "Generated Gif file : " << gifName << endl;
+      //Get gif file
+      auto gif = gifName(lottieName);
+
+      if (convert(lottieName, gif)) {
+         cout << "Generated Gif file : " << gif << endl;
       } else {
          cout << "Failed Converting Gif file : " << lottieName << endl;
       }
    }
 
+   //convert the files on the workers, each saver renders on its own canvas. The files are written out as soon as they are done.
+   int convertFiles()
+   {
+      atomic<size_t> next{0};
+      atomic<uint32_t> failed{0};
+      mutex mtx;
+
+      auto begin = chrono::steady_clock::now();
+
+      auto work = [&]() {
+         size_t i;
+         while ((i = next++) < files.size()) {
+            auto start = chrono::steady_clock::now();
+            auto ret = convert(files[i], gifName(files[i]));
+            auto elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            if (!ret) ++failed;
+
+            lock_guard<mutex> lock(mtx);
+            cout << (ret ? "OK   " : "FAIL ") << files[i] << " " << fixed << setprecision(2) << elapsed << " ms, peak " << peakMemory() / 1024 << " KB" << endl;
+         }
+      };
+
+      vector<thread> workers;
+      auto cnt = min(size_t(jobs), files.size());
+      for (size_t i = 0; i < cnt; ++i) workers.emplace_back(work);
+      for (auto& worker : workers) worker.join();
+
+      auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+      auto done = files.size() - failed;
+
+      cout << "Summary: " << files.size() << " files, " << done << " succeeded, " << failed << " failed, " << fixed << setprecision(2)
+           << elapsed << " s (" << (elapsed > 0.0 ? files.size() / elapsed : 0.0) << " files/s), " << cnt << " workers, peak " << peakMemory() / (1024 * 1024) << " MB" << endl;
+
+      return failed > 0 ? 1 : 0;
+   }
+
    const char* realPath(const char* path)
    {
       free(full);  // free previous if exist
@@ -239,6 +314,15 @@ public:
                g = (uint8_t)((bgColor & 0x00ff00) >> 8);
                b = (uint8_t)((bgColor & 0x0000ff));
                background = true;
+            } else if (p[1] == 'j') {
+               //batch mode
+               if (!p_arg || atoi(p_arg) < 0) {
+                  cout << "Error: Missing worker count of the batch mode. Expected eg. -j 8." << endl;
+                  return 1;
+               }
+               jobs = atoi(p_arg);
+               if (jobs == 0) jobs = thread::hardware_concurrency();
+               if (jobs == 0) jobs = 1;
             } else {
                cout << "Warning: Unknown flag (" << p << ")." << endl;
             }
@@ -253,6 +337,14 @@ public:
          return 0;
       }
 
+      //the workers of the batch mode share the task scheduler
+      auto threads = thread::hardware_concurrency();
+      if (threads > 0) --threads;
+      if (Initializer::init(jobs > 0 ? threads : 0) != Result::Success) {
+         cout << "Error: Engine is not supported" << endl;
+         return 1;
+      }
+
       for (auto input : inputs) {
 
          auto path = realPath(input);
@@ -272,7 +364,12 @@ public:
             convert(lottieName);
          }
       }
-      return 0;
+
+      auto ret = (jobs > 0) ? convertFiles() : 0;
+
+      Initializer::term();
+
+      return ret;
    }
 };
 
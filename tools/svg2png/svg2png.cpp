@@ -20,7 +20,11 @@
  * SOFTWARE.
  */
 
+#include <atomic>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <stdlib.h>
 #include <thread>
 #include <thorvg.h>
@@ -28,10 +32,12 @@
 #ifdef _WIN32
     #define WIN32_LEAN_AND_MEAN
     #include <windows.h>
+    #include <psapi.h>
 #else
     #include <dirent.h>
     #include <unistd.h>
     #include <sys/stat.h>
+    #include <sys/resource.h>
 #endif
 #include "lodepng.h"
 
@@ -41,6 +47,24 @@
 
 using namespace std;
 
+//the peak resident memory of the process in bytes
+static size_t peakMemory()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return pmc.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    #ifdef __APPLE__
+        return usage.ru_maxrss;
+    #else
+        return usage.ru_maxrss * 1024;
+    #endif
+#endif
+}
+
 struct PngBuilder
 {
     void build(const string& fileName, const uint32_t width, const uint32_t height, uint32_t* buffer)
@@ -68,6 +92,8 @@ struct PngBuilder
 struct Renderer
 {
 public:
+    bool verbose = true;  //report the generated files
+
     int render(const char* path, int w, int h, const string& dst, uint32_t bgColor)
     {
         //Canvas
@@ -91,30 +117,7 @@ public:
             return 1;
         }
 
-        if (w == 0 || h == 0) {
-            float fw, fh;
-            picture->size(&fw, &fh);
-            w = static_cast<uint32_t>(fw);
-            h = static_cast<uint32_t>(fh);
-            if (fw > w) w++;
-            if (fh > h) h++;
-
-            if (w * h > SIZE_8K) {
-                float scale = fw / fh;
-                if (scale > 1) {
-                    w = WIDTH_8K;
-                    h = static_cast<uint32_t>(w / scale);
-                } else {
-                    h = HEIGHT_8K;
-                    w = static_cast<uint32_t>(h * scale);
-                }
-                cout << "Warning: The SVG width and/or height values exceed the 8k resolution. "
-                        "To avoid the heap overflow, the conversion to the PNG file made in " << w << " x " << h << " resolution." << endl;
-                picture->size(static_cast<float>(w), static_cast<float>(h));
-            }
-        } else {
-            picture->size(static_cast<float>(w), static_cast<float>(h));
-        }
+        resize(picture, w, h);
 
         //Buffer
         createBuffer(w, h);
@@ -146,34 +149,114 @@ public:
         canvas->draw(true);
         canvas->sync();
 
+        //the canvas is reused for the next file
+        canvas->remove();
+
         //Build Png
         PngBuilder builder;
         builder.build(dst, w, h, buffer);
 
-        cout << "Generated PNG file: " << dst << endl;
+        if (verbose) cout << "Generated PNG file: " << dst << endl;
+
+        return 0;
+    }
+
+    //rasterize the file with the cell and the accumulation rasterizers, then compare the timings and the results
+    int bench(const char* path, int w, int h, uint32_t loops)
+    {
+        //Initialize ThorVG Engine
+        if (!canvas) createCanvas();
+        if (!canvas) {
+            cout << "Error: Canvas failure" << endl;
+            return 1;
+        }
+
+        const tvg::EngineOption options[] = {tvg::EngineOption::Default, tvg::EngineOption::Accumulated};
+        vector<uint32_t> results[2];
+        double elapsed[2];
+
+        for (int i = 0; i < 2; ++i) {
+            auto picture = tvg::Picture::gen();
+            if (picture->load(path) != tvg::Result::Success) {
+                cout << "Error: Couldn't load image " << path << endl;
+                return 1;
+            }
+
+            auto pw = w, ph = h;
+            resize(picture, pw, ph);
+            results[i].resize(pw * ph);
+
+            auto bench = unique_ptr<tvg::SwCanvas>(tvg::SwCanvas::gen(options[i]));
+            if (bench->target(results[i].data(), pw, pw, ph, tvg::ColorSpace::ARGB8888S) != tvg::Result::Success) {
+                cout << "Error: Canvas target failure" << endl;
+                return 1;
+            }
+            bench->add(picture);
+
+            //warm up, the picture is loaded at the first frame
+            bench->draw(true);
+            bench->sync();
+
+            //every loop moves the picture, so that all the shapes are rasterized again
+            auto begin = chrono::steady_clock::now();
+            for (uint32_t n = 1; n <= loops; ++n) {
+                picture->translate(0.0f, float(n % 2));
+                bench->update();
+                bench->draw(true);
+                bench->sync();
+            }
+            elapsed[i] = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count() / loops;
+
+            picture->translate(0.0f, 0.0f);
+            bench->update();
+            bench->draw(true);
+            bench->sync();
+        }
+
+        cout << path << ": cell " << elapsed[0] << " ms, accumulation " << elapsed[1] << " ms per frame, "
+             << (results[0] == results[1] ? "identical" : "mismatched") << " results" << endl;
 
         return 0;
     }
 
     void terminate()
     {
-        tvg::Initializer::term();
+        canvas = nullptr;
         free(buffer);
+        buffer = nullptr;
     }
 
 private:
-    void createCanvas()
+    void resize(tvg::Picture* picture, int& w, int& h)
     {
-        //Threads Count
-        auto threads = thread::hardware_concurrency();
-        if (threads > 0) --threads; 
+        if (w == 0 || h == 0) {
+            float fw, fh;
+            picture->size(&fw, &fh);
+            w = static_cast<uint32_t>(fw);
+            h = static_cast<uint32_t>(fh);
+            if (fw > w) w++;
+            if (fh > h) h++;
 
-        //Initialize ThorVG Engine
-        if (tvg::Initializer::init(threads) != tvg::Result::Success) {
-            cout << "Error: Engine is not supported" << endl;
+            if (w * h > SIZE_8K) {
+                float scale = fw / fh;
+                if (scale > 1) {
+                    w = WIDTH_8K;
+                    h = static_cast<uint32_t>(w / scale);
+                } else {
+                    h = HEIGHT_8K;
+                    w = static_cast<uint32_t>(h * scale);
+                }
+                cout << "Warning: The SVG width and/or height values exceed the 8k resolution. "
+                        "To avoid the heap overflow, the conversion to the PNG file made in " << w << " x " << h << " resolution." << endl;
+                picture->size(static_cast<float>(w), static_cast<float>(h));
+            }
+        } else {
+            picture->size(static_cast<float>(w), static_cast<float>(h));
         }
+    }
 
-        //Create a Canvas
+    void createCanvas()
+    {
         canvas = unique_ptr<tvg::SwCanvas>(tvg::SwCanvas::gen());
     }
 
@@ -234,6 +317,26 @@ public:
 
                     bgColor = (uint32_t) strtol(p_arg, NULL, 16);
 
+                } else if (p[1] == 'm') {
+                    //benchmark mode
+                    if (!p_arg || atoi(p_arg) <= 0) {
+                        cout << "Error: Missing loop count of the benchmark. Expected eg. -m 100." << endl;
+                        return 1;
+                    }
+
+                    loops = atoi(p_arg);
+
+                } else if (p[1] == 'j') {
+                    //batch mode
+                    if (!p_arg || atoi(p_arg) < 0) {
+                        cout << "Error: Missing worker count of the batch mode. Expected eg. -j 8." << endl;
+                        return 1;
+                    }
+
+                    jobs = atoi(p_arg);
+                    if (jobs == 0) jobs = thread::hardware_concurrency();
+                    if (jobs == 0) jobs = 1;
+
                 } else {
                     cout << "Warning: Unknown flag (" << p << ")." << endl;
                 }
@@ -247,32 +350,49 @@ public:
         if (paths.empty()) {
             //no attributes - print help
             return help();
+        }
 
-        } else {
-            for (auto path : paths) {
-                auto real_path = realFile(path);
-                if (real_path) {
-                    if (isDirectory(real_path)) {
-                        //load from directory
-                        cout << "Trying load from directory \"" << real_path << "\"." << endl;
-                        if ((ret = handleDirectory(real_path))) break;
-
-                    } else if (svgFile(path)) {
-                        //load single file
-                        if ((ret = renderFile(real_path))) break;
-                    } else {
-                        //not a directory and not .svg file
-                        cout << "Error: File \"" << path << "\" is not a proper svg file." << endl;
-                    }
+        //Threads Count
+        auto threads = thread::hardware_concurrency();
+        if (threads > 0) --threads;
 
+        //Initialize ThorVG Engine, the workers of the batch mode share its task scheduler
+        if (tvg::Initializer::init(threads) != tvg::Result::Success) {
+            cout << "Error: Engine is not supported" << endl;
+            return 1;
+        }
+
+        //the batch mode gathers the files first
+        vector<string> files;
+        auto batch = (jobs > 0 && loops == 0);
+
+        for (auto path : paths) {
+            auto real_path = realFile(path);
+            if (real_path) {
+                if (isDirectory(real_path)) {
+                    //load from directory
+                    cout << "Trying load from directory \"" << real_path << "\"." << endl;
+                    if ((ret = handleDirectory(real_path, batch ? &files : nullptr))) break;
+
+                } else if (svgFile(path)) {
+                    //load single file
+                    if (batch) files.push_back(real_path);
+                    else if ((ret = renderFile(renderer, real_path))) break;
                 } else {
-                    cout << "Error: Invalid file or path name: \"" << path << "\"" << endl;
+                    //not a directory and not .svg file
+                    cout << "Error: File \"" << path << "\" is not a proper svg file." << endl;
                 }
+
+            } else {
+                cout << "Error: Invalid file or path name: \"" << path << "\"" << endl;
             }
         }
 
+        if (batch && ret == 0) ret = renderFiles(files);
+
         //Terminate renderer
         renderer.terminate();
+        tvg::Initializer::term();
 
         return ret;
     }
@@ -282,12 +402,14 @@ private:
     uint32_t bgColor = 0xffffffff;
     uint32_t width = 0;
     uint32_t height = 0;
+    uint32_t loops = 0;  // benchmark loop count
+    uint32_t jobs = 0;   // worker count of the batch mode
     char* full = nullptr;  // full path
 
 private:
     int help()
     {
-        cout << "Usage:\n   tvg-svg2png [SVG file] or [SVG folder] [-r resolution] [-b bgColor]\n\nFlags:\n    -r set the output image resolution.\n    -b set the output image background color.\n\nExamples:\n    $ tvg-svg2png input.svg\n    $ tvg-svg2png input.svg -r 200x200\n    $ tvg-svg2png input.svg -r 200x200 -b ff00ff\n    $ tvg-svg2png input1.svg input2.svg -r 200x200 -b ff00ff\n    $ tvg-svg2png . -r 200x200\n\nNote:\n    In the case, where the width and height in the SVG file determine the size of the image in resolution higher than 8k (7680 x 4320), limiting the resolution to this value is enforced.\n\n";
+        cout << "Usage:\n   tvg-svg2png [SVG file] or [SVG folder] [-r resolution] [-b bgColor] [-m loops] [-j workers]\n\nFlags:\n    -r set the output image resolution.\n    -b set the output image background color.\n    -m benchmark the cell and the accumulation rasterizers over the given loops instead of the PNG generation.\n    -j render the files concurrently on the given number of workers (0: the number of cores), report the time of each file along with the peak memory of the process and exit with a summary. The exit code is non-zero if any file failed.\n\nExamples:\n    $ tvg-svg2png input.svg\n    $ tvg-svg2png input.svg -r 200x200\n    $ tvg-svg2png input.svg -r 200x200 -b ff00ff\n    $ tvg-svg2png input1.svg input2.svg -r 200x200 -b ff00ff\n    $ tvg-svg2png . -r 200x200\n    $ tvg-svg2png . -m 100\n    $ tvg-svg2png . -r 200x200 -j 0\n\nNote:\n    In the case, where the width and height in the SVG file determine the size of the image in resolution higher than 8k (7680 x 4320), limiting the resolution to this value is enforced.\n\n";
         return 1;
     }
 
@@ -328,10 +450,12 @@ private:
 #endif
     }
 
-    int renderFile(const char* path)
+    int renderFile(Renderer& renderer, const char* path)
     {
         if (!path) return 1;
 
+        if (loops > 0) return renderer.bench(path, width, height, loops);
+
         //destination png file
         const char* dot = strrchr(path, '.');
         if (!dot) return 1;
@@ -341,7 +465,47 @@ private:
         return renderer.render(path, width, height, dst, bgColor);
     }
 
-    int handleDirectory(const string& path)
+    //render the files on the workers, each with its own canvas. The files are written out as soon as they are done.
+    int renderFiles(const vector<string>& files)
+    {
+        atomic<size_t> next{0};
+        atomic<uint32_t> failed{0};
+        mutex mtx;
+
+        auto begin = chrono::steady_clock::now();
+
+        auto work = [&]() {
+            Renderer renderer;
+            renderer.verbose = false;
+            size_t i;
+            while ((i = next++) < files.size()) {
+                auto start = chrono::steady_clock::now();
+                auto ret = renderFile(renderer, files[i].c_str());
+                auto elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                if (ret) ++failed;
+
+                lock_guard<mutex> lock(mtx);
+                cout << (ret ? "FAIL " : "OK   ") << files[i] << " " << fixed << setprecision(2) << elapsed << " ms, peak " << peakMemory() / 1024 << " KB" << endl;
+            }
+            renderer.terminate();
+        };
+
+        vector<thread> workers;
+        auto cnt = min(size_t(jobs), files.size());
+        for (size_t i = 0; i < cnt; ++i) workers.emplace_back(work);
+        for (auto& worker : workers) worker.join();
+
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        auto done = files.size() - failed;
+
+        cout << "Summary: " << files.size() << " files, " << done << " succeeded, " << failed << " failed, " << fixed << setprecision(2)
+             << elapsed << " s (" << (elapsed > 0.0 ? files.size() / elapsed : 0.0) << " files/s), " << cnt << " workers, peak " << peakMemory() / (1024 * 1024) << " MB" << endl;
+
+        return failed > 0 ? 1 : 0;
+    }
+
+    //render the svg files in the directory, or gather them into the files if given
+    int handleDirectory(const string& path, vector<string>* files)
     {
         //open directory
 #ifdef _WIN32
@@ -358,7 +522,7 @@ private:
                 string subpath = string(path);
                 subpath += '\\';
                 subpath += fd.cFileName;
-                ret = handleDirectory(subpath);
+                ret = handleDirectory(subpath, files);
                 if (ret) break;
 
             } else {
@@ -366,7 +530,11 @@ private:
                 string fullpath = string(path);
                 fullpath += '\\';
                 fullpath += fd.cFileName;
-                ret = renderFile(fullpath.c_str());
+                if (files) {
+                    files->push_back(fullpath);
+                    continue;
+                }
+                ret = renderFile(renderer, fullpath.c_str());
                 if (ret) break;
             }
         } while (FindNextFile(h, &fd));
@@ -388,7 +556,7 @@ private:
                 string subpath = string(path);
                 subpath += '/';
                 subpath += entry->d_name;
-                ret = handleDirectory(subpath);
+                ret = handleDirectory(subpath, files);
                 if (ret) break;
 
             } else {
@@ -396,7 +564,11 @@ private:
                 string fullpath = string(path);
                 fullpath += '/';
                 fullpath += entry->d_name;
-                ret = renderFile(fullpath.c_str());
+                if (files) {
+                    files->push_back(fullpath);
+                    continue;
+                }
+                ret = renderFile(renderer, fullpath.c_str());
                 if (ret) break;
             }
         }